@@ -18,6 +18,7 @@
 // First added:  2008-07-22
 // Last changed: 2011-09-21
 
+#include <cmath>
 #include <string>
 #include <vector>
 #include <iostream>
@@ -49,6 +50,85 @@ double reassemble_form(Form& form)
   return time() - t0;
 }
 
+double assemble_form_batched(Form& form)
+{
+  // Assemble once, processing cells in batches
+  const double t0 = time();
+  Matrix A;
+  Assembler assembler;
+  assembler.cell_batch_size = 64;
+  assembler.assemble(A, form);
+  return time() - t0;
+}
+
+// Interleaved P1 Poisson kernel on triangles, evaluating 8 cells at
+// once (one per SIMD lane)
+class VectorizedPoisson2DP1 : public VectorizedCellIntegral
+{
+public:
+
+  std::size_t num_lanes() const
+  { return 8; }
+
+  void tabulate_tensor(double* A, const double* const* w,
+                       const double* coordinate_dofs,
+                       const int* cell_orientations) const
+  {
+    const double* x = coordinate_dofs;
+    double g[6][8], scale[8];
+    #pragma omp simd
+    for (std::size_t l = 0; l < 8; ++l)
+    {
+      const double J00 = x[2*8 + l] - x[0*8 + l];
+      const double J01 = x[4*8 + l] - x[0*8 + l];
+      const double J10 = x[3*8 + l] - x[1*8 + l];
+      const double J11 = x[5*8 + l] - x[1*8 + l];
+      const double det = J00*J11 - J01*J10;
+      const double K00 = J11/det, K01 = -J01/det;
+      const double K10 = -J10/det, K11 = J00/det;
+
+      // Physical gradients of the basis functions
+      g[0][l] = -K00 - K10;
+      g[1][l] = -K01 - K11;
+      g[2][l] = K00;
+      g[3][l] = K01;
+      g[4][l] = K10;
+      g[5][l] = K11;
+      scale[l] = 0.5*std::abs(det);
+    }
+
+    for (std::size_t i = 0; i < 3; ++i)
+    {
+      for (std::size_t j = 0; j < 3; ++j)
+      {
+        #pragma omp simd
+        for (std::size_t l = 0; l < 8; ++l)
+        {
+          A[(3*i + j)*8 + l] = scale[l]*(g[2*i][l]*g[2*j][l]
+                                         + g[2*i + 1][l]*g[2*j + 1][l]);
+        }
+      }
+    }
+  }
+};
+
+double assemble_poisson1_vectorized(bool vectorized)
+{
+  auto mesh = std::make_shared<UnitSquareMesh>(SIZE_2D, SIZE_2D);
+  auto V = std::make_shared<Poisson2DP1::FunctionSpace>(mesh);
+  Poisson2DP1::BilinearForm form(V, V);
+  if (vectorized)
+    form.set_vectorized_cell_integral(std::make_shared<VectorizedPoisson2DP1>());
+
+  // Assemble once, processing cells in batches
+  const double t0 = time();
+  Matrix A;
+  Assembler assembler;
+  assembler.cell_batch_size = 64;
+  assembler.assemble(A, form);
+  return time() - t0;
+}
+
 int main(int argc, char* argv[])
 {
   info("Assembly for various forms and backends");
@@ -100,6 +180,8 @@ int main(int argc, char* argv[])
   Table t5("Assemble cells");
   Table t6("Overhead");
   Table t7("Reassemble total");
+  Table t8("Assemble total (batched)");
+  Table t9("Assemble poisson1 (batched)");
 
   // Benchmark assembly
   for (unsigned int i = 0; i < forms.size(); i++)
@@ -150,8 +232,19 @@ int main(int argc, char* argv[])
         parameters["timer_prefix"] = backends[j];
         std::cout << "  Backend: " << backends[j] << std::endl;
         t7(forms[i], backends[j]) = bench_form(forms[i], reassemble_form);
+        t8(forms[i], backends[j]) = bench_form(forms[i],
+                                               assemble_form_batched);
       }
     }
+
+    // Compare scalar and interleaved kernels for P1 Poisson
+    for (unsigned int j = 0; j < backends.size(); j++)
+    {
+      parameters["linear_algebra_backend"] = backends[j];
+      parameters["timer_prefix"] = backends[j];
+      t9("scalar", backends[j]) = assemble_poisson1_vectorized(false);
+      t9("vectorized", backends[j]) = assemble_poisson1_vectorized(true);
+    }
   }
 
   // Display results
@@ -164,7 +257,11 @@ int main(int argc, char* argv[])
   std::cout << std::endl; info(t5, true);
   std::cout << std::endl; info(t6, true);
   if (argc == 1)
+  {
     std::cout << std::endl; info(t7, true);
+    std::cout << std::endl; info(t8, true);
+    std::cout << std::endl; info(t9, true);
+  }
 
   return 0;
 }
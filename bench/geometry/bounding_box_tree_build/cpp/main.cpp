@@ -21,6 +21,7 @@
 // First added:  2013-04-18
 // Last changed: 2013-06-25
 
+#include <string>
 #include <vector>
 #include <dolfin.h>
 
@@ -42,5 +43,15 @@ int main(int argc, char* argv[])
   tree.build(mesh);
   info("BENCH %g", toc());
 
+  // Build tree with each split strategy
+  for (std::string split : {"median", "sah", "morton"})
+  {
+    parameters["bounding_box_tree_split"] = split;
+    tic();
+    BoundingBoxTree tree;
+    tree.build(mesh);
+    info("BENCH %s %g", split.c_str(), toc());
+  }
+
   return 0;
 }
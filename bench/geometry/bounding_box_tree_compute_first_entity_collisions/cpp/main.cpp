@@ -0,0 +1,76 @@
+// Copyright (C) 2026 agent
+//
+// This file is part of DOLFIN.
+//
+// DOLFIN is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// DOLFIN is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with DOLFIN. If not, see <http://www.gnu.org/licenses/>.
+//
+// This benchmark measures the performance of point location with
+// compute_first_entity_collision (one point at a time) and
+// compute_first_entity_collisions (list of points).
+
+#include <cstdlib>
+#include <vector>
+#include <dolfin.h>
+
+using namespace dolfin;
+
+#define NUM_POINTS 1000000
+#define SIZE 64
+
+int main(int argc, char* argv[])
+{
+  info("Compute first entity collisions for %d points on UnitCubeMesh(%d, %d, %d)",
+       NUM_POINTS, SIZE, SIZE, SIZE);
+
+  // Create mesh and tree
+  UnitCubeMesh mesh(SIZE, SIZE, SIZE);
+  BoundingBoxTree tree;
+  tree.build(mesh);
+
+  // Create random points
+  std::srand(1);
+  std::vector<double> x(3*NUM_POINTS);
+  for (auto& xi : x)
+    xi = static_cast<double>(std::rand())/RAND_MAX;
+
+  // One point at a time
+  tic();
+  std::vector<unsigned int> entities0(NUM_POINTS);
+  for (int i = 0; i < NUM_POINTS; i++)
+  {
+    const Point point(x[3*i], x[3*i + 1], x[3*i + 2]);
+    entities0[i] = tree.compute_first_entity_collision(point);
+  }
+  const double t0 = toc();
+
+  // List of points
+  tic();
+  std::vector<unsigned int> entities1
+    = tree.compute_first_entity_collisions(x);
+  const double t1 = toc();
+
+  // Check result
+  if (entities0 != entities1)
+  {
+    dolfin_error("main.cpp",
+                 "benchmark batched point location",
+                 "Batched and single point searches found different entities");
+  }
+
+  // Report result
+  info("BENCH single %g", t0);
+  info("BENCH batched %g", t1);
+
+  return 0;
+}
@@ -18,6 +18,7 @@
 // First added:  2010-11-25
 // Last changed: 2012-12-12
 
+#include <string>
 #include <dolfin.h>
 #include <dolfin/log/LogLevel.h>
 
@@ -32,7 +33,7 @@ using namespace dolfin;
 
 int main(int argc, char* argv[])
 {
-  info("Creating cell-cell connectivity for unit cube of size %d x %d x %d (%d repetitions)",
+  info("Creating cell-cell connectivity and entities for unit cube of size %d x %d x %d (%d repetitions)",
        SIZE, SIZE, SIZE, NUM_REPS);
 
   set_log_level(DBG);
@@ -61,5 +62,21 @@ int main(int argc, char* argv[])
   const auto t = timing("Compute connectivity 3-3", TimingClear::clear);
   info("BENCH %g", std::get<1>(t));
 
+  // Compute edges and facets on one thread and on several threads
+  // (--num_threads, default 4). The numbering is the same.
+  const int n = parameters["num_threads"];
+  for (int num_threads : {1, n > 1 ? n : 4})
+  {
+    parameters["num_threads"] = num_threads;
+    const std::string threads = num_threads == 1 ? "serial" : "threaded";
+    for (int d : {1, 2})
+    {
+      mesh.clean();
+      tic();
+      mesh.init(d);
+      info("BENCH entities-%d-%s %g", d, threads.c_str(), toc());
+    }
+  }
+
   return 0;
 }
@@ -20,6 +20,7 @@
 
 #include <cstdlib>
 #include <sstream>
+#include <dolfin/parameter/GlobalParameters.h>
 #include "utils.h"
 
 //-----------------------------------------------------------------------------
@@ -55,4 +56,14 @@ std::string dolfin::to_string(const double* x, std::size_t n)
   return s.str();
 }
 //-----------------------------------------------------------------------------
+std::size_t dolfin::num_threads()
+{
+  #ifdef HAS_OPENMP
+  const int n = parameters["num_threads"];
+  return n > 0 ? n : 1;
+  #else
+  return 1;
+  #endif
+}
+//-----------------------------------------------------------------------------
 
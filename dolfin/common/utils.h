@@ -71,6 +71,11 @@ namespace dolfin
   /// Return string representation of given array
   std::string to_string(const double* x, std::size_t n);
 
+  /// Return the number of threads for multithreaded computations,
+  /// given by the global parameter "num_threads" (1 if the parameter
+  /// is zero or if DOLFIN is not compiled with OpenMP)
+  std::size_t num_threads();
+
   /// Return a hash of a given object
   template <class T>
   std::size_t hash_local(const T& x)
@@ -22,12 +22,16 @@
 // Modified by Martin Alnaes 2013-2015
 
 #include <algorithm>
+#include <map>
+#include <cstdint>
 #include <dolfin/log/log.h>
 #include <dolfin/log/Progress.h>
 #include <dolfin/common/ArrayView.h>
 #include <dolfin/common/Timer.h>
 #include <dolfin/parameter/GlobalParameters.h>
 #include <dolfin/la/GenericTensor.h>
+#include <dolfin/la/IndexMap.h>
+#include <dolfin/common/MPI.h>
 #include <dolfin/mesh/Mesh.h>
 #include <dolfin/mesh/Cell.h>
 #include <dolfin/mesh/Facet.h>
@@ -41,6 +45,7 @@
 #include "Form.h"
 #include "UFC.h"
 #include "FiniteElement.h"
+#include "VectorizedCellIntegral.h"
 #include "AssemblerBase.h"
 #include "Assembler.h"
 
@@ -48,6 +53,39 @@
 
 using namespace dolfin;
 
+namespace
+{
+  // Return vectorised kernel of form that replaces the given UFC cell
+  // integral (zero pointer if there is none)
+  const VectorizedCellIntegral*
+  vectorized_cell_integral(const Form& a, UFC& ufc,
+                           const ufc::cell_integral* integral)
+  {
+    if (integral == ufc.default_cell_integral.get())
+      return a.vectorized_cell_integral().get();
+    for (std::size_t i = 0; i < ufc.form.max_cell_subdomain_id(); ++i)
+    {
+      if (integral == ufc.get_cell_integral(i))
+        return a.vectorized_cell_integral(i).get();
+    }
+    return NULL;
+  }
+
+  // Return true if form has a vectorised kernel for any of its cell
+  // integrals
+  bool has_vectorized_cell_integrals(const Form& a, const UFC& ufc)
+  {
+    if (a.vectorized_cell_integral())
+      return true;
+    for (std::size_t i = 0; i < ufc.form.max_cell_subdomain_id(); ++i)
+    {
+      if (a.vectorized_cell_integral(i))
+        return true;
+    }
+    return false;
+  }
+}
+
 //----------------------------------------------------------------------------
 void Assembler::assemble(GenericTensor& A, const Form& a)
 {
@@ -113,6 +151,24 @@ void Assembler::assemble_cells(
   if (!ufc.form.has_cell_integrals())
     return;
 
+  // Overlap sending of off-process contributions with assembly of
+  // the remaining cells if requested
+  dolfin_assert(a.mesh());
+  if (overlap_communication && !values && ufc.form.rank() > 0
+      && MPI::size(a.mesh()->mpi_comm()) > 1)
+  {
+    assemble_cells_overlapped(A, a, ufc, domains);
+    return;
+  }
+
+  // Assemble in batches if requested, or if the form has vectorised
+  // cell integrals
+  if (cell_batch_size > 1 || has_vectorized_cell_integrals(a, ufc))
+  {
+    assemble_cells_batched(A, a, ufc, domains, values);
+    return;
+  }
+
   // Set timer
   Timer timer("Assemble cells");
 
@@ -193,6 +249,527 @@ void Assembler::assemble_cells(
   }
 }
 //-----------------------------------------------------------------------------
+void Assembler::assemble_cells_overlapped(
+  GenericTensor& A,
+  const Form& a,
+  UFC& ufc,
+  std::shared_ptr<const MeshFunction<std::size_t>> domains)
+{
+  // Set timer
+  Timer timer("Assemble cells (overlapped)");
+
+  // Extract mesh
+  dolfin_assert(a.mesh());
+  const Mesh& mesh = *(a.mesh());
+
+  // Form rank
+  const std::size_t form_rank = ufc.form.rank();
+  dolfin_assert(form_rank == 1 || form_rank == 2);
+
+  // Collect pointers to dof maps
+  std::vector<const GenericDofMap*> dofmaps;
+  for (std::size_t i = 0; i < form_rank; ++i)
+    dofmaps.push_back(a.function_space(i)->dofmap().get());
+
+  // Row ownership. Local row dofs beyond the owned range are owned by
+  // another process.
+  const GenericDofMap& dofmap0 = *dofmaps[0];
+  dolfin_assert(dofmap0.index_map());
+  const std::size_t num_owned_rows
+    = dofmap0.index_map()->size(IndexMap::MapSize::OWNED);
+  const std::size_t bs = dofmap0.index_map()->block_size();
+  const std::vector<int>& row_owners = dofmap0.off_process_owner();
+
+  // Check whether integral is domain-dependent
+  const bool use_domains = domains && !domains->empty();
+
+  // Split cells into cells with off-process rows and interior cells
+  std::vector<std::size_t> shared_cells, interior_cells;
+  for (CellIterator cell(mesh); !cell.end(); ++cell)
+  {
+    // Check that cell is not a ghost
+    dolfin_assert(!cell->is_ghost());
+
+    auto dmap = dofmap0.cell_dofs(cell->index());
+    bool shared = false;
+    for (Eigen::Index i = 0; i < dmap.size(); ++i)
+    {
+      if ((std::size_t) dmap[i] >= num_owned_rows)
+      {
+        shared = true;
+        break;
+      }
+    }
+    if (shared)
+      shared_cells.push_back(cell->index());
+    else
+      interior_cells.push_back(cell->index());
+  }
+
+  // Processes that share dofs with this process. Owners of
+  // off-process rows and processes that send contributions to owned
+  // rows are both in this set.
+  const std::vector<int> neighbours(dofmap0.neighbours().begin(),
+                                    dofmap0.neighbours().end());
+  const std::size_t num_neighbours = neighbours.size();
+
+  // Position of the owner of each off-process row block in the list
+  // of neighbours
+  std::vector<std::size_t> row_neighbours(row_owners.size());
+  for (std::size_t i = 0; i < row_owners.size(); ++i)
+  {
+    auto it = std::lower_bound(neighbours.begin(), neighbours.end(),
+                               row_owners[i]);
+    dolfin_assert(it != neighbours.end() && *it == row_owners[i]);
+    row_neighbours[i] = it - neighbours.begin();
+  }
+
+  // Contributions to off-process rows for each neighbour. Each row is
+  // stored as (global row, number of columns, global columns) in the
+  // index buffer (global row only for vectors) and its values in the
+  // value buffer.
+  std::vector<std::vector<std::int64_t>> send_indices(num_neighbours);
+  std::vector<std::vector<double>> send_values(num_neighbours);
+
+  // Assemble a cell, holding back contributions to off-process rows
+  // if requested
+  ufc::cell_integral* integral = ufc.default_cell_integral.get();
+  ufc::cell ufc_cell;
+  std::vector<double> coordinate_dofs;
+  std::vector<ArrayView<const dolfin::la_index>> dofs(form_rank);
+  std::vector<ArrayView<const dolfin::la_index>> owned_dofs(form_rank);
+  std::vector<dolfin::la_index> owned_rows;
+  std::vector<double> owned_values;
+  Progress p(AssemblerBase::progress_message(A.rank(), "cells"),
+             mesh.num_cells());
+  auto assemble_cell = [&](std::size_t cell_index, bool shared)
+  {
+    const Cell cell(mesh, cell_index);
+
+    // Get integral for sub domain (if any)
+    if (use_domains)
+      integral = ufc.get_cell_integral((*domains)[cell]);
+
+    // Skip if no integral on current domain
+    if (!integral)
+      return;
+
+    // Get local-to-global dof maps for cell
+    for (std::size_t i = 0; i < form_rank; ++i)
+    {
+      auto dmap = dofmaps[i]->cell_dofs(cell_index);
+      dofs[i].set(dmap.size(), dmap.data());
+      if (dofs[i].size() == 0)
+        return;
+    }
+
+    // Tabulate cell tensor
+    cell.get_cell_data(ufc_cell);
+    cell.get_coordinate_dofs(coordinate_dofs);
+    ufc.update(cell, coordinate_dofs, ufc_cell,
+               integral->enabled_coefficients());
+    integral->tabulate_tensor(ufc.A.data(), ufc.w(),
+                              coordinate_dofs.data(),
+                              ufc_cell.orientation);
+
+    if (!shared)
+    {
+      A.add_local(ufc.A.data(), dofs);
+      return;
+    }
+
+    // Add owned rows and hold back off-process rows
+    const std::size_t num_cols = (form_rank == 2) ? dofs[1].size() : 1;
+    owned_rows.clear();
+    owned_values.clear();
+    for (std::size_t i = 0; i < dofs[0].size(); ++i)
+    {
+      const dolfin::la_index row = dofs[0][i];
+      const double* row_values = ufc.A.data() + i*num_cols;
+      if ((std::size_t) row < num_owned_rows)
+      {
+        owned_rows.push_back(row);
+        owned_values.insert(owned_values.end(), row_values,
+                            row_values + num_cols);
+        continue;
+      }
+
+      const std::size_t owner = row_neighbours[(row - num_owned_rows)/bs];
+      send_indices[owner].push_back(dofmap0.local_to_global_index(row));
+      if (form_rank == 2)
+      {
+        send_indices[owner].push_back(num_cols);
+        for (std::size_t j = 0; j < num_cols; ++j)
+        {
+          send_indices[owner].push_back(
+            dofmaps[1]->local_to_global_index(dofs[1][j]));
+        }
+      }
+      send_values[owner].insert(send_values[owner].end(), row_values,
+                                row_values + num_cols);
+    }
+
+    if (!owned_rows.empty())
+    {
+      owned_dofs[0].set(owned_rows.size(), owned_rows.data());
+      if (form_rank == 2)
+        owned_dofs[1].set(dofs[1].size(), dofs[1].data());
+      A.add_local(owned_values.data(), owned_dofs);
+    }
+  };
+
+  // Assemble cells with off-process rows
+  for (auto cell_index : shared_cells)
+  {
+    assemble_cell(cell_index, true);
+    p++;
+  }
+
+  #ifdef HAS_MPI
+  // Communicate on a duplicate of the mesh communicator so that the
+  // messages cannot match other point-to-point traffic. The duplicate
+  // is kept between assemblies.
+  int comm_compare = MPI_UNEQUAL;
+  if (_overlap_comm)
+    MPI_Comm_compare(_overlap_comm->comm(), mesh.mpi_comm(), &comm_compare);
+  if (comm_compare != MPI_CONGRUENT)
+    _overlap_comm = std::make_shared<MPI::Comm>(mesh.mpi_comm());
+  const MPI_Comm comm = _overlap_comm->comm();
+
+  // Start sending message sizes and off-process contributions to the
+  // neighbours. Sizes are sent to all neighbours (also if zero) so
+  // that each process knows what to receive.
+  const int size_tag = 0;
+  const int index_tag = 1;
+  const int value_tag = 2;
+  std::vector<std::int64_t> send_sizes(2*num_neighbours);
+  std::vector<std::int64_t> recv_sizes(2*num_neighbours);
+  std::vector<MPI_Request> size_requests(2*num_neighbours);
+  std::vector<MPI_Request> requests;
+  for (std::size_t i = 0; i < num_neighbours; ++i)
+  {
+    MPI_Irecv(recv_sizes.data() + 2*i, 2, MPI_INT64_T, neighbours[i],
+              size_tag, comm, &size_requests[i]);
+  }
+  for (std::size_t i = 0; i < num_neighbours; ++i)
+  {
+    send_sizes[2*i] = send_indices[i].size();
+    send_sizes[2*i + 1] = send_values[i].size();
+    MPI_Isend(send_sizes.data() + 2*i, 2, MPI_INT64_T, neighbours[i],
+              size_tag, comm, &size_requests[num_neighbours + i]);
+
+    if (send_values[i].empty())
+      continue;
+    requests.push_back(MPI_REQUEST_NULL);
+    MPI_Isend(send_indices[i].data(), send_indices[i].size(), MPI_INT64_T,
+              neighbours[i], index_tag, comm, &requests.back());
+    requests.push_back(MPI_REQUEST_NULL);
+    MPI_Isend(send_values[i].data(), send_values[i].size(), MPI_DOUBLE,
+              neighbours[i], value_tag, comm, &requests.back());
+  }
+  #endif
+
+  // Assemble interior cells while messages are in flight
+  for (auto cell_index : interior_cells)
+  {
+    assemble_cell(cell_index, false);
+    p++;
+  }
+
+  #ifdef HAS_MPI
+  // Receive contributions from neighbours that have sent any
+  MPI_Waitall(size_requests.size(), size_requests.data(),
+              MPI_STATUSES_IGNORE);
+  std::vector<std::vector<std::int64_t>> recv_indices(num_neighbours);
+  std::vector<std::vector<double>> recv_values(num_neighbours);
+  for (std::size_t i = 0; i < num_neighbours; ++i)
+  {
+    if (recv_sizes[2*i + 1] == 0)
+      continue;
+    recv_indices[i].resize(recv_sizes[2*i]);
+    recv_values[i].resize(recv_sizes[2*i + 1]);
+    requests.push_back(MPI_REQUEST_NULL);
+    MPI_Irecv(recv_indices[i].data(), recv_indices[i].size(), MPI_INT64_T,
+              neighbours[i], index_tag, comm, &requests.back());
+    requests.push_back(MPI_REQUEST_NULL);
+    MPI_Irecv(recv_values[i].data(), recv_values[i].size(), MPI_DOUBLE,
+              neighbours[i], value_tag, comm, &requests.back());
+  }
+  MPI_Waitall(requests.size(), requests.data(), MPI_STATUSES_IGNORE);
+
+  // Add received contributions to owned rows
+  std::vector<dolfin::la_index> global_dofs;
+  std::vector<ArrayView<const dolfin::la_index>> global_rows(form_rank);
+  for (std::size_t i = 0; i < num_neighbours; ++i)
+  {
+    std::size_t pos = 0;
+    const double* row_values = recv_values[i].data();
+    while (pos < recv_indices[i].size())
+    {
+      global_dofs.clear();
+      global_dofs.push_back(recv_indices[i][pos++]);
+      std::size_t num_cols = 1;
+      if (form_rank == 2)
+      {
+        num_cols = recv_indices[i][pos++];
+        for (std::size_t j = 0; j < num_cols; ++j)
+          global_dofs.push_back(recv_indices[i][pos++]);
+        global_rows[1].set(num_cols, global_dofs.data() + 1);
+      }
+      global_rows[0].set(1, global_dofs.data());
+      A.add(row_values, global_rows);
+      row_values += num_cols;
+    }
+    dolfin_assert(row_values == recv_values[i].data() + recv_values[i].size());
+  }
+  #endif
+}
+//-----------------------------------------------------------------------------
+void Assembler::assemble_cells_batched(
+  GenericTensor& A,
+  const Form& a,
+  UFC& ufc,
+  std::shared_ptr<const MeshFunction<std::size_t>> domains,
+  std::vector<double>* values)
+{
+  // Set timer
+  Timer timer("Assemble cells");
+
+  // Extract mesh
+  dolfin_assert(a.mesh());
+  const Mesh& mesh = *(a.mesh());
+  if (mesh.num_cells() == 0)
+    return;
+
+  // Form rank
+  const std::size_t form_rank = ufc.form.rank();
+
+  // Check if form is a functional
+  const bool is_cell_functional = (values && form_rank == 0) ? true : false;
+
+  // Collect pointers to dof maps and number of dofs per cell
+  std::vector<const GenericDofMap*> dofmaps;
+  std::vector<std::size_t> num_cell_dofs;
+  std::size_t tensor_size = 1;
+  for (std::size_t i = 0; i < form_rank; ++i)
+  {
+    dofmaps.push_back(a.function_space(i)->dofmap().get());
+    num_cell_dofs.push_back(dofmaps[i]->max_element_dofs());
+    tensor_size *= num_cell_dofs[i];
+  }
+
+  // Check whether integral is domain-dependent
+  const bool use_domains = domains && !domains->empty();
+
+  // Group cells by integral so that all cells of a batch are
+  // tabulated by the same kernel. Groups are kept in order of first
+  // appearance to make the summation order deterministic.
+  std::vector<std::pair<ufc::cell_integral*, std::vector<std::size_t>>>
+    integral_cells;
+  ufc::cell_integral* integral = ufc.default_cell_integral.get();
+  for (CellIterator cell(mesh); !cell.end(); ++cell)
+  {
+    if (use_domains)
+      integral = ufc.get_cell_integral((*domains)[*cell]);
+    if (!integral)
+      continue;
+
+    auto it = std::find_if(integral_cells.begin(), integral_cells.end(),
+                           [integral](const std::pair<ufc::cell_integral*,
+                                      std::vector<std::size_t>>& g)
+                           { return g.first == integral; });
+    if (it == integral_cells.end())
+    {
+      integral_cells.push_back({integral, std::vector<std::size_t>()});
+      it = integral_cells.end() - 1;
+    }
+    it->second.push_back(cell->index());
+  }
+
+  // Size of coordinate dofs for a cell (same for all cells)
+  std::vector<double> coordinate_dofs;
+  Cell(mesh, 0).get_coordinate_dofs(coordinate_dofs);
+  const std::size_t num_coordinate_dofs = coordinate_dofs.size();
+
+  // Vectorised kernel (if any) for each group. The batch size is
+  // rounded up to a multiple of the number of lanes so that only the
+  // last batch of a group has cells left over.
+  std::vector<const VectorizedCellIntegral*>
+    vectorized_integrals(integral_cells.size());
+  std::size_t N = std::max(cell_batch_size, (std::size_t) 1);
+  std::size_t max_lanes = 0;
+  for (std::size_t g = 0; g < integral_cells.size(); ++g)
+  {
+    vectorized_integrals[g]
+      = vectorized_cell_integral(a, ufc, integral_cells[g].first);
+    if (vectorized_integrals[g])
+    {
+      const std::size_t W = vectorized_integrals[g]->num_lanes();
+      dolfin_assert(W > 0);
+      N = ((N + W - 1)/W)*W;
+      max_lanes = std::max(max_lanes, W);
+    }
+  }
+
+  // Contiguous buffers for a batch of cells
+  const std::size_t num_coefficients = ufc.form.num_coefficients();
+  std::vector<double> coordinate_dofs_batch(N*num_coordinate_dofs);
+  std::vector<int> orientation_batch(N);
+  std::vector<std::size_t> cell_batch(N);
+  std::vector<std::vector<double>> w_batch(num_coefficients);
+  for (std::size_t j = 0; j < num_coefficients; ++j)
+    w_batch[j].resize(N*ufc.coefficient_dimension(j));
+  std::vector<double*> w_cell(num_coefficients);
+  std::vector<double> A_batch(N*tensor_size);
+  std::vector<std::vector<dolfin::la_index>> dofs_batch(form_rank);
+  for (std::size_t i = 0; i < form_rank; ++i)
+    dofs_batch[i].resize(N*num_cell_dofs[i]);
+  std::vector<ArrayView<const dolfin::la_index>> dofs(form_rank);
+
+  // Interleaved (lane-major) buffers for vectorised kernels
+  std::vector<double> coordinate_dofs_lanes(max_lanes*num_coordinate_dofs);
+  std::vector<std::vector<double>> w_lanes(num_coefficients);
+  std::vector<double*> w_lane_ptrs(num_coefficients);
+  for (std::size_t j = 0; j < num_coefficients; ++j)
+  {
+    w_lanes[j].resize(max_lanes*ufc.coefficient_dimension(j));
+    w_lane_ptrs[j] = w_lanes[j].data();
+  }
+  std::vector<double> A_lanes(max_lanes*tensor_size);
+
+  // Assemble over cells, one batch at a time
+  ufc::cell ufc_cell;
+  Progress p(AssemblerBase::progress_message(A.rank(), "cells"),
+             mesh.num_cells());
+  for (std::size_t g = 0; g < integral_cells.size(); ++g)
+  {
+    auto& group = integral_cells[g];
+    const VectorizedCellIntegral* vectorized_integral
+      = vectorized_integrals[g];
+    integral = group.first;
+    const std::vector<bool>& enabled = integral->enabled_coefficients();
+    const std::vector<std::size_t>& cells = group.second;
+
+    std::size_t pos = 0;
+    while (pos < cells.size())
+    {
+      // Gather geometry, coefficients and dofs for a batch of cells
+      std::size_t n = 0;
+      for (; pos < cells.size() && n < N; ++pos)
+      {
+        const Cell cell(mesh, cells[pos]);
+
+        // Check that cell is not a ghost
+        dolfin_assert(!cell.is_ghost());
+
+        // Get local-to-global dof maps for cell, skipping cells
+        // with an empty dofmap
+        bool empty_dofmap = false;
+        for (std::size_t i = 0; i < form_rank; ++i)
+        {
+          auto dmap = dofmaps[i]->cell_dofs(cell.index());
+          if (dmap.size() == 0)
+          {
+            empty_dofmap = true;
+            break;
+          }
+          dolfin_assert((std::size_t) dmap.size() == num_cell_dofs[i]);
+          std::copy(dmap.data(), dmap.data() + dmap.size(),
+                    dofs_batch[i].begin() + n*num_cell_dofs[i]);
+        }
+        if (empty_dofmap)
+          continue;
+
+        cell.get_cell_data(ufc_cell);
+        cell.get_coordinate_dofs(coordinate_dofs);
+        dolfin_assert(coordinate_dofs.size() == num_coordinate_dofs);
+        double* cd = coordinate_dofs_batch.data() + n*num_coordinate_dofs;
+        std::copy(coordinate_dofs.begin(), coordinate_dofs.end(), cd);
+
+        for (std::size_t j = 0; j < num_coefficients; ++j)
+          w_cell[j] = w_batch[j].data() + n*ufc.coefficient_dimension(j);
+        ufc.update(cell, cd, ufc_cell, enabled, w_cell.data());
+
+        orientation_batch[n] = ufc_cell.orientation;
+        cell_batch[n] = cell.index();
+        ++n;
+      }
+
+      if (n == 0)
+        continue;
+
+      // Tabulate complete sets of lanes with the vectorised kernel
+      std::size_t num_vectorized = 0;
+      if (vectorized_integral)
+      {
+        const std::size_t W = vectorized_integral->num_lanes();
+        for (; num_vectorized + W <= n; num_vectorized += W)
+        {
+          // Interleave geometry and coefficients
+          for (std::size_t l = 0; l < W; ++l)
+          {
+            const std::size_t c = num_vectorized + l;
+            const double* cd
+              = coordinate_dofs_batch.data() + c*num_coordinate_dofs;
+            for (std::size_t k = 0; k < num_coordinate_dofs; ++k)
+              coordinate_dofs_lanes[k*W + l] = cd[k];
+            for (std::size_t j = 0; j < num_coefficients; ++j)
+            {
+              const std::size_t dim = ufc.coefficient_dimension(j);
+              const double* w = w_batch[j].data() + c*dim;
+              for (std::size_t k = 0; k < dim; ++k)
+                w_lanes[j][k*W + l] = w[k];
+            }
+          }
+
+          vectorized_integral->tabulate_tensor(
+            A_lanes.data(), w_lane_ptrs.data(),
+            coordinate_dofs_lanes.data(),
+            orientation_batch.data() + num_vectorized);
+
+          // De-interleave cell tensors
+          for (std::size_t l = 0; l < W; ++l)
+          {
+            double* A_cell
+              = A_batch.data() + (num_vectorized + l)*tensor_size;
+            for (std::size_t k = 0; k < tensor_size; ++k)
+              A_cell[k] = A_lanes[k*W + l];
+          }
+        }
+      }
+
+      // Tabulate remaining cell tensors for the batch
+      for (std::size_t c = num_vectorized; c < n; ++c)
+      {
+        for (std::size_t j = 0; j < num_coefficients; ++j)
+          w_cell[j] = w_batch[j].data() + c*ufc.coefficient_dimension(j);
+        integral->tabulate_tensor(A_batch.data() + c*tensor_size,
+                                  w_cell.data(),
+                                  coordinate_dofs_batch.data()
+                                  + c*num_coordinate_dofs,
+                                  orientation_batch[c]);
+      }
+
+      // Add entries to global tensor. Either store values cell-by-cell
+      // (currently only available for functionals)
+      if (is_cell_functional)
+      {
+        for (std::size_t c = 0; c < n; ++c)
+          (*values)[cell_batch[c]] = A_batch[c];
+      }
+      else
+      {
+        for (std::size_t i = 0; i < form_rank; ++i)
+          dofs[i].set(n*num_cell_dofs[i], dofs_batch[i].data());
+        A.add_local_batch(A_batch.data(), n, dofs);
+      }
+
+      for (std::size_t c = 0; c < n; ++c)
+        p++;
+    }
+  }
+}
+//-----------------------------------------------------------------------------
 void Assembler::assemble_exterior_facets(
   GenericTensor& A,
   const Form& a,
@@ -23,7 +23,9 @@
 #ifndef __ASSEMBLER_H
 #define __ASSEMBLER_H
 
+#include <memory>
 #include <vector>
+#include <dolfin/common/MPI.h>
 #include "AssemblerBase.h"
 
 namespace dolfin
@@ -55,7 +57,34 @@ namespace dolfin
   public:
 
     /// Constructor
-    Assembler() {}
+    Assembler() : cell_batch_size(1), overlap_communication(false) {}
+
+    /// cell_batch_size (std::size_t)
+    ///     Default value is 1.
+    ///     Number of cells that are processed together during cell
+    ///     assembly. For values larger than one, the geometry,
+    ///     coefficients and dofs of a batch of cells are gathered
+    ///     into contiguous buffers, the cell tensors are tabulated
+    ///     back-to-back and then added to the global tensor in a
+    ///     single call. This reduces the per-cell overhead for
+    ///     low-order forms. Batched assembly is always used if the
+    ///     form has vectorised cell integrals (see
+    ///     _VectorizedCellIntegral_), with the batch size rounded up
+    ///     to a multiple of the number of lanes.
+    std::size_t cell_batch_size;
+
+    /// overlap_communication (bool)
+    ///     Default value is false.
+    ///     If true (and running in parallel), cells with dofs in
+    ///     off-process rows of the tensor are assembled first. Their
+    ///     off-process contributions are sent to the owning
+    ///     processes with non-blocking messages, and the remaining
+    ///     cells are assembled while the messages are in flight. The
+    ///     received contributions are added when all cells are done,
+    ///     which leaves no off-process cell contributions for the
+    ///     final apply(). Cell functionals and scalars are assembled
+    ///     as usual.
+    bool overlap_communication;
 
     /// Assemble tensor from given form
     ///
@@ -125,6 +154,22 @@ namespace dolfin
     void assemble_vertices(GenericTensor& A, const Form& a, UFC& ufc,
                            std::shared_ptr<const MeshFunction<std::size_t>> domains);
 
+  private:
+
+    // Assemble over cells, sending contributions to off-process rows
+    // while the cells without off-process rows are assembled
+    void assemble_cells_overlapped(GenericTensor& A, const Form& a, UFC& ufc,
+                                   std::shared_ptr<const MeshFunction<std::size_t>> domains);
+
+    // Assemble over cells in batches of cell_batch_size cells
+    void assemble_cells_batched(GenericTensor& A, const Form& a, UFC& ufc,
+                                std::shared_ptr<const MeshFunction<std::size_t>> domains,
+                                std::vector<double>* values);
+
+    // Duplicate of the mesh communicator used for overlapped
+    // assembly, kept between assemblies
+    std::shared_ptr<MPI::Comm> _overlap_comm;
+
   };
 
 }
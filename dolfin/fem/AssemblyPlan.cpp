@@ -0,0 +1,396 @@
+// Copyright (C) 2026 agent
+//
+// This file is part of DOLFIN.
+//
+// DOLFIN is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// DOLFIN is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with DOLFIN. If not, see <http://www.gnu.org/licenses/>.
+
+#include <algorithm>
+#include <map>
+#include <dolfin/common/ArrayView.h>
+#include <dolfin/common/Timer.h>
+#include <dolfin/function/FunctionSpace.h>
+#include <dolfin/la/EigenMatrix.h>
+#include <dolfin/la/GenericTensor.h>
+#include <dolfin/la/PETScMatrix.h>
+#include <dolfin/log/log.h>
+#include <dolfin/mesh/Cell.h>
+#include <dolfin/mesh/Facet.h>
+#include <dolfin/mesh/Mesh.h>
+#include <dolfin/mesh/MeshFunction.h>
+#include "Assembler.h"
+#include "Form.h"
+#include "GenericDofMap.h"
+#include "UFC.h"
+#include "AssemblyPlan.h"
+
+using namespace dolfin;
+
+namespace
+{
+  // Tabulate cell tensor
+  void tabulate_tensor(const ufc::cell_integral& integral, double* A,
+                       const double* const* w, const double* coordinate_dofs,
+                       std::size_t local_facet, int orientation)
+  {
+    integral.tabulate_tensor(A, w, coordinate_dofs, orientation);
+  }
+
+  // Tabulate exterior facet tensor
+  void tabulate_tensor(const ufc::exterior_facet_integral& integral,
+                       double* A, const double* const* w,
+                       const double* coordinate_dofs,
+                       std::size_t local_facet, int orientation)
+  {
+    integral.tabulate_tensor(A, w, coordinate_dofs, local_facet, orientation);
+  }
+}
+
+//-----------------------------------------------------------------------------
+AssemblyPlan::AssemblyPlan(std::shared_ptr<const Form> a)
+  : _a(a), _num_coordinate_dofs(0), _offsets_tensor(nullptr), _offsets_nnz(0)
+{
+  Timer timer("Build assembly plan");
+
+  // Check form
+  dolfin_assert(_a);
+  AssemblerBase::check(*_a);
+
+  // Create data structure for local assembly data
+  _ufc.reset(new UFC(*_a));
+
+  dolfin_assert(_a->mesh());
+  const Mesh& mesh = *_a->mesh();
+  const std::size_t D = mesh.topology().dim();
+
+  // Collect cells for each cell integral
+  if (_ufc->form.has_cell_integrals())
+  {
+    std::shared_ptr<const MeshFunction<std::size_t>> domains
+      = _a->cell_domains();
+    const bool use_domains = domains && !domains->empty();
+    const ufc::cell_integral* integral = _ufc->default_cell_integral.get();
+    std::map<const ufc::cell_integral*, std::size_t> position;
+    for (CellIterator cell(mesh); !cell.end(); ++cell)
+    {
+      // Get integral for sub domain (if any)
+      if (use_domains)
+        integral = _ufc->get_cell_integral((*domains)[*cell]);
+
+      // Skip if no integral on current domain
+      if (!integral)
+        continue;
+
+      auto it = position.insert({integral, _cells.size()});
+      if (it.second)
+        _cells.push_back({integral, EntityData()});
+      add_entity(_cells[it.first->second].second, cell->index(), -1);
+    }
+  }
+
+  // Collect exterior facets for each exterior facet integral
+  if (_ufc->form.has_exterior_facet_integrals())
+  {
+    mesh.init(D - 1);
+    mesh.init(D - 1, D);
+
+    std::shared_ptr<const MeshFunction<std::size_t>> domains
+      = _a->exterior_facet_domains();
+    const bool use_domains = domains && !domains->empty();
+    const ufc::exterior_facet_integral* integral
+      = _ufc->default_exterior_facet_integral.get();
+    std::map<const ufc::exterior_facet_integral*, std::size_t> position;
+    for (FacetIterator facet(mesh); !facet.end(); ++facet)
+    {
+      // Only consider exterior facets
+      if (!facet->exterior())
+        continue;
+
+      // Get integral for sub domain (if any)
+      if (use_domains)
+        integral = _ufc->get_exterior_facet_integral((*domains)[*facet]);
+
+      // Skip if no integral on current domain
+      if (!integral)
+        continue;
+
+      // Get cell to which facet belongs
+      dolfin_assert(facet->num_entities(D) == 1);
+      const Cell cell(mesh, facet->entities(D)[0]);
+      dolfin_assert(!cell.is_ghost());
+
+      auto it = position.insert({integral, _exterior_facets.size()});
+      if (it.second)
+        _exterior_facets.push_back({integral, EntityData()});
+      add_entity(_exterior_facets[it.first->second].second, cell.index(),
+                 cell.index(*facet));
+    }
+  }
+}
+//-----------------------------------------------------------------------------
+AssemblyPlan::~AssemblyPlan()
+{
+  // Do nothing
+}
+//-----------------------------------------------------------------------------
+void AssemblyPlan::assemble(GenericTensor& A)
+{
+  Timer timer("Assemble (plan)");
+
+  // Initialise global tensor on first use, otherwise only zero
+  if (A.empty())
+    init_global_tensor(A, *_a);
+  else if (!add_values)
+    A.zero();
+
+  // Get raw values of Eigen matrix and compute offsets of element
+  // tensor entries if not already computed for this matrix
+  double* values = nullptr;
+  if (A.rank() == 2 && has_type<EigenMatrix>(A))
+  {
+    EigenMatrix::eigen_matrix_type& mat = as_type<EigenMatrix>(A).mat();
+    if (!mat.isCompressed())
+      mat.makeCompressed();
+
+    const std::size_t nnz = mat.nonZeros();
+    if (_offsets_tensor != A.instance() || _offsets_nnz != nnz)
+    {
+      for (auto& entities : _cells)
+      {
+        compute_value_offsets(entities.second, mat.outerIndexPtr(),
+                              mat.innerIndexPtr());
+      }
+      for (auto& entities : _exterior_facets)
+      {
+        compute_value_offsets(entities.second, mat.outerIndexPtr(),
+                              mat.innerIndexPtr());
+      }
+      _offsets_tensor = A.instance();
+      _offsets_nnz = nnz;
+    }
+    values = mat.valuePtr();
+  }
+
+  // Compute offsets of element tensor entries in PETSc matrix values
+  // if not already computed, and begin direct insertion. The AIJ
+  // structure is only complete once the matrix has been assembled.
+  PETScMatrix* petsc_A = nullptr;
+  #ifdef HAS_PETSC
+  if (A.rank() == 2 && has_type<PETScMatrix>(A))
+  {
+    PETScMatrix& _A = as_type<PETScMatrix>(A);
+    PetscBool assembled = PETSC_FALSE;
+    MatAssembled(_A.mat(), &assembled);
+    if (assembled)
+    {
+      const std::size_t nnz = _A.nnz();
+      if (_offsets_tensor != A.instance() || _offsets_nnz != nnz)
+      {
+        for (auto& entities : _cells)
+          compute_value_offsets(entities.second, _A);
+        for (auto& entities : _exterior_facets)
+          compute_value_offsets(entities.second, _A);
+        _offsets_tensor = A.instance();
+        _offsets_nnz = nnz;
+      }
+      petsc_A = &_A;
+      petsc_A->begin_direct_insertion();
+    }
+  }
+  #endif
+
+  // Assemble over cells and exterior facets
+  assemble_entities(A, _cells, values, petsc_A);
+  assemble_entities(A, _exterior_facets, values, petsc_A);
+
+  #ifdef HAS_PETSC
+  if (petsc_A)
+    petsc_A->end_direct_insertion();
+  #endif
+
+  // Assemble interior facet and vertex integrals
+  if (_ufc->form.has_interior_facet_integrals()
+      || _ufc->form.has_vertex_integrals())
+  {
+    Assembler assembler;
+    assembler.assemble_interior_facets(A, *_a, *_ufc,
+                                       _a->interior_facet_domains(),
+                                       _a->cell_domains(), NULL);
+    assembler.assemble_vertices(A, *_a, *_ufc, _a->vertex_domains());
+  }
+
+  // Finalize assembly of global tensor
+  if (finalize_tensor)
+    A.apply("add");
+}
+//-----------------------------------------------------------------------------
+void AssemblyPlan::add_entity(EntityData& data, std::size_t cell_index,
+                              int local_facet)
+{
+  const Mesh& mesh = *_a->mesh();
+  const std::size_t form_rank = _a->rank();
+  const Cell cell(mesh, cell_index);
+
+  // Cell and facet
+  data.cells.push_back(cell_index);
+  if (local_facet >= 0)
+    data.local_facets.push_back(local_facet);
+
+  // Orientation and geometry
+  ufc::cell ufc_cell;
+  std::vector<double> coordinate_dofs;
+  cell.get_cell_data(ufc_cell, local_facet);
+  cell.get_coordinate_dofs(coordinate_dofs);
+  dolfin_assert(_num_coordinate_dofs == 0
+                || _num_coordinate_dofs == coordinate_dofs.size());
+  _num_coordinate_dofs = coordinate_dofs.size();
+  data.orientations.push_back(ufc_cell.orientation);
+  data.coordinate_dofs.insert(data.coordinate_dofs.end(),
+                              coordinate_dofs.begin(), coordinate_dofs.end());
+
+  // Dofs for each form argument
+  if (data.dofs.empty())
+  {
+    data.dofs.resize(form_rank);
+    data.dof_offsets.resize(form_rank, std::vector<std::size_t>(1, 0));
+  }
+  for (std::size_t i = 0; i < form_rank; ++i)
+  {
+    auto dmap = _a->function_space(i)->dofmap()->cell_dofs(cell_index);
+    data.dofs[i].insert(data.dofs[i].end(), dmap.data(),
+                        dmap.data() + dmap.size());
+    data.dof_offsets[i].push_back(data.dofs[i].size());
+  }
+}
+//-----------------------------------------------------------------------------
+void AssemblyPlan::compute_value_offsets(EntityData& data,
+                                         const int* row_ptr,
+                                         const int* cols)
+{
+  dolfin_assert(data.dofs.size() == 2);
+  data.value_offsets.clear();
+  for (std::size_t e = 0; e < data.cells.size(); ++e)
+  {
+    const std::size_t* offsets0 = data.dof_offsets[0].data() + e;
+    const std::size_t* offsets1 = data.dof_offsets[1].data() + e;
+    for (std::size_t i = offsets0[0]; i < offsets0[1]; ++i)
+    {
+      const dolfin::la_index row = data.dofs[0][i];
+      const int* row_begin = cols + row_ptr[row];
+      const int* row_end = cols + row_ptr[row + 1];
+      for (std::size_t j = offsets1[0]; j < offsets1[1]; ++j)
+      {
+        const dolfin::la_index col = data.dofs[1][j];
+        const int* pos = std::lower_bound(row_begin, row_end, col);
+        if (pos == row_end || *pos != col)
+        {
+          dolfin_error("AssemblyPlan.cpp",
+                       "compute matrix value offsets",
+                       "Entry (%d, %d) is not in the sparsity pattern",
+                       row, col);
+        }
+        data.value_offsets.push_back(pos - cols);
+      }
+    }
+  }
+}
+//-----------------------------------------------------------------------------
+void AssemblyPlan::compute_value_offsets(EntityData& data,
+                                         const PETScMatrix& A)
+{
+  dolfin_assert(data.dofs.size() == 2);
+  data.value_offsets.clear();
+  #ifdef HAS_PETSC
+  for (std::size_t e = 0; e < data.cells.size(); ++e)
+  {
+    const std::size_t offset0 = data.dof_offsets[0][e];
+    const std::size_t offset1 = data.dof_offsets[1][e];
+    A.compute_value_offsets(data.value_offsets,
+                            data.dof_offsets[0][e + 1] - offset0,
+                            data.dofs[0].data() + offset0,
+                            data.dof_offsets[1][e + 1] - offset1,
+                            data.dofs[1].data() + offset1);
+  }
+  #endif
+}
+//-----------------------------------------------------------------------------
+template<typename Integral>
+void AssemblyPlan::assemble_entities(
+  GenericTensor& A,
+  std::vector<std::pair<const Integral*, EntityData>>& entities,
+  double* values, PETScMatrix* petsc_A)
+{
+  const Mesh& mesh = *_a->mesh();
+  const std::size_t form_rank = _a->rank();
+  const bool has_coefficients = _ufc->form.num_coefficients() > 0;
+
+  ufc::cell ufc_cell;
+  std::vector<ArrayView<const dolfin::la_index>> dofs(form_rank);
+  for (auto& integral_entities : entities)
+  {
+    const Integral& integral = *integral_entities.first;
+    const EntityData& data = integral_entities.second;
+    const bool facets = !data.local_facets.empty();
+    const std::int64_t* value_offsets = data.value_offsets.data();
+
+    for (std::size_t e = 0; e < data.cells.size(); ++e)
+    {
+      const double* coordinate_dofs
+        = data.coordinate_dofs.data() + e*_num_coordinate_dofs;
+      const std::size_t local_facet = facets ? data.local_facets[e] : 0;
+
+      // Restrict coefficients to cell
+      if (has_coefficients)
+      {
+        const Cell cell(mesh, data.cells[e]);
+        cell.get_cell_data(ufc_cell, facets ? (int) local_facet : -1);
+        _ufc->update(cell, coordinate_dofs, ufc_cell,
+                     integral.enabled_coefficients(), _ufc->w());
+      }
+
+      // Tabulate element tensor
+      tabulate_tensor(integral, _ufc->A.data(), _ufc->w(), coordinate_dofs,
+                      local_facet, data.orientations[e]);
+
+      // Add entries directly to matrix values, or via the tensor
+      // interface
+      for (std::size_t i = 0; i < form_rank; ++i)
+      {
+        const std::size_t offset = data.dof_offsets[i][e];
+        dofs[i].set(data.dof_offsets[i][e + 1] - offset,
+                    data.dofs[i].data() + offset);
+      }
+
+      if (values)
+      {
+        const std::size_t size = dofs[0].size()*dofs[1].size();
+        for (std::size_t k = 0; k < size; ++k)
+          values[value_offsets[k]] += _ufc->A[k];
+        value_offsets += size;
+      }
+      #ifdef HAS_PETSC
+      else if (petsc_A)
+      {
+        petsc_A->add_local_direct(_ufc->A.data(),
+                                  dofs[0].size(), dofs[0].data(),
+                                  dofs[1].size(), dofs[1].data(),
+                                  value_offsets);
+        value_offsets += dofs[0].size()*dofs[1].size();
+      }
+      #endif
+      else
+        A.add_local(_ufc->A.data(), dofs);
+    }
+  }
+}
+//-----------------------------------------------------------------------------
@@ -0,0 +1,154 @@
+// Copyright (C) 2026 agent
+//
+// This file is part of DOLFIN.
+//
+// DOLFIN is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// DOLFIN is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with DOLFIN. If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef __ASSEMBLY_PLAN_H
+#define __ASSEMBLY_PLAN_H
+
+#include <memory>
+#include <utility>
+#include <vector>
+#include <dolfin/common/types.h>
+#include "AssemblerBase.h"
+
+namespace ufc
+{
+  class cell_integral;
+  class exterior_facet_integral;
+}
+
+namespace dolfin
+{
+
+  // Forward declarations
+  class GenericTensor;
+  class Form;
+  class LinearAlgebraObject;
+  class PETScMatrix;
+  class UFC;
+
+  /// This class provides repeated assembly of a form on a fixed
+  /// mesh. When the plan is created, the cells and exterior facets
+  /// of each subdomain are collected together with their dofs,
+  /// coordinate dofs and orientations, which are stored in flattened
+  /// arrays. Subsequent calls to assemble() only restrict the
+  /// coefficients and tabulate the element tensors.
+  ///
+  /// When assembling into an _EigenMatrix_ or an (assembled) AIJ
+  /// _PETScMatrix_, the position of each element tensor entry in the
+  /// compressed row storage of the matrix is computed once, and
+  /// element tensors are then added directly to the matrix values
+  /// without any sparsity lookups. The offsets are recomputed if a
+  /// different matrix is passed. Other backends receive the cached
+  /// dofs via add_local(). A PETSc matrix is only assembled after
+  /// the first call, so direct insertion starts with the second
+  /// call.
+  ///
+  /// Interior facet and vertex integrals are assembled with
+  /// _Assembler_. The plan must be recreated if the mesh, the dof
+  /// maps or the subdomain markers change.
+
+  class AssemblyPlan : public AssemblerBase
+  {
+  public:
+
+    /// Create assembly plan for form
+    ///
+    /// @param[in] a (Form)
+    ///         The form to assemble.
+    explicit AssemblyPlan(std::shared_ptr<const Form> a);
+
+    /// Destructor
+    ~AssemblyPlan();
+
+    /// Assemble tensor. The tensor is initialised on the first call
+    /// if it is empty.
+    ///
+    /// @param[out] A (GenericTensor)
+    ///         The tensor to assemble.
+    void assemble(GenericTensor& A);
+
+  private:
+
+    // Cached data for the mesh entities that share an integral
+    struct EntityData
+    {
+      // Cell index and local facet index (exterior facets only) of
+      // each entity
+      std::vector<std::size_t> cells;
+      std::vector<std::size_t> local_facets;
+
+      // Orientation and coordinate dofs (flattened) of each entity
+      std::vector<int> orientations;
+      std::vector<double> coordinate_dofs;
+
+      // Dofs (flattened) and offsets into dofs for each form
+      // argument
+      std::vector<std::vector<dolfin::la_index>> dofs;
+      std::vector<std::vector<std::size_t>> dof_offsets;
+
+      // Position of each element tensor entry in the matrix values
+      // (flattened)
+      std::vector<std::int64_t> value_offsets;
+    };
+
+    // Append dofs, coordinate dofs and orientation of a cell (and
+    // local facet) to entity data
+    void add_entity(EntityData& data, std::size_t cell_index,
+                    int local_facet);
+
+    // Compute positions of element tensor entries in CSR matrix
+    // values
+    static void compute_value_offsets(EntityData& data,
+                                      const int* row_ptr,
+                                      const int* cols);
+
+    // Compute positions of element tensor entries in PETSc matrix
+    // values
+    static void compute_value_offsets(EntityData& data,
+                                      const PETScMatrix& A);
+
+    // Assemble entities of one integral type
+    template<typename Integral>
+    void assemble_entities(
+      GenericTensor& A,
+      std::vector<std::pair<const Integral*, EntityData>>& entities,
+      double* values, PETScMatrix* petsc_A);
+
+    // The form
+    std::shared_ptr<const Form> _a;
+
+    // Local assembly data
+    std::unique_ptr<UFC> _ufc;
+
+    // Entity data for each cell and exterior facet integral
+    std::vector<std::pair<const ufc::cell_integral*, EntityData>> _cells;
+    std::vector<std::pair<const ufc::exterior_facet_integral*, EntityData>>
+      _exterior_facets;
+
+    // Number of coordinate dofs per cell
+    std::size_t _num_coordinate_dofs;
+
+    // Matrix (and its number of non-zeroes) for which the value
+    // offsets have been computed
+    const LinearAlgebraObject* _offsets_tensor;
+    std::size_t _offsets_nnz;
+
+  };
+
+}
+
+#endif
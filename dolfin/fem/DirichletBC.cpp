@@ -668,7 +668,7 @@ void DirichletBC::init_from_mesh_function(const MeshFunction<std::size_t>& sub_d
 
   // Make sure we have the facet - cell connectivity
   const std::size_t D = mesh.topology().dim();
-  mesh.init(D - 1, D);
+  mesh.init_transient(D - 1, D);
 
   // Build set of boundary facets
   dolfin_assert(_facets.empty());
@@ -757,7 +757,7 @@ void DirichletBC::compute_bc_topological(Map& boundary_values,
 
   // Initialise facet-cell connectivity
   mesh.init(D);
-  mesh.init(D - 1, D);
+  mesh.init_transient(D - 1, D);
 
   // Create UFC cell
   ufc::cell ufc_cell;
@@ -1409,7 +1409,7 @@ void DofMapBuilder::compute_shared_nodes(
   // Initialise mesh
   const std::size_t D = mesh.topology().dim();
   mesh.init(D - 1);
-  mesh.init(D - 1, D);
+  mesh.init_transient(D - 1, D);
 
   // Allocate data and initialise all facets to -1 (provisionally,
   // owned and not shared)
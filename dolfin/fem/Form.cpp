@@ -35,6 +35,7 @@
 #include <dolfin/mesh/Mesh.h>
 #include <dolfin/mesh/MeshData.h>
 #include <dolfin/mesh/MeshFunction.h>
+#include "VectorizedCellIntegral.h"
 #include "Form.h"
 
 using namespace dolfin;
@@ -345,6 +346,34 @@ void Form::set_vertex_domains
   dP = vertex_domains;
 }
 //-----------------------------------------------------------------------------
+void Form::set_vectorized_cell_integral
+(std::shared_ptr<const VectorizedCellIntegral> integral)
+{
+  _default_vectorized_cell_integral = integral;
+}
+//-----------------------------------------------------------------------------
+void Form::set_vectorized_cell_integral
+(std::size_t subdomain_id,
+ std::shared_ptr<const VectorizedCellIntegral> integral)
+{
+  _vectorized_cell_integrals[subdomain_id] = integral;
+}
+//-----------------------------------------------------------------------------
+std::shared_ptr<const VectorizedCellIntegral>
+Form::vectorized_cell_integral() const
+{
+  return _default_vectorized_cell_integral;
+}
+//-----------------------------------------------------------------------------
+std::shared_ptr<const VectorizedCellIntegral>
+Form::vectorized_cell_integral(std::size_t subdomain_id) const
+{
+  auto it = _vectorized_cell_integrals.find(subdomain_id);
+  if (it == _vectorized_cell_integrals.end())
+    return std::shared_ptr<const VectorizedCellIntegral>();
+  return it->second;
+}
+//-----------------------------------------------------------------------------
 std::shared_ptr<const ufc::form> Form::ufc_form() const
 {
   return _ufc_form;
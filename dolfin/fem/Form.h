@@ -45,6 +45,7 @@ namespace dolfin
   class GenericFunction;
   class Mesh;
   template <typename T> class MeshFunction;
+  class VectorizedCellIntegral;
 
   /// Base class for UFC code generated by FFC for DOLFIN with option -l.
 
@@ -304,6 +305,38 @@ namespace dolfin
     ///         The vertex domains.
     void set_vertex_domains(std::shared_ptr<const MeshFunction<std::size_t>> vertex_domains);
 
+    /// Set vectorised kernel for the default cell integral
+    ///
+    ///  @param[in]   integral (_VectorizedCellIntegral_)
+    ///         The kernel.
+    void set_vectorized_cell_integral(std::shared_ptr<const VectorizedCellIntegral> integral);
+
+    /// Set vectorised kernel for the cell integral over a subdomain
+    ///
+    ///  @param[in]   subdomain_id (std::size_t)
+    ///         The subdomain.
+    ///  @param[in]   integral (_VectorizedCellIntegral_)
+    ///         The kernel.
+    void set_vectorized_cell_integral(std::size_t subdomain_id,
+                                      std::shared_ptr<const VectorizedCellIntegral> integral);
+
+    /// Return vectorised kernel for the default cell integral (zero
+    /// pointer if no kernel has been set)
+    ///
+    /// @return     _VectorizedCellIntegral_
+    ///         The kernel.
+    std::shared_ptr<const VectorizedCellIntegral> vectorized_cell_integral() const;
+
+    /// Return vectorised kernel for the cell integral over a
+    /// subdomain (zero pointer if no kernel has been set)
+    ///
+    ///  @param[in]   subdomain_id (std::size_t)
+    ///         The subdomain.
+    /// @return     _VectorizedCellIntegral_
+    ///         The kernel.
+    std::shared_ptr<const VectorizedCellIntegral>
+      vectorized_cell_integral(std::size_t subdomain_id) const;
+
     /// Return UFC form shared pointer
     ///
     /// @return     ufc::form
@@ -342,6 +375,12 @@ namespace dolfin
     // The mesh (needed for functionals when we don't have any spaces)
     std::shared_ptr<const Mesh> _mesh;
 
+    // Vectorised cell integral kernels (default and by subdomain)
+    std::shared_ptr<const VectorizedCellIntegral>
+      _default_vectorized_cell_integral;
+    std::map<std::size_t, std::shared_ptr<const VectorizedCellIntegral>>
+      _vectorized_cell_integrals;
+
   private:
 
     const std::size_t _rank;
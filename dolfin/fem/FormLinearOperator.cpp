@@ -0,0 +1,324 @@
+// Copyright (C) 2026 agent
+//
+// This file is part of DOLFIN.
+//
+// DOLFIN is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// DOLFIN is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with DOLFIN. If not, see <http://www.gnu.org/licenses/>.
+
+#include <sstream>
+#include <dolfin/common/Timer.h>
+#include <dolfin/function/FunctionSpace.h>
+#include <dolfin/la/DefaultFactory.h>
+#include <dolfin/la/GenericVector.h>
+#include <dolfin/la/TensorLayout.h>
+#include <dolfin/log/log.h>
+#include <dolfin/mesh/Cell.h>
+#include <dolfin/mesh/Facet.h>
+#include <dolfin/mesh/Mesh.h>
+#include <dolfin/mesh/MeshFunction.h>
+#include "Form.h"
+#include "GenericDofMap.h"
+#include "UFC.h"
+#include "FormLinearOperator.h"
+
+using namespace dolfin;
+
+//-----------------------------------------------------------------------------
+FormLinearOperator::FormLinearOperator(std::shared_ptr<const Form> a)
+  : LinearOperator(*create_vector(*a, 1, false), *create_vector(*a, 0, false)),
+    cache_element_tensors(false), _a(a), _num_coordinate_dofs(0)
+{
+  // Check form
+  dolfin_assert(_a);
+  if (_a->rank() != 2)
+  {
+    dolfin_error("FormLinearOperator.cpp",
+                 "create matrix-free linear operator",
+                 "Expecting a bilinear form but rank is %d",
+                 _a->rank());
+  }
+
+  dolfin_assert(_a->ufc_form());
+  if (_a->ufc_form()->has_interior_facet_integrals()
+      || _a->ufc_form()->has_vertex_integrals())
+  {
+    dolfin_error("FormLinearOperator.cpp",
+                 "create matrix-free linear operator",
+                 "Only cell and exterior facet integrals are supported");
+  }
+
+  // Create work vectors
+  _x = create_vector(*_a, 1, true);
+  _y = create_vector(*_a, 0, false);
+
+  // Compute and cache cell data
+  init();
+}
+//-----------------------------------------------------------------------------
+FormLinearOperator::~FormLinearOperator()
+{
+  // Do nothing
+}
+//-----------------------------------------------------------------------------
+std::size_t FormLinearOperator::size(std::size_t dim) const
+{
+  dolfin_assert(dim < 2);
+  return _a->function_space(dim)->dim();
+}
+//-----------------------------------------------------------------------------
+void FormLinearOperator::mult(const GenericVector& x, GenericVector& y) const
+{
+  Timer timer("Apply matrix-free operator");
+
+  // Copy x to work vector and update ghost values
+  std::vector<double> values;
+  x.get_local(values);
+  _x->set_local(values);
+  _x->apply("insert");
+  _y->zero();
+
+  dolfin_assert(_a->mesh());
+  const Mesh& mesh = *_a->mesh();
+  const GenericDofMap& dofmap0 = *_a->function_space(0)->dofmap();
+  const GenericDofMap& dofmap1 = *_a->function_space(1)->dofmap();
+  const std::size_t tensor_size
+    = dofmap0.max_element_dofs()*dofmap1.max_element_dofs();
+  const bool has_coefficients = _a->ufc_form()->num_coefficients() > 0;
+
+  // Allocate element tensor cache if required
+  const bool use_cache = !_element_tensors.empty();
+  const bool fill_cache = cache_element_tensors && !use_cache;
+  if (fill_cache)
+    _element_tensors.resize((_cells.size() + _facets.size())*tensor_size);
+
+  // Compute y_T = A_T x_T for an element tensor and add to global y
+  std::vector<double> x_cell(dofmap1.max_element_dofs());
+  std::vector<double> y_cell(dofmap0.max_element_dofs());
+  auto apply_element = [&](const double* A_T, std::size_t cell_index)
+  {
+    auto dofs0 = dofmap0.cell_dofs(cell_index);
+    auto dofs1 = dofmap1.cell_dofs(cell_index);
+    const std::size_t m = dofs0.size();
+    const std::size_t n = dofs1.size();
+    _x->get_local(x_cell.data(), n, dofs1.data());
+    for (std::size_t i = 0; i < m; ++i)
+    {
+      double sum = 0.0;
+      for (std::size_t j = 0; j < n; ++j)
+        sum += A_T[i*n + j]*x_cell[j];
+      y_cell[i] = sum;
+    }
+    _y->add_local(y_cell.data(), m, dofs0.data());
+  };
+
+  // Cell contributions
+  ufc::cell ufc_cell;
+  for (std::size_t c = 0; c < _cells.size(); ++c)
+  {
+    const double* A_T = nullptr;
+    if (use_cache)
+      A_T = _element_tensors.data() + c*tensor_size;
+    else
+    {
+      const double* coordinate_dofs
+        = _cell_coordinate_dofs.data() + c*_num_coordinate_dofs;
+      ufc::cell_integral* integral = _cell_integrals[c];
+      if (has_coefficients)
+      {
+        const Cell cell(mesh, _cells[c]);
+        cell.get_cell_data(ufc_cell);
+        _ufc->update(cell, coordinate_dofs, ufc_cell,
+                     integral->enabled_coefficients(), _ufc->w());
+      }
+      integral->tabulate_tensor(_ufc->A.data(), _ufc->w(), coordinate_dofs,
+                                _cell_orientations[c]);
+      A_T = _ufc->A.data();
+
+      if (fill_cache)
+      {
+        std::copy(A_T, A_T + tensor_size,
+                  _element_tensors.begin() + c*tensor_size);
+      }
+    }
+
+    apply_element(A_T, _cells[c]);
+  }
+
+  // Exterior facet contributions
+  for (std::size_t f = 0; f < _facets.size(); ++f)
+  {
+    const std::size_t cell_index = _facets[f].first;
+    const std::size_t local_facet = _facets[f].second;
+    const std::size_t pos = _cells.size() + f;
+
+    const double* A_T = nullptr;
+    if (use_cache)
+      A_T = _element_tensors.data() + pos*tensor_size;
+    else
+    {
+      const double* coordinate_dofs
+        = _facet_coordinate_dofs.data() + f*_num_coordinate_dofs;
+      ufc::exterior_facet_integral* integral = _facet_integrals[f];
+      if (has_coefficients)
+      {
+        const Cell cell(mesh, cell_index);
+        cell.get_cell_data(ufc_cell, local_facet);
+        _ufc->update(cell, coordinate_dofs, ufc_cell,
+                     integral->enabled_coefficients(), _ufc->w());
+      }
+      integral->tabulate_tensor(_ufc->A.data(), _ufc->w(), coordinate_dofs,
+                                local_facet, _facet_orientations[f]);
+      A_T = _ufc->A.data();
+
+      if (fill_cache)
+      {
+        std::copy(A_T, A_T + tensor_size,
+                  _element_tensors.begin() + pos*tensor_size);
+      }
+    }
+
+    apply_element(A_T, cell_index);
+  }
+
+  // Accumulate off-process contributions and copy to y
+  _y->apply("add");
+  _y->get_local(values);
+  y.set_local(values);
+  y.apply("insert");
+}
+//-----------------------------------------------------------------------------
+void FormLinearOperator::update()
+{
+  _element_tensors.clear();
+}
+//-----------------------------------------------------------------------------
+std::string FormLinearOperator::str(bool verbose) const
+{
+  std::stringstream s;
+  s << "<FormLinearOperator of size " << size(0) << " x " << size(1) << ">";
+  return s.str();
+}
+//-----------------------------------------------------------------------------
+std::shared_ptr<GenericVector>
+FormLinearOperator::create_vector(const Form& a, std::size_t i, bool ghosted)
+{
+  dolfin_assert(a.function_space(i));
+  dolfin_assert(a.function_space(i)->dofmap());
+  dolfin_assert(a.mesh());
+  const MPI_Comm comm = a.mesh()->mpi_comm();
+
+  // Create layout from index map of function space
+  DefaultFactory factory;
+  std::shared_ptr<TensorLayout> tensor_layout
+    = factory.create_layout(comm, 1);
+  dolfin_assert(tensor_layout);
+  tensor_layout->init({a.function_space(i)->dofmap()->index_map()},
+                      ghosted ? TensorLayout::Ghosts::GHOSTED
+                      : TensorLayout::Ghosts::UNGHOSTED);
+
+  // Create vector
+  std::shared_ptr<GenericVector> x = factory.create_vector(comm);
+  dolfin_assert(x);
+  x->init(*tensor_layout);
+  x->zero();
+
+  return x;
+}
+//-----------------------------------------------------------------------------
+void FormLinearOperator::init()
+{
+  dolfin_assert(_a->mesh());
+  const Mesh& mesh = *_a->mesh();
+  const std::size_t D = mesh.topology().dim();
+
+  // Create data structure for local assembly data
+  _ufc.reset(new UFC(*_a));
+
+  std::vector<double> coordinate_dofs;
+  ufc::cell ufc_cell;
+
+  // Cache cell data
+  if (_ufc->form.has_cell_integrals())
+  {
+    std::shared_ptr<const MeshFunction<std::size_t>> domains
+      = _a->cell_domains();
+    const bool use_domains = domains && !domains->empty();
+    ufc::cell_integral* integral = _ufc->default_cell_integral.get();
+    for (CellIterator cell(mesh); !cell.end(); ++cell)
+    {
+      // Get integral for sub domain (if any)
+      if (use_domains)
+        integral = _ufc->get_cell_integral((*domains)[*cell]);
+
+      // Skip if no integral on current domain
+      if (!integral)
+        continue;
+
+      cell->get_cell_data(ufc_cell);
+      cell->get_coordinate_dofs(coordinate_dofs);
+      _num_coordinate_dofs = coordinate_dofs.size();
+
+      _cells.push_back(cell->index());
+      _cell_integrals.push_back(integral);
+      _cell_orientations.push_back(ufc_cell.orientation);
+      _cell_coordinate_dofs.insert(_cell_coordinate_dofs.end(),
+                                   coordinate_dofs.begin(),
+                                   coordinate_dofs.end());
+    }
+  }
+
+  // Cache exterior facet data
+  if (_ufc->form.has_exterior_facet_integrals())
+  {
+    mesh.init(D - 1);
+    mesh.init(D - 1, D);
+
+    std::shared_ptr<const MeshFunction<std::size_t>> domains
+      = _a->exterior_facet_domains();
+    const bool use_domains = domains && !domains->empty();
+    ufc::exterior_facet_integral* integral
+      = _ufc->default_exterior_facet_integral.get();
+    for (FacetIterator facet(mesh); !facet.end(); ++facet)
+    {
+      // Only consider exterior facets
+      if (!facet->exterior())
+        continue;
+
+      // Get integral for sub domain (if any)
+      if (use_domains)
+        integral = _ufc->get_exterior_facet_integral((*domains)[*facet]);
+
+      // Skip if no integral on current domain
+      if (!integral)
+        continue;
+
+      // Get cell to which facet belongs
+      dolfin_assert(facet->num_entities(D) == 1);
+      const Cell cell(mesh, facet->entities(D)[0]);
+      dolfin_assert(!cell.is_ghost());
+      const std::size_t local_facet = cell.index(*facet);
+
+      cell.get_cell_data(ufc_cell, local_facet);
+      cell.get_coordinate_dofs(coordinate_dofs);
+      _num_coordinate_dofs = coordinate_dofs.size();
+
+      _facets.push_back({cell.index(), local_facet});
+      _facet_integrals.push_back(integral);
+      _facet_orientations.push_back(ufc_cell.orientation);
+      _facet_coordinate_dofs.insert(_facet_coordinate_dofs.end(),
+                                    coordinate_dofs.begin(),
+                                    coordinate_dofs.end());
+    }
+  }
+}
+//-----------------------------------------------------------------------------
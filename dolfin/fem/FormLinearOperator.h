@@ -0,0 +1,133 @@
+// Copyright (C) 2026 agent
+//
+// This file is part of DOLFIN.
+//
+// DOLFIN is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// DOLFIN is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with DOLFIN. If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef __FORM_LINEAR_OPERATOR_H
+#define __FORM_LINEAR_OPERATOR_H
+
+#include <memory>
+#include <string>
+#include <vector>
+#include <dolfin/la/LinearOperator.h>
+
+namespace ufc
+{
+  class cell_integral;
+  class exterior_facet_integral;
+}
+
+namespace dolfin
+{
+
+  // Forward declarations
+  class Form;
+  class GenericVector;
+  class UFC;
+
+  /// This class defines a matrix-free linear operator from a bilinear
+  /// form. The action y = Ax is computed by tabulating the cell (and
+  /// exterior facet) tensors on the fly and applying them to the
+  /// restriction of x to each cell, without assembling a global
+  /// sparse matrix. The operator can be passed to Krylov solvers that
+  /// accept a _LinearOperator_, e.g. _PETScKrylovSolver_.
+  ///
+  /// The cell geometry, orientation and integral for each cell are
+  /// computed once and cached. Element tensors may optionally be
+  /// cached as well (see cache_element_tensors), in which case
+  /// repeated products do not call the form kernels at all. The
+  /// element tensor cache must be cleared by calling update() if
+  /// coefficients of the form change.
+  ///
+  /// Only cell and exterior facet integrals are supported.
+
+  class FormLinearOperator : public LinearOperator
+  {
+  public:
+
+    /// Create linear operator from bilinear form
+    ///
+    /// @param[in] a (Form)
+    ///         The bilinear form.
+    explicit FormLinearOperator(std::shared_ptr<const Form> a);
+
+    /// Destructor
+    ~FormLinearOperator();
+
+    /// Return size of given dimension
+    std::size_t size(std::size_t dim) const;
+
+    /// Compute matrix-vector product y = Ax
+    void mult(const GenericVector& x, GenericVector& y) const;
+
+    /// Clear cached element tensors. Must be called when the
+    /// coefficients of the form have changed and
+    /// cache_element_tensors is true.
+    void update();
+
+    /// Return informal string representation (pretty-print)
+    std::string str(bool verbose) const;
+
+    /// cache_element_tensors (bool)
+    ///     Default value is false.
+    ///     If true, element tensors are stored after the first
+    ///     product and reused by subsequent products.
+    bool cache_element_tensors;
+
+  private:
+
+    // Create vector with parallel layout of the function space for
+    // dimension i of the form
+    static std::shared_ptr<GenericVector>
+      create_vector(const Form& a, std::size_t i, bool ghosted);
+
+    // Compute and cache cell data
+    void init();
+
+    // The bilinear form
+    std::shared_ptr<const Form> _a;
+
+    // Local assembly data
+    std::unique_ptr<UFC> _ufc;
+
+    // Cells and exterior facets (cell index, local facet index) with
+    // a non-zero integral
+    std::vector<std::size_t> _cells;
+    std::vector<std::pair<std::size_t, std::size_t>> _facets;
+
+    // Integrals for each cell and exterior facet
+    std::vector<ufc::cell_integral*> _cell_integrals;
+    std::vector<ufc::exterior_facet_integral*> _facet_integrals;
+
+    // Cached coordinate dofs and orientation for each cell and
+    // exterior facet (flattened)
+    std::vector<double> _cell_coordinate_dofs;
+    std::vector<double> _facet_coordinate_dofs;
+    std::vector<int> _cell_orientations;
+    std::vector<int> _facet_orientations;
+    std::size_t _num_coordinate_dofs;
+
+    // Cached element tensors (cells first, then exterior facets)
+    mutable std::vector<double> _element_tensors;
+
+    // Work vectors with ghost entries for x and y
+    std::shared_ptr<GenericVector> _x;
+    std::shared_ptr<GenericVector> _y;
+
+  };
+
+}
+
+#endif
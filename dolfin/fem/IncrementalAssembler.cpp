@@ -0,0 +1,231 @@
+// Copyright (C) 2026 agent
+//
+// This file is part of DOLFIN.
+//
+// DOLFIN is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// DOLFIN is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with DOLFIN. If not, see <http://www.gnu.org/licenses/>.
+
+#include <algorithm>
+#include <dolfin/common/ArrayView.h>
+#include <dolfin/common/Timer.h>
+#include <dolfin/function/FunctionSpace.h>
+#include <dolfin/la/GenericTensor.h>
+#include <dolfin/log/log.h>
+#include <dolfin/mesh/Cell.h>
+#include <dolfin/mesh/Mesh.h>
+#include <dolfin/mesh/MeshFunction.h>
+#include "Assembler.h"
+#include "Form.h"
+#include "GenericDofMap.h"
+#include "UFC.h"
+#include "IncrementalAssembler.h"
+
+using namespace dolfin;
+
+//-----------------------------------------------------------------------------
+IncrementalAssembler::IncrementalAssembler(std::shared_ptr<const Form> a)
+  : _a(a)
+{
+  // Check form
+  dolfin_assert(_a);
+  AssemblerBase::check(*_a);
+
+  // Create data structure for local assembly data
+  _ufc.reset(new UFC(*_a));
+}
+//-----------------------------------------------------------------------------
+IncrementalAssembler::~IncrementalAssembler()
+{
+  // Do nothing
+}
+//-----------------------------------------------------------------------------
+void IncrementalAssembler::assemble(GenericTensor& A)
+{
+  Timer timer("Assemble (incremental)");
+
+  // Initialise global tensor if empty, otherwise only zero
+  if (A.empty())
+    init_global_tensor(A, *_a);
+  else if (!add_values)
+    A.zero();
+
+  dolfin_assert(_a->mesh());
+  const Mesh& mesh = *_a->mesh();
+  const std::size_t form_rank = _a->rank();
+
+  // Assemble over cells and store cell tensors
+  _cell_tensors.clear();
+  _cell_tensor_offsets.assign(mesh.num_cells() + 1, 0);
+  std::vector<ArrayView<const dolfin::la_index>> dofs(form_rank);
+  if (_ufc->form.has_cell_integrals())
+  {
+    for (CellIterator cell(mesh); !cell.end(); ++cell)
+    {
+      const std::size_t c = cell->index();
+      if (tabulate_tensor(c))
+      {
+        // Add to global tensor
+        std::size_t size = 1;
+        for (std::size_t i = 0; i < form_rank; ++i)
+        {
+          auto dmap = _a->function_space(i)->dofmap()->cell_dofs(c);
+          dofs[i].set(dmap.size(), dmap.data());
+          size *= dmap.size();
+        }
+        A.add_local(_ufc->A.data(), dofs);
+
+        // Store cell tensor
+        _cell_tensors.insert(_cell_tensors.end(), _ufc->A.begin(),
+                             _ufc->A.begin() + size);
+      }
+      _cell_tensor_offsets[c + 1] = _cell_tensors.size();
+    }
+  }
+
+  // Fill offsets of trailing (ghost) cells
+  for (std::size_t c = 1; c < _cell_tensor_offsets.size(); ++c)
+  {
+    _cell_tensor_offsets[c] = std::max(_cell_tensor_offsets[c],
+                                       _cell_tensor_offsets[c - 1]);
+  }
+
+  // Assemble facet and vertex integrals
+  Assembler assembler;
+  assembler.assemble_exterior_facets(A, *_a, *_ufc,
+                                     _a->exterior_facet_domains(), NULL);
+  assembler.assemble_interior_facets(A, *_a, *_ufc,
+                                     _a->interior_facet_domains(),
+                                     _a->cell_domains(), NULL);
+  assembler.assemble_vertices(A, *_a, *_ufc, _a->vertex_domains());
+
+  // Finalize assembly of global tensor
+  if (finalize_tensor)
+    A.apply("add");
+}
+//-----------------------------------------------------------------------------
+void IncrementalAssembler::update(GenericTensor& A,
+                                  const MeshFunction<bool>& dirty_cells)
+{
+  dolfin_assert(_a->mesh());
+  if (dirty_cells.dim() != _a->mesh()->topology().dim())
+  {
+    dolfin_error("IncrementalAssembler.cpp",
+                 "update tensor",
+                 "Mesh function for dirty cells has dimension %d",
+                 (int) dirty_cells.dim());
+  }
+
+  // Collect marked (owned) cells
+  std::vector<std::size_t> cells;
+  for (CellIterator cell(*_a->mesh()); !cell.end(); ++cell)
+  {
+    if (dirty_cells[*cell])
+      cells.push_back(cell->index());
+  }
+
+  update(A, cells);
+}
+//-----------------------------------------------------------------------------
+void IncrementalAssembler::update(GenericTensor& A,
+                                  const std::vector<std::size_t>& dirty_cells)
+{
+  Timer timer("Update (incremental)");
+
+  dolfin_assert(_a->mesh());
+  const Mesh& mesh = *_a->mesh();
+  const std::size_t form_rank = _a->rank();
+
+  // Check that cell tensors have been stored
+  if (_cell_tensor_offsets.size() != mesh.num_cells() + 1)
+  {
+    dolfin_error("IncrementalAssembler.cpp",
+                 "update tensor",
+                 "Tensor has not been assembled with this object");
+  }
+
+  // Add difference between new and stored cell tensors
+  std::vector<double> dA;
+  std::vector<ArrayView<const dolfin::la_index>> dofs(form_rank);
+  for (auto c : dirty_cells)
+  {
+    if (c >= mesh.num_cells() || Cell(mesh, c).is_ghost())
+    {
+      dolfin_error("IncrementalAssembler.cpp",
+                   "update tensor",
+                   "Cell %d is not an owned cell", (int) c);
+    }
+
+    // Skip cells without an integral
+    const std::size_t offset = _cell_tensor_offsets[c];
+    const std::size_t size = _cell_tensor_offsets[c + 1] - offset;
+    if (size == 0)
+      continue;
+
+    // Tabulate new cell tensor
+    if (!tabulate_tensor(c))
+      continue;
+
+    // Compute difference and store new tensor
+    double* A_cell = _cell_tensors.data() + offset;
+    dA.resize(size);
+    for (std::size_t k = 0; k < size; ++k)
+    {
+      dA[k] = _ufc->A[k] - A_cell[k];
+      A_cell[k] = _ufc->A[k];
+    }
+
+    // Add difference to global tensor
+    for (std::size_t i = 0; i < form_rank; ++i)
+    {
+      auto dmap = _a->function_space(i)->dofmap()->cell_dofs(c);
+      dofs[i].set(dmap.size(), dmap.data());
+    }
+    A.add_local(dA.data(), dofs);
+  }
+
+  // Finalize assembly of global tensor
+  if (finalize_tensor)
+    A.apply("add");
+}
+//-----------------------------------------------------------------------------
+bool IncrementalAssembler::tabulate_tensor(std::size_t cell_index)
+{
+  const Mesh& mesh = *_a->mesh();
+  const Cell cell(mesh, cell_index);
+
+  // Get integral for sub domain (if any)
+  std::shared_ptr<const MeshFunction<std::size_t>> domains
+    = _a->cell_domains();
+  ufc::cell_integral* integral = _ufc->default_cell_integral.get();
+  if (domains && !domains->empty())
+    integral = _ufc->get_cell_integral((*domains)[cell]);
+
+  // Skip if no integral on current domain
+  if (!integral)
+    return false;
+
+  // Update to current cell
+  ufc::cell ufc_cell;
+  std::vector<double> coordinate_dofs;
+  cell.get_cell_data(ufc_cell);
+  cell.get_coordinate_dofs(coordinate_dofs);
+  _ufc->update(cell, coordinate_dofs, ufc_cell,
+               integral->enabled_coefficients());
+
+  // Tabulate cell tensor
+  integral->tabulate_tensor(_ufc->A.data(), _ufc->w(),
+                            coordinate_dofs.data(),
+                            ufc_cell.orientation);
+  return true;
+}
+//-----------------------------------------------------------------------------
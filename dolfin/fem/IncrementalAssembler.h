@@ -0,0 +1,112 @@
+// Copyright (C) 2026 agent
+//
+// This file is part of DOLFIN.
+//
+// DOLFIN is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// DOLFIN is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with DOLFIN. If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef __INCREMENTAL_ASSEMBLER_H
+#define __INCREMENTAL_ASSEMBLER_H
+
+#include <memory>
+#include <vector>
+#include "AssemblerBase.h"
+
+namespace dolfin
+{
+
+  // Forward declarations
+  class GenericTensor;
+  class Form;
+  class UFC;
+  template<typename T> class MeshFunction;
+
+  /// This class provides incremental re-assembly of a form when the
+  /// coefficients change on a small number of cells only. The cell
+  /// tensors computed by assemble() are stored for each cell. A
+  /// subsequent call to update() re-tabulates the cell tensors of
+  /// the given (dirty) cells only and adds the difference between
+  /// the new and the stored tensors to the global tensor, so the
+  /// cost is proportional to the number of dirty cells.
+  ///
+  /// Only cell integrals are updated incrementally. Exterior facet,
+  /// interior facet and vertex integrals are assembled by
+  /// assemble() and are not changed by update(). The global tensor
+  /// passed to update() must be the tensor last assembled by this
+  /// object, and must not have been modified in between. The mesh,
+  /// the dof maps and the cell subdomain markers must not change.
+
+  class IncrementalAssembler : public AssemblerBase
+  {
+  public:
+
+    /// Create incremental assembler for form
+    ///
+    /// @param[in] a (Form)
+    ///         The form to assemble.
+    explicit IncrementalAssembler(std::shared_ptr<const Form> a);
+
+    /// Destructor
+    ~IncrementalAssembler();
+
+    /// Assemble tensor and store the cell tensors. The tensor is
+    /// initialised if it is empty.
+    ///
+    /// @param[out] A (GenericTensor)
+    ///         The tensor to assemble.
+    void assemble(GenericTensor& A);
+
+    /// Update tensor for changes on the marked cells
+    ///
+    /// @param[in,out] A (GenericTensor)
+    ///         The tensor previously assembled by assemble().
+    /// @param[in] dirty_cells (MeshFunction<bool>)
+    ///         Cells on which the form has changed.
+    void update(GenericTensor& A, const MeshFunction<bool>& dirty_cells);
+
+    /// Update tensor for changes on the given cells
+    ///
+    /// @param[in,out] A (GenericTensor)
+    ///         The tensor previously assembled by assemble().
+    /// @param[in] dirty_cells (std::vector<std::size_t>)
+    ///         Local indices of the (owned) cells on which the form
+    ///         has changed.
+    void update(GenericTensor& A,
+                const std::vector<std::size_t>& dirty_cells);
+
+    /// Return number of stored cell tensor entries
+    std::size_t num_stored_entries() const
+    { return _cell_tensors.size(); }
+
+  private:
+
+    // Tabulate cell tensor, returning false if there is no integral
+    // on the cell
+    bool tabulate_tensor(std::size_t cell_index);
+
+    // The form
+    std::shared_ptr<const Form> _a;
+
+    // Local assembly data
+    std::unique_ptr<UFC> _ufc;
+
+    // Stored cell tensors (flattened) and offset of the tensor for
+    // each cell (the tensor is empty for cells without an integral)
+    std::vector<double> _cell_tensors;
+    std::vector<std::size_t> _cell_tensor_offsets;
+
+  };
+
+}
+
+#endif
@@ -0,0 +1,258 @@
+// Copyright (C) 2026 agent
+//
+// This file is part of DOLFIN.
+//
+// DOLFIN is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// DOLFIN is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with DOLFIN. If not, see <http://www.gnu.org/licenses/>.
+
+#ifdef HAS_OPENMP
+#include <omp.h>
+#endif
+
+#include <numeric>
+#include <dolfin/log/log.h>
+#include <dolfin/log/Progress.h>
+#include <dolfin/common/ArrayView.h>
+#include <dolfin/common/Timer.h>
+#include <dolfin/common/utils.h>
+#include <dolfin/parameter/GlobalParameters.h>
+#include <dolfin/la/EigenMatrix.h>
+#include <dolfin/la/EigenVector.h>
+#include <dolfin/la/GenericTensor.h>
+#include <dolfin/mesh/Mesh.h>
+#include <dolfin/mesh/MeshTopology.h>
+#include <dolfin/mesh/Cell.h>
+#include <dolfin/mesh/MeshFunction.h>
+#include <dolfin/mesh/MeshColoring.h>
+#include <dolfin/function/FunctionSpace.h>
+#include "GenericDofMap.h"
+#include "Form.h"
+#include "UFC.h"
+#include "Assembler.h"
+#include "OpenMpAssembler.h"
+
+using namespace dolfin;
+
+namespace
+{
+  // Index of calling thread (0 if not running in a parallel region)
+  std::size_t thread_num()
+  {
+    #ifdef HAS_OPENMP
+    return omp_get_thread_num();
+    #else
+    return 0;
+    #endif
+  }
+}
+
+//-----------------------------------------------------------------------------
+void OpenMpAssembler::assemble(GenericTensor& A, const Form& a)
+{
+  // Get integration domains
+  std::shared_ptr<const MeshFunction<std::size_t>>
+    cell_domains = a.cell_domains();
+  std::shared_ptr<const MeshFunction<std::size_t>> exterior_facet_domains
+      = a.exterior_facet_domains();
+  std::shared_ptr<const MeshFunction<std::size_t>> interior_facet_domains
+      = a.interior_facet_domains();
+  std::shared_ptr<const MeshFunction<std::size_t>> vertex_domains
+    = a.vertex_domains();
+
+  // Check form
+  AssemblerBase::check(a);
+
+  // Create data structure for local assembly data (each thread
+  // creates its own copy)
+  UFC ufc(a);
+
+  // Initialize global tensor
+  init_global_tensor(A, a);
+
+  // Assemble over cells (multithreaded)
+  assemble_cells(A, a, ufc, cell_domains, NULL);
+
+  // Assemble remaining integrals serially
+  Assembler assembler;
+  assembler.assemble_exterior_facets(A, a, ufc, exterior_facet_domains,
+                                     NULL);
+  assembler.assemble_interior_facets(A, a, ufc, interior_facet_domains,
+                                     cell_domains, NULL);
+  assembler.assemble_vertices(A, a, ufc, vertex_domains);
+
+  // Finalize assembly of global tensor
+  if (finalize_tensor)
+    A.apply("add");
+}
+//-----------------------------------------------------------------------------
+void OpenMpAssembler::assemble_cells(
+  GenericTensor& A,
+  const Form& a,
+  UFC& ufc,
+  std::shared_ptr<const MeshFunction<std::size_t>> domains,
+  std::vector<double>* values)
+{
+  // Skip assembly if there are no cell integrals
+  if (!ufc.form.has_cell_integrals())
+    return;
+
+  // Set timer
+  Timer timer("Assemble cells (threaded)");
+
+  // Extract mesh
+  dolfin_assert(a.mesh());
+  const Mesh& mesh = *(a.mesh());
+
+  // Form rank
+  const std::size_t form_rank = ufc.form.rank();
+
+  // Check if form is a functional
+  const bool is_cell_functional = (values && form_rank == 0) ? true : false;
+
+  // Collect pointers to dof maps
+  std::vector<const GenericDofMap*> dofmaps;
+  for (std::size_t i = 0; i < form_rank; ++i)
+    dofmaps.push_back(a.function_space(i)->dofmap().get());
+
+  // Check whether integral is domain-dependent
+  const bool use_domains = domains && !domains->empty();
+
+  // Get cells of each colour
+  const std::vector<std::vector<std::size_t>>& colored_cells
+    = cells_of_color(mesh);
+
+  // Number of threads and whether the tensor backend tolerates
+  // concurrent insertion into disjoint entries
+  const std::size_t nthreads = num_threads();
+  const bool concurrent_insertion = supports_concurrent_insertion(A);
+
+  // When assembling a scalar, each thread accumulates its own sum
+  std::vector<double> scalars(nthreads, 0.0);
+
+  // Assemble over cells, one colour at a time. The parallel region
+  // spans all colours so that each thread creates its UFC data once;
+  // the implicit barrier at the end of each work-sharing loop keeps
+  // the colours apart.
+  Progress p(AssemblerBase::progress_message(A.rank(), "cells (threaded)"),
+             colored_cells.size());
+  #pragma omp parallel num_threads(nthreads)
+  {
+    // Thread-local assembly data
+    UFC _ufc(ufc);
+    ufc::cell ufc_cell;
+    std::vector<double> coordinate_dofs;
+    std::vector<ArrayView<const dolfin::la_index>> dofs(form_rank);
+    ufc::cell_integral* integral = _ufc.default_cell_integral.get();
+
+    for (std::size_t color = 0; color < colored_cells.size(); ++color)
+    {
+      // Cells of current colour
+      const std::vector<std::size_t>& cells = colored_cells[color];
+      const std::int64_t num_cells_of_color = cells.size();
+
+      #pragma omp for schedule(guided, 20)
+      for (std::int64_t c = 0; c < num_cells_of_color; ++c)
+      {
+        const Cell cell(mesh, cells[c]);
+
+        // Skip ghost cells (the colouring covers all cells)
+        if (cell.is_ghost())
+          continue;
+
+        // Get integral for sub domain (if any)
+        if (use_domains)
+          integral = _ufc.get_cell_integral((*domains)[cell]);
+
+        // Skip if no integral on current domain
+        if (!integral)
+          continue;
+
+        // Update to current cell (UFC restricts coefficients that are
+        // not thread-safe one thread at a time)
+        cell.get_cell_data(ufc_cell);
+        cell.get_coordinate_dofs(coordinate_dofs);
+        _ufc.update(cell, coordinate_dofs, ufc_cell,
+                    integral->enabled_coefficients());
+
+        // Get local-to-global dof maps for cell
+        bool empty_dofmap = false;
+        for (std::size_t i = 0; i < form_rank; ++i)
+        {
+          auto dmap = dofmaps[i]->cell_dofs(cell.index());
+          dofs[i].set(dmap.size(), dmap.data());
+          empty_dofmap = empty_dofmap || dofs[i].size() == 0;
+        }
+
+        // Skip if at least one dofmap is empty
+        if (empty_dofmap)
+          continue;
+
+        // Tabulate cell tensor
+        integral->tabulate_tensor(_ufc.A.data(), _ufc.w(),
+                                  coordinate_dofs.data(),
+                                  ufc_cell.orientation);
+
+        // Add entries to global tensor. Cells of the same colour
+        // share no dofs, so insertion is conflict-free for backends
+        // that support concurrent insertion.
+        if (is_cell_functional)
+          (*values)[cell.index()] = _ufc.A[0];
+        else if (form_rank == 0)
+          scalars[thread_num()] += _ufc.A[0];
+        else if (concurrent_insertion)
+          A.add_local(_ufc.A.data(), dofs);
+        else
+        {
+          #pragma omp critical (dolfin_openmp_assembler_insert)
+          A.add_local(_ufc.A.data(), dofs);
+        }
+      }
+
+      #pragma omp master
+      p++;
+    }
+  }
+
+  // Sum the contributions from each thread when assembling a scalar
+  if (form_rank == 0 && !is_cell_functional)
+  {
+    const double scalar_sum = std::accumulate(scalars.begin(), scalars.end(),
+                                              0.0);
+    std::vector<ArrayView<const dolfin::la_index>> dofs;
+    A.add_local(&scalar_sum, dofs);
+  }
+}
+//-----------------------------------------------------------------------------
+bool OpenMpAssembler::supports_concurrent_insertion(const GenericTensor& A)
+{
+  // The Eigen backends store the sparsity pattern up front and write
+  // directly into existing entries. Other backends (e.g. PETSc)
+  // maintain internal insertion state and are not thread-safe.
+  return has_type<EigenMatrix>(A) || has_type<EigenVector>(A);
+}
+//-----------------------------------------------------------------------------
+const std::vector<std::vector<std::size_t>>&
+OpenMpAssembler::cells_of_color(const Mesh& mesh) const
+{
+  // Colour cells (does nothing if the colouring has already been
+  // computed)
+  const std::size_t D = mesh.topology().dim();
+  const std::vector<std::size_t> _coloring_type
+    = {D, MeshColoring::type_to_dim(coloring_type, mesh), D};
+  mesh.color(_coloring_type);
+
+  auto coloring_data = mesh.topology().coloring.find(_coloring_type);
+  dolfin_assert(coloring_data != mesh.topology().coloring.end());
+  return coloring_data->second.second;
+}
+//-----------------------------------------------------------------------------
@@ -0,0 +1,103 @@
+// Copyright (C) 2026 agent
+//
+// This file is part of DOLFIN.
+//
+// DOLFIN is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// DOLFIN is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with DOLFIN. If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef __OPENMP_ASSEMBLER_H
+#define __OPENMP_ASSEMBLER_H
+
+#include <memory>
+#include <string>
+#include <vector>
+#include "AssemblerBase.h"
+
+namespace dolfin
+{
+
+  // Forward declarations
+  class GenericTensor;
+  class Form;
+  class Mesh;
+  class UFC;
+  template<typename T> class MeshFunction;
+
+  /// This class provides multithreaded (OpenMP) assembly of a sparse
+  /// tensor from a given variational form. Cells are coloured such
+  /// that no two cells of the same colour share a vertex. Cells of
+  /// one colour are then assembled concurrently, each thread holding
+  /// its own UFC data, and the element tensors are inserted into the
+  /// global tensor without write conflicts. Colours are processed one
+  /// after the other.
+  ///
+  /// Exterior facet, interior facet and vertex integrals are
+  /// assembled serially.
+  ///
+  /// The number of threads is controlled by the global parameter
+  /// "num_threads". If DOLFIN has not been compiled with OpenMP, the
+  /// assembly is performed serially (in colour order).
+
+  class OpenMpAssembler : public AssemblerBase
+  {
+  public:
+
+    /// Constructor
+    OpenMpAssembler() : coloring_type("vertex") {}
+
+    /// Assemble tensor from given form
+    ///
+    /// @param[out] A (GenericTensor)
+    ///         The tensor to assemble.
+    /// @param[in]  a (Form&)
+    ///         The form to assemble the tensor from.
+    void assemble(GenericTensor& A, const Form& a);
+
+    /// Assemble tensor from given form over cells using multiple
+    /// threads.
+    ///
+    /// @param[out] A (GenericTensor&)
+    ///         The tensor to assemble.
+    /// @param[in] a (Form&)
+    ///         The form to assemble the tensor from.
+    /// @param[in] ufc (UFC&)
+    /// @param[in] domains (MeshFunction<std::size_t>)
+    /// @param[in] values (std::vector<double>*)
+    void assemble_cells(GenericTensor& A, const Form& a, UFC& ufc,
+                        std::shared_ptr<const MeshFunction<std::size_t>> domains,
+                        std::vector<double>* values);
+
+    /// coloring_type (std::string)
+    ///     Default value is "vertex".
+    ///     The cell colouring used to partition cells into
+    ///     conflict-free sets. Must be "vertex" unless all dofs are
+    ///     associated with entities of dimension >= the colouring
+    ///     dimension.
+    std::string coloring_type;
+
+    /// Return true if the global tensor supports concurrent
+    /// insertion of non-overlapping blocks
+    static bool supports_concurrent_insertion(const GenericTensor& A);
+
+  private:
+
+    // Return cells of each colour, computing the colouring if
+    // necessary
+    const std::vector<std::vector<std::size_t>>&
+      cells_of_color(const Mesh& mesh) const;
+
+  };
+
+}
+
+#endif
@@ -0,0 +1,530 @@
+// Copyright (C) 2026 agent
+//
+// This file is part of DOLFIN.
+//
+// DOLFIN is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// DOLFIN is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with DOLFIN. If not, see <http://www.gnu.org/licenses/>.
+
+#include <algorithm>
+#include <cmath>
+#include <sstream>
+#include <dolfin/common/Timer.h>
+#include <dolfin/function/FunctionSpace.h>
+#include <dolfin/geometry/Point.h>
+#include <dolfin/geometry/SimplexQuadrature.h>
+#include <dolfin/la/DefaultFactory.h>
+#include <dolfin/la/GenericVector.h>
+#include <dolfin/la/TensorLayout.h>
+#include <dolfin/log/log.h>
+#include <dolfin/mesh/Cell.h>
+#include <dolfin/mesh/CellType.h>
+#include <dolfin/mesh/Mesh.h>
+#include "FiniteElement.h"
+#include "GenericDofMap.h"
+#include "SumFactorizedOperator.h"
+
+using namespace dolfin;
+
+namespace
+{
+  // Tabulate the 1D Lagrange basis functions on the given nodes and
+  // their derivatives at the point t
+  void tabulate_lagrange_basis(const std::vector<double>& nodes, double t,
+                               double* values, double* derivatives)
+  {
+    const std::size_t n = nodes.size();
+    for (std::size_t i = 0; i < n; ++i)
+    {
+      double value = 1.0;
+      double derivative = 0.0;
+      for (std::size_t m = 0; m < n; ++m)
+      {
+        if (m == i)
+          continue;
+
+        // Product rule: d/dt (value*(t - z_m)/(z_i - z_m))
+        const double scale = 1.0/(nodes[i] - nodes[m]);
+        derivative = derivative*(t - nodes[m])*scale + value*scale;
+        value *= (t - nodes[m])*scale;
+      }
+      values[i] = value;
+      derivatives[i] = derivative;
+    }
+  }
+
+  // Apply the rows x cols matrix M (or its transpose) along the
+  // middle index of the array 'in' with shape (outer, cols, inner)
+  // (or (outer, rows, inner) for the transpose)
+  void contract(const double* M, std::size_t rows, std::size_t cols,
+                bool transpose, const double* in, double* out,
+                std::size_t outer, std::size_t inner)
+  {
+    const std::size_t m = transpose ? cols : rows;
+    const std::size_t n = transpose ? rows : cols;
+    std::fill(out, out + outer*m*inner, 0.0);
+    for (std::size_t o = 0; o < outer; ++o)
+    {
+      for (std::size_t i = 0; i < m; ++i)
+      {
+        double* _out = out + (o*m + i)*inner;
+        for (std::size_t j = 0; j < n; ++j)
+        {
+          const double a = transpose ? M[j*cols + i] : M[i*cols + j];
+          const double* _in = in + (o*n + j)*inner;
+          for (std::size_t k = 0; k < inner; ++k)
+            _out[k] += a*_in[k];
+        }
+      }
+    }
+  }
+
+  // Compute the inverse and determinant of the d x d matrix J
+  double invert(const double* J, double* K, std::size_t d)
+  {
+    if (d == 2)
+    {
+      const double det = J[0]*J[3] - J[1]*J[2];
+      K[0] = J[3]/det;
+      K[1] = -J[1]/det;
+      K[2] = -J[2]/det;
+      K[3] = J[0]/det;
+      return det;
+    }
+
+    dolfin_assert(d == 3);
+    K[0] = J[4]*J[8] - J[5]*J[7];
+    K[1] = J[2]*J[7] - J[1]*J[8];
+    K[2] = J[1]*J[5] - J[2]*J[4];
+    K[3] = J[5]*J[6] - J[3]*J[8];
+    K[4] = J[0]*J[8] - J[2]*J[6];
+    K[5] = J[2]*J[3] - J[0]*J[5];
+    K[6] = J[3]*J[7] - J[4]*J[6];
+    K[7] = J[1]*J[6] - J[0]*J[7];
+    K[8] = J[0]*J[4] - J[1]*J[3];
+    const double det = J[0]*K[0] + J[1]*K[3] + J[2]*K[6];
+    for (std::size_t i = 0; i < 9; ++i)
+      K[i] /= det;
+    return det;
+  }
+}
+
+//-----------------------------------------------------------------------------
+SumFactorizedOperator::SumFactorizedOperator(
+  std::shared_ptr<const FunctionSpace> V,
+  double mass_coefficient,
+  double stiffness_coefficient)
+  : LinearOperator(*create_vector(*V, false), *create_vector(*V, false)),
+    _V(V), _mass_coefficient(mass_coefficient),
+    _stiffness_coefficient(stiffness_coefficient), _tdim(0), _num_nodes(0),
+    _num_points(0)
+{
+  dolfin_assert(_V);
+  dolfin_assert(_V->mesh());
+  const Mesh& mesh = *_V->mesh();
+
+  // Check cell type and geometry
+  const CellType::Type cell_type = mesh.type().cell_type();
+  if (cell_type != CellType::Type::quadrilateral
+      && cell_type != CellType::Type::hexahedron)
+  {
+    dolfin_error("SumFactorizedOperator.cpp",
+                 "create sum-factorised operator",
+                 "Only quadrilateral and hexahedral meshes are supported");
+  }
+
+  _tdim = mesh.topology().dim();
+  if (mesh.geometry().dim() != _tdim || mesh.geometry().degree() != 1)
+  {
+    dolfin_error("SumFactorizedOperator.cpp",
+                 "create sum-factorised operator",
+                 "Expecting a mesh of degree 1 with geometric dimension %d",
+                 (int) _tdim);
+  }
+
+  // Create work vectors
+  _x = create_vector(*_V, true);
+  _y = create_vector(*_V, false);
+
+  // Compute lexicographic dof ordering, 1D tables and geometry
+  init_element();
+  init_geometry();
+}
+//-----------------------------------------------------------------------------
+SumFactorizedOperator::~SumFactorizedOperator()
+{
+  // Do nothing
+}
+//-----------------------------------------------------------------------------
+std::size_t SumFactorizedOperator::size(std::size_t dim) const
+{
+  dolfin_assert(dim < 2);
+  return _V->dim();
+}
+//-----------------------------------------------------------------------------
+void SumFactorizedOperator::mult(const GenericVector& x,
+                                 GenericVector& y) const
+{
+  Timer timer("Apply sum-factorised operator");
+
+  // Copy x to work vector and update ghost values
+  std::vector<double> values;
+  x.get_local(values);
+  _x->set_local(values);
+  _x->apply("insert");
+  _y->zero();
+
+  const GenericDofMap& dofmap = *_V->dofmap();
+  const std::size_t d = _tdim;
+  const std::size_t num_dofs = _lexicographic_dofs.size();
+  std::size_t num_points = 1;
+  for (std::size_t k = 0; k < d; ++k)
+    num_points *= _num_points;
+  const std::size_t factors_per_point = 1 + d*d;
+  const std::size_t work_size = std::max(num_dofs, num_points);
+
+  const bool has_mass = _mass_coefficient != 0.0;
+  const bool has_stiffness = _stiffness_coefficient != 0.0;
+
+  // Work arrays (lexicographic ordering)
+  std::vector<double> x_cell(num_dofs), y_cell(num_dofs);
+  std::vector<double> u(num_dofs), v(num_dofs);
+  std::vector<double> u_values(num_points);
+  std::vector<std::vector<double>> u_derivatives(d,
+                                                 std::vector<double>(num_points));
+  std::vector<double> work0(work_size), work1(work_size);
+
+  for (std::size_t c = 0; c < _cells.size(); ++c)
+  {
+    // Get cell values of x in lexicographic ordering
+    auto dofs = dofmap.cell_dofs(_cells[c]);
+    dolfin_assert((std::size_t) dofs.size() == num_dofs);
+    _x->get_local(x_cell.data(), num_dofs, dofs.data());
+    for (std::size_t i = 0; i < num_dofs; ++i)
+      u[i] = x_cell[_lexicographic_dofs[i]];
+
+    // Interpolate values and reference gradient to quadrature points
+    if (has_mass)
+      apply_tensor(u.data(), u_values.data(), -1, false, work0, work1);
+    if (has_stiffness)
+    {
+      for (std::size_t k = 0; k < d; ++k)
+      {
+        apply_tensor(u.data(), u_derivatives[k].data(), k, false,
+                     work0, work1);
+      }
+    }
+
+    // Scale by geometric factors at quadrature points
+    const double* factors
+      = _geometric_factors.data() + c*num_points*factors_per_point;
+    double flux[3];
+    for (std::size_t p = 0; p < num_points; ++p)
+    {
+      const double* f = factors + p*factors_per_point;
+      if (has_mass)
+        u_values[p] *= _mass_coefficient*f[0];
+      if (has_stiffness)
+      {
+        for (std::size_t k = 0; k < d; ++k)
+        {
+          flux[k] = 0.0;
+          for (std::size_t l = 0; l < d; ++l)
+            flux[k] += f[1 + k*d + l]*u_derivatives[l][p];
+        }
+        for (std::size_t k = 0; k < d; ++k)
+          u_derivatives[k][p] = _stiffness_coefficient*flux[k];
+      }
+    }
+
+    // Integrate against test functions
+    std::fill(v.begin(), v.end(), 0.0);
+    if (has_mass)
+      apply_tensor(u_values.data(), v.data(), -1, true, work0, work1);
+    if (has_stiffness)
+    {
+      for (std::size_t k = 0; k < d; ++k)
+      {
+        apply_tensor(u_derivatives[k].data(), v.data(), k, true,
+                     work0, work1);
+      }
+    }
+
+    // Add to global vector in element dof ordering
+    for (std::size_t i = 0; i < num_dofs; ++i)
+      y_cell[_lexicographic_dofs[i]] = v[i];
+    _y->add_local(y_cell.data(), num_dofs, dofs.data());
+  }
+
+  // Accumulate off-process contributions and copy to y
+  _y->apply("add");
+  _y->get_local(values);
+  y.set_local(values);
+  y.apply("insert");
+}
+//-----------------------------------------------------------------------------
+std::string SumFactorizedOperator::str(bool verbose) const
+{
+  std::stringstream s;
+  s << "<SumFactorizedOperator of degree " << degree() << " and size "
+    << size(0) << " x " << size(1) << ">";
+  return s.str();
+}
+//-----------------------------------------------------------------------------
+std::shared_ptr<GenericVector>
+SumFactorizedOperator::create_vector(const FunctionSpace& V, bool ghosted)
+{
+  dolfin_assert(V.dofmap());
+  dolfin_assert(V.mesh());
+  const MPI_Comm comm = V.mesh()->mpi_comm();
+
+  // Create layout from index map of function space
+  DefaultFactory factory;
+  std::shared_ptr<TensorLayout> tensor_layout
+    = factory.create_layout(comm, 1);
+  dolfin_assert(tensor_layout);
+  tensor_layout->init({V.dofmap()->index_map()},
+                      ghosted ? TensorLayout::Ghosts::GHOSTED
+                      : TensorLayout::Ghosts::UNGHOSTED);
+
+  // Create vector
+  std::shared_ptr<GenericVector> x = factory.create_vector(comm);
+  dolfin_assert(x);
+  x->init(*tensor_layout);
+  x->zero();
+
+  return x;
+}
+//-----------------------------------------------------------------------------
+void SumFactorizedOperator::init_element()
+{
+  dolfin_assert(_V->element());
+  const FiniteElement& element = *_V->element();
+  if (element.value_rank() != 0 || element.num_sub_elements() != 0)
+  {
+    dolfin_error("SumFactorizedOperator.cpp",
+                 "create sum-factorised operator",
+                 "Only scalar Lagrange elements are supported");
+  }
+
+  // Get coordinates of the dofs on the reference cell
+  const std::size_t d = _tdim;
+  const std::size_t num_dofs = element.space_dimension();
+  std::vector<double> X(num_dofs*d);
+  element.ufc_element()->tabulate_reference_dof_coordinates(X.data());
+
+  // Collect distinct 1D node positions
+  const double tol = 1.0e-10;
+  std::vector<double> nodes(X);
+  std::sort(nodes.begin(), nodes.end());
+  nodes.erase(std::unique(nodes.begin(), nodes.end(),
+                          [tol](double a, double b)
+                          { return std::abs(a - b) < tol; }),
+              nodes.end());
+  _num_nodes = nodes.size();
+
+  std::size_t num_tensor_dofs = 1;
+  for (std::size_t k = 0; k < d; ++k)
+    num_tensor_dofs *= _num_nodes;
+  if (num_tensor_dofs != num_dofs)
+  {
+    dolfin_error("SumFactorizedOperator.cpp",
+                 "create sum-factorised operator",
+                 "Element dofs do not lie on a tensor-product grid");
+  }
+
+  // Map each dof to its lexicographic index (first coordinate
+  // slowest)
+  const std::size_t unset = num_dofs;
+  _lexicographic_dofs.assign(num_dofs, unset);
+  for (std::size_t i = 0; i < num_dofs; ++i)
+  {
+    std::size_t index = 0;
+    for (std::size_t k = 0; k < d; ++k)
+    {
+      auto node = std::lower_bound(nodes.begin(), nodes.end(),
+                                   X[i*d + k] - tol);
+      dolfin_assert(node != nodes.end());
+      dolfin_assert(std::abs(*node - X[i*d + k]) < tol);
+      index = index*_num_nodes + (node - nodes.begin());
+    }
+
+    if (_lexicographic_dofs[index] != unset)
+    {
+      dolfin_error("SumFactorizedOperator.cpp",
+                   "create sum-factorised operator",
+                   "Element has more than one dof at a node");
+    }
+    _lexicographic_dofs[index] = i;
+  }
+
+  // Gauss quadrature on [0, 1] with (p + 1) points, which is exact
+  // for the mass matrix on affine cells
+  _num_points = _num_nodes;
+  SimplexQuadrature quadrature(1, _num_points);
+  const std::vector<Point> interval = {Point(0.0), Point(1.0)};
+  const std::pair<std::vector<double>, std::vector<double>> rule
+    = quadrature.compute_quadrature_rule(interval, 1);
+  dolfin_assert(rule.first.size() == _num_points);
+
+  // Tabulate 1D basis functions and derivatives at quadrature points
+  _basis.resize(_num_points*_num_nodes);
+  _derivatives.resize(_num_points*_num_nodes);
+  for (std::size_t q = 0; q < _num_points; ++q)
+  {
+    tabulate_lagrange_basis(nodes, rule.first[q],
+                            _basis.data() + q*_num_nodes,
+                            _derivatives.data() + q*_num_nodes);
+  }
+}
+//-----------------------------------------------------------------------------
+void SumFactorizedOperator::init_geometry()
+{
+  const Mesh& mesh = *_V->mesh();
+  const std::size_t d = _tdim;
+  const std::size_t num_vertices = mesh.type().num_vertices();
+
+  // Gauss quadrature on [0, 1]
+  SimplexQuadrature quadrature(1, _num_points);
+  const std::vector<Point> interval = {Point(0.0), Point(1.0)};
+  const std::pair<std::vector<double>, std::vector<double>> rule
+    = quadrature.compute_quadrature_rule(interval, 1);
+
+  std::size_t num_points = 1;
+  for (std::size_t k = 0; k < d; ++k)
+    num_points *= _num_points;
+  const std::size_t factors_per_point = 1 + d*d;
+
+  // Collect owned cells
+  _cells.clear();
+  for (CellIterator cell(mesh); !cell.end(); ++cell)
+  {
+    if (!cell->is_ghost())
+      _cells.push_back(cell->index());
+  }
+  _geometric_factors.resize(_cells.size()*num_points*factors_per_point);
+
+  // The (multi)linear coordinate map uses the tensor-product vertex
+  // numbering of the reference cell: the reference coordinate k of
+  // vertex v is bit (d - 1 - k) of v
+  std::vector<double> coordinate_dofs;
+  double xi[3], w, J[9], K[9];
+  for (std::size_t c = 0; c < _cells.size(); ++c)
+  {
+    const Cell cell(mesh, _cells[c]);
+    cell.get_coordinate_dofs(coordinate_dofs);
+    dolfin_assert(coordinate_dofs.size() == num_vertices*d);
+
+    for (std::size_t p = 0; p < num_points; ++p)
+    {
+      // Quadrature point and weight (first index slowest)
+      w = 1.0;
+      for (std::size_t k = 0, r = p; k < d; ++k)
+      {
+        std::size_t stride = 1;
+        for (std::size_t j = k + 1; j < d; ++j)
+          stride *= _num_points;
+        const std::size_t q = r/stride;
+        r -= q*stride;
+        xi[k] = rule.first[q];
+        w *= rule.second[q];
+      }
+
+      // Compute Jacobian J_ik = dx_i/dxi_k
+      std::fill(J, J + d*d, 0.0);
+      for (std::size_t v = 0; v < num_vertices; ++v)
+      {
+        for (std::size_t k = 0; k < d; ++k)
+        {
+          double dN = 1.0;
+          for (std::size_t j = 0; j < d; ++j)
+          {
+            const bool bit = (v >> (d - 1 - j)) & 1;
+            if (j == k)
+              dN *= bit ? 1.0 : -1.0;
+            else
+              dN *= bit ? xi[j] : 1.0 - xi[j];
+          }
+          for (std::size_t i = 0; i < d; ++i)
+            J[i*d + k] += coordinate_dofs[v*d + i]*dN;
+        }
+      }
+
+      const double detJ = invert(J, K, d);
+      if (detJ == 0.0)
+      {
+        dolfin_error("SumFactorizedOperator.cpp",
+                     "create sum-factorised operator",
+                     "Cell %d is degenerate", (int) _cells[c]);
+      }
+
+      // Store w|det J| and w|det J| K K^T
+      double* f = _geometric_factors.data()
+        + (c*num_points + p)*factors_per_point;
+      const double scale = w*std::abs(detJ);
+      f[0] = scale;
+      for (std::size_t k = 0; k < d; ++k)
+      {
+        for (std::size_t l = 0; l < d; ++l)
+        {
+          double sum = 0.0;
+          for (std::size_t i = 0; i < d; ++i)
+            sum += K[k*d + i]*K[l*d + i];
+          f[1 + k*d + l] = scale*sum;
+        }
+      }
+    }
+  }
+}
+//-----------------------------------------------------------------------------
+void SumFactorizedOperator::apply_tensor(const double* in, double* out,
+                                         int derivative, bool transpose,
+                                         std::vector<double>& work0,
+                                         std::vector<double>& work1) const
+{
+  const std::size_t d = _tdim;
+  const std::size_t n_in = transpose ? _num_points : _num_nodes;
+  const std::size_t n_out = transpose ? _num_nodes : _num_points;
+
+  // Apply the 1D tables one direction at a time. After step k the
+  // first k + 1 indices have the output extent.
+  const double* src = in;
+  double* dst = nullptr;
+  for (std::size_t k = 0; k < d; ++k)
+  {
+    std::size_t outer = 1, inner = 1;
+    for (std::size_t j = 0; j < k; ++j)
+      outer *= n_out;
+    for (std::size_t j = k + 1; j < d; ++j)
+      inner *= n_in;
+
+    const std::vector<double>& M
+      = ((int) k == derivative) ? _derivatives : _basis;
+    dst = (k % 2 == 0) ? work0.data() : work1.data();
+    contract(M.data(), _num_points, _num_nodes, transpose, src, dst,
+             outer, inner);
+    src = dst;
+  }
+
+  // Copy (or add) result
+  std::size_t size = 1;
+  for (std::size_t k = 0; k < d; ++k)
+    size *= n_out;
+  if (transpose)
+  {
+    for (std::size_t i = 0; i < size; ++i)
+      out[i] += src[i];
+  }
+  else
+    std::copy(src, src + size, out);
+}
+//-----------------------------------------------------------------------------
@@ -0,0 +1,144 @@
+// Copyright (C) 2026 agent
+//
+// This file is part of DOLFIN.
+//
+// DOLFIN is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// DOLFIN is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with DOLFIN. If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef __SUM_FACTORIZED_OPERATOR_H
+#define __SUM_FACTORIZED_OPERATOR_H
+
+#include <memory>
+#include <string>
+#include <vector>
+#include <dolfin/la/LinearOperator.h>
+
+namespace dolfin
+{
+
+  // Forward declarations
+  class FunctionSpace;
+  class GenericVector;
+
+  /// This class defines a matrix-free linear operator for the
+  /// bilinear form
+  ///
+  ///     a(u, v) = int c_m u v + c_s grad(u) . grad(v) dx
+  ///
+  /// on a scalar Lagrange (Q) space on a quadrilateral or
+  /// hexahedral mesh. The action of the operator on each cell is
+  /// computed by sum factorisation: the 1D basis functions and their
+  /// derivatives are tabulated at (p + 1) Gauss points per
+  /// direction, and values and gradients at the quadrature points
+  /// are computed by applying the 1D tables one direction at a
+  /// time. This reduces the cost of the operator action from
+  /// O(p^(2d)) (dense element matrix) to O(p^(d + 1)) per cell in d
+  /// dimensions, where p is the polynomial degree.
+  ///
+  /// The geometric factors (weighted Jacobian determinant and
+  /// inverse Jacobian products) at the quadrature points are
+  /// computed once for each cell and cached. Cells must be
+  /// (multi)linear, i.e. the mesh must be of degree one.
+  ///
+  /// The degrees of freedom are those of the _DofMap_ of the
+  /// function space. The map from the local dofs of the element to
+  /// lexicographic tensor-product ordering is computed from the
+  /// reference dof coordinates of the element.
+
+  class SumFactorizedOperator : public LinearOperator
+  {
+  public:
+
+    /// Create sum-factorised operator on function space
+    ///
+    /// @param[in] V (FunctionSpace)
+    ///         The scalar Lagrange function space.
+    /// @param[in] mass_coefficient (double)
+    ///         The coefficient c_m of the mass term.
+    /// @param[in] stiffness_coefficient (double)
+    ///         The coefficient c_s of the stiffness term.
+    SumFactorizedOperator(std::shared_ptr<const FunctionSpace> V,
+                          double mass_coefficient,
+                          double stiffness_coefficient);
+
+    /// Destructor
+    ~SumFactorizedOperator();
+
+    /// Return size of given dimension
+    std::size_t size(std::size_t dim) const;
+
+    /// Compute matrix-vector product y = Ax
+    void mult(const GenericVector& x, GenericVector& y) const;
+
+    /// Return polynomial degree of the function space
+    std::size_t degree() const
+    { return _num_nodes - 1; }
+
+    /// Return informal string representation (pretty-print)
+    std::string str(bool verbose) const;
+
+  private:
+
+    // Create vector with parallel layout of the function space
+    static std::shared_ptr<GenericVector>
+      create_vector(const FunctionSpace& V, bool ghosted);
+
+    // Compute map from lexicographic to element dof ordering and
+    // tabulate 1D basis functions at the quadrature points
+    void init_element();
+
+    // Compute and cache geometric factors for each cell
+    void init_geometry();
+
+    // Interpolate (transpose = false) values or reference derivative
+    // in direction 'derivative' (-1 for values) from nodes to
+    // quadrature points, or apply the transpose (transpose = true).
+    // The result is added to 'out' if transpose is true. Both
+    // work arrays must have size max(n, q)^d.
+    void apply_tensor(const double* in, double* out, int derivative,
+                      bool transpose, std::vector<double>& work0,
+                      std::vector<double>& work1) const;
+
+    // The function space
+    std::shared_ptr<const FunctionSpace> _V;
+
+    // Coefficients of the mass and stiffness terms
+    double _mass_coefficient, _stiffness_coefficient;
+
+    // Topological dimension, number of 1D nodes and number of 1D
+    // quadrature points
+    std::size_t _tdim, _num_nodes, _num_points;
+
+    // Element dof for each lexicographic node index
+    std::vector<std::size_t> _lexicographic_dofs;
+
+    // 1D basis functions and their derivatives at the quadrature
+    // points (num_points x num_nodes, row-major)
+    std::vector<double> _basis, _derivatives;
+
+    // Cells (owned) on which the operator is applied
+    std::vector<std::size_t> _cells;
+
+    // Geometric factors for each cell and quadrature point:
+    // w|det J| followed by the d x d matrix w|det J| K K^T
+    std::vector<double> _geometric_factors;
+
+    // Work vectors with ghost entries for x and y
+    std::shared_ptr<GenericVector> _x;
+    std::shared_ptr<GenericVector> _y;
+
+  };
+
+}
+
+#endif
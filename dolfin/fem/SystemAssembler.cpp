@@ -21,14 +21,20 @@
 // Modified by Martin Alnaes 2013-2015
 // Modified by Cecile Daversin-Catty 2018
 
+#ifdef HAS_OPENMP
+#include <omp.h>
+#endif
+
 #include <algorithm>
 #include <array>
+#include <memory>
 #include <Eigen/Dense>
 #include <boost/multi_array.hpp>
 
 #include <dolfin/common/ArrayView.h>
 #include <dolfin/common/Timer.h>
 #include <dolfin/common/types.h>
+#include <dolfin/common/utils.h>
 #include <dolfin/function/GenericFunction.h>
 #include <dolfin/function/FunctionSpace.h>
 #include <dolfin/la/GenericMatrix.h>
@@ -40,16 +46,91 @@
 #include <dolfin/mesh/Facet.h>
 #include <dolfin/mesh/MeshFunction.h>
 #include <dolfin/mesh/SubDomain.h>
+#include <dolfin/parameter/GlobalParameters.h>
 #include "AssemblerBase.h"
 #include "DirichletBC.h"
 #include "FiniteElement.h"
 #include "Form.h"
 #include "GenericDofMap.h"
+#include "OpenMpAssembler.h"
 #include "UFC.h"
 #include "SystemAssembler.h"
 
 using namespace dolfin;
 
+namespace
+{
+  // Add block to tensor, serialising the insertion between threads
+  // if required
+  void add_to_tensor(GenericTensor& A, const double* block,
+                     const std::vector<ArrayView<const la_index>>& dofs,
+                     bool serialize_insertion)
+  {
+    if (serialize_insertion)
+    {
+      #pragma omp critical (dolfin_system_assembler_insert)
+      A.add_local(block, dofs);
+    }
+    else
+      A.add_local(block, dofs);
+  }
+
+  // Return the entities of one colour that are assigned to the
+  // calling thread. Entities are split into contiguous chunks in
+  // thread order.
+  void thread_chunk(std::vector<std::size_t>& chunk,
+                    const std::vector<std::size_t>& entities)
+  {
+    #ifdef HAS_OPENMP
+    const std::size_t thread = omp_get_thread_num();
+    const std::size_t num_threads = omp_get_num_threads();
+    #else
+    const std::size_t thread = 0;
+    const std::size_t num_threads = 1;
+    #endif
+    const std::size_t n = entities.size();
+    chunk.assign(entities.begin() + (thread*n)/num_threads,
+                 entities.begin() + ((thread + 1)*n)/num_threads);
+  }
+
+  // Colour facets such that no two facets of the same colour are
+  // incident to cells that share a vertex. The macro elements of
+  // facets of one colour therefore share no dofs.
+  std::vector<std::vector<std::size_t>> color_facets(const Mesh& mesh)
+  {
+    std::vector<std::vector<std::size_t>> vertex_colors(mesh.num_vertices());
+    std::vector<std::vector<std::size_t>> colored_facets;
+    std::vector<std::size_t> vertices;
+    std::vector<bool> used;
+    for (FacetIterator facet(mesh); !facet.end(); ++facet)
+    {
+      // Collect vertices of cells incident to facet
+      vertices.clear();
+      for (CellIterator cell(*facet); !cell.end(); ++cell)
+      {
+        vertices.insert(vertices.end(), cell->entities(0),
+                        cell->entities(0) + cell->num_entities(0));
+      }
+
+      // Pick smallest colour not used by any of the vertices
+      used.assign(colored_facets.size() + 1, false);
+      for (auto v : vertices)
+        for (auto color : vertex_colors[v])
+          used[color] = true;
+      const std::size_t color
+        = std::find(used.begin(), used.end(), false) - used.begin();
+
+      if (color == colored_facets.size())
+        colored_facets.push_back(std::vector<std::size_t>());
+      colored_facets[color].push_back(facet->index());
+      for (auto v : vertices)
+        vertex_colors[v].push_back(color);
+    }
+
+    return colored_facets;
+  }
+}
+
 //-----------------------------------------------------------------------------
 SystemAssembler::SystemAssembler(std::shared_ptr<const Form> a,
                                  std::shared_ptr<const Form> L,
@@ -381,14 +462,26 @@ void SystemAssembler::assemble(GenericMatrix* A, GenericVector* b,
       boundary_values[0][bc_indices[i]] = x0_values[i] - bc_values[i];
   }
 
+  // Check whether assembly should be multithreaded
+  const bool threaded = (int) parameters["num_threads"] > 0;
+
   // Check whether we should do cell-wise or facet-wise assembly
   if (!ufc[0]->form.has_interior_facet_integrals()
       && !ufc[1]->form.has_interior_facet_integrals())
   {
     // Assemble cell-wise (no interior facet integrals)
-    cell_wise_assembly(tensors, ufc, data, boundary_values,
-                       cell_domains, exterior_facet_domains,
-                       integrate_rhs);
+    if (threaded)
+    {
+      threaded_cell_wise_assembly(tensors, ufc, boundary_values,
+                                  cell_domains, exterior_facet_domains,
+                                  integrate_rhs);
+    }
+    else
+    {
+      cell_wise_assembly(tensors, ufc, data, boundary_values,
+                         cell_domains, exterior_facet_domains,
+                         integrate_rhs, NULL, false);
+    }
   }
   else
   {
@@ -400,9 +493,20 @@ void SystemAssembler::assemble(GenericMatrix* A, GenericVector* b,
     }
 
     // Assemble facet-wise (including cell assembly)
-    facet_wise_assembly(tensors, ufc, data, boundary_values,
-                        cell_domains, exterior_facet_domains,
-                        interior_facet_domains);
+    if (threaded)
+    {
+      threaded_facet_wise_assembly(tensors, ufc, boundary_values,
+                                   cell_domains, exterior_facet_domains,
+                                   interior_facet_domains);
+    }
+    else
+    {
+      std::vector<char> cell_tensor_computed(mesh.num_cells(), false);
+      facet_wise_assembly(tensors, ufc, data, boundary_values,
+                          cell_domains, exterior_facet_domains,
+                          interior_facet_domains, cell_tensor_computed,
+                          NULL, false);
+    }
   }
 
   // Finalise assembly
@@ -422,7 +526,9 @@ void SystemAssembler::cell_wise_assembly(
   const std::vector<DirichletBC::Map>& boundary_values,
   std::shared_ptr<const MeshFunction<std::size_t>> cell_domains,
   std::shared_ptr<const MeshFunction<std::size_t>> exterior_facet_domains,
-  bool integrate_rhs)
+  bool integrate_rhs,
+  const std::vector<std::size_t>* cells,
+  bool serialize_insertion)
 {
   // Extract mesh
   dolfin_assert(ufc[0]->dolfin_form.mesh());
@@ -465,22 +571,29 @@ void SystemAssembler::cell_wise_assembly(
   bool use_exterior_facet_domains
     = exterior_facet_domains && !exterior_facet_domains->empty();
 
-  // Iterate over all cells
+  // Iterate over all cells (or the given cells)
   ufc::cell ufc_cell;
   std::vector<double> coordinate_dofs;
-  Progress p("Assembling system (cell-wise)", mesh.num_cells());
+  const std::size_t D = mesh.topology().dim();
+  const std::size_t num_cells
+    = cells ? cells->size() : mesh.topology().ghost_offset(D);
+  std::unique_ptr<Progress> p;
+  if (!cells)
+    p.reset(new Progress("Assembling system (cell-wise)", mesh.num_cells()));
 
   std::size_t nforms = integrate_rhs ? 2 : 1;
-  for (CellIterator cell(mesh); !cell.end(); ++cell)
+  for (std::size_t c = 0; c < num_cells; ++c)
   {
+    const Cell cell(mesh, cells ? (*cells)[c] : c);
+
     // Check that cell is not a ghost
-    dolfin_assert(!cell->is_ghost());
+    dolfin_assert(!cell.is_ghost());
 
     // Get cell vertex coordinates
-    cell->get_coordinate_dofs(coordinate_dofs);
+    cell.get_coordinate_dofs(coordinate_dofs);
 
     // Get UFC cell data
-    cell->get_cell_data(ufc_cell);
+    cell.get_cell_data(ufc_cell);
 
     // Loop over lhs and then rhs contributions
     for (std::size_t form = 0; form < nforms; ++form)
@@ -498,14 +611,14 @@ void SystemAssembler::cell_wise_assembly(
       // Get cell integrals for sub domain (if any)
       if (use_cell_domains)
       {
-        const std::size_t domain = (*cell_domains)[*cell];
+        const std::size_t domain = (*cell_domains)[cell];
         cell_integrals[form] = ufc[form]->get_cell_integral(domain);
       }
 
       // Get local-to-global dof maps for cell
       for (std::size_t dim = 0; dim < rank; ++dim)
       {
-        auto dmap = dofmaps[form][dim]->cell_dofs(cell->index());
+        auto dmap = dofmaps[form][dim]->cell_dofs(cell.index());
         cell_dofs[form][dim].set(dmap.size(), dmap.data());
       }
 
@@ -524,7 +637,7 @@ void SystemAssembler::cell_wise_assembly(
       if (tensor_required)
       {
         // Update to current cell
-        ufc[form]->update(*cell, coordinate_dofs, ufc_cell,
+        ufc[form]->update(cell, coordinate_dofs, ufc_cell,
                           cell_integrals[form]->enabled_coefficients());
 
         // Tabulate cell tensor
@@ -539,7 +652,7 @@ void SystemAssembler::cell_wise_assembly(
       // Compute exterior facet integral if present
       if (has_exterior_facet_integrals)
       {
-        for (FacetIterator facet(*cell); !facet.end(); ++facet)
+        for (FacetIterator facet(cell); !facet.end(); ++facet)
         {
           // Only consider exterior facets
           if (!facet->exterior())
@@ -558,7 +671,7 @@ void SystemAssembler::cell_wise_assembly(
             continue;
 
           // Extract local facet index
-          const std::size_t local_facet = cell->index(*facet);
+          const std::size_t local_facet = cell.index(*facet);
 
           // Determine if tensor needs to be computed
           bool tensor_required;
@@ -577,8 +690,8 @@ void SystemAssembler::cell_wise_assembly(
           if (tensor_required)
           {
             // Update to current cell
-            cell->get_cell_data(ufc_cell);
-            ufc[form]->update(*cell, coordinate_dofs, ufc_cell,
+            cell.get_cell_data(ufc_cell);
+            ufc[form]->update(cell, coordinate_dofs, ufc_cell,
                               exterior_facet_integrals[form]->enabled_coefficients());
 
             // Tabulate exterior facet tensor
@@ -597,7 +710,7 @@ void SystemAssembler::cell_wise_assembly(
     // If RHS has not been integrated, still want to add BC terms
     if (!integrate_rhs)
     {
-      auto dmap = dofmaps[1][0]->cell_dofs(cell->index());
+      auto dmap = dofmaps[1][0]->cell_dofs(cell.index());
       cell_dofs[1][0].set(dmap.size(), dmap.data());
       std::fill(data.Ae[1].begin(), data.Ae[1].end(), 0.0);
     }
@@ -610,10 +723,14 @@ void SystemAssembler::cell_wise_assembly(
     for (std::size_t form = 0; form < 2; ++form)
     {
       if (tensors[form])
-          tensors[form]->add_local(data.Ae[form].data(), cell_dofs[form]);
+      {
+        add_to_tensor(*tensors[form], data.Ae[form].data(), cell_dofs[form],
+                      serialize_insertion);
+      }
     }
 
-    p++;
+    if (p)
+      (*p)++;
   }
 
 }
@@ -625,7 +742,10 @@ void SystemAssembler::facet_wise_assembly(
   const std::vector<DirichletBC::Map>& boundary_values,
   std::shared_ptr<const MeshFunction<std::size_t>> cell_domains,
   std::shared_ptr<const MeshFunction<std::size_t>> exterior_facet_domains,
-  std::shared_ptr<const MeshFunction<std::size_t>> interior_facet_domains)
+  std::shared_ptr<const MeshFunction<std::size_t>> interior_facet_domains,
+  std::vector<char>& cell_tensor_computed,
+  const std::vector<std::size_t>* facets,
+  bool serialize_insertion)
 {
   // Extract mesh
   dolfin_assert(ufc[0]->dolfin_form.mesh());
@@ -695,27 +815,33 @@ void SystemAssembler::facet_wise_assembly(
 
   // Track whether or not cell contribution has been computed
   std::array<bool, 2> compute_cell_tensor = {{true, true}};
-  std::vector<bool> cell_tensor_computed(mesh.num_cells(), false);
+  dolfin_assert(cell_tensor_computed.size() == mesh.num_cells());
 
-  // Iterate over facets
+  // Iterate over all facets (or the given facets)
   std::array<ufc::cell, 2> ufc_cell;
   std::array<std::vector<double>, 2> coordinate_dofs;
-  Progress p("Assembling system (facet-wise)", mesh.num_facets());
-  for (FacetIterator facet(mesh); !facet.end(); ++facet)
+  const std::size_t num_facets
+    = facets ? facets->size() : mesh.topology().ghost_offset(D - 1);
+  std::unique_ptr<Progress> p;
+  if (!facets)
+    p.reset(new Progress("Assembling system (facet-wise)", mesh.num_facets()));
+  for (std::size_t f = 0; f < num_facets; ++f)
   {
+    const Facet facet(mesh, facets ? (*facets)[f] : f);
+
     // Number of cells sharing facet
-    const std::size_t num_cells = facet->num_entities(D);
+    const std::size_t num_cells = facet.num_entities(D);
 
     // Check that facet is not a ghost
-    dolfin_assert(!facet->is_ghost());
+    dolfin_assert(!facet.is_ghost());
 
     // Interior facet
     if (num_cells == 2)
     {
       // Get cells incident with facet (which is 0 and 1 here is arbitrary)
-      dolfin_assert(facet->num_entities(D) == 2);
-      std::array<std::size_t, 2> cell_indices = {{facet->entities(D)[0],
-                                                  facet->entities(D)[1]}};
+      dolfin_assert(facet.num_entities(D) == 2);
+      std::array<std::size_t, 2> cell_indices = {{facet.entities(D)[0],
+                                                  facet.entities(D)[1]}};
 
       // Make sure cell marker for '+' side is larger than cell marker
       // for '-' side.  Note: by ffc convention, 0 is + and 1 is -
@@ -730,7 +856,7 @@ void SystemAssembler::facet_wise_assembly(
       {
         cell[c] = Cell(mesh, cell_indices[c]);
         cell_index[c] = cell[c].index();
-        local_facet[c] = cell[c].index(*facet);
+        local_facet[c] = cell[c].index(facet);
         cell[c].get_coordinate_dofs(coordinate_dofs[c]);
         cell[c].get_cell_data(ufc_cell[c], local_facet[c]);
 
@@ -791,7 +917,7 @@ void SystemAssembler::facet_wise_assembly(
         // Get facet integral for sub domain (if any)
         if (use_interior_facet_domains)
         {
-          const std::size_t domain = (*interior_facet_domains)[*facet];
+          const std::size_t domain = (*interior_facet_domains)[facet];
           interior_facet_integrals[form]
             = ufc[form]->get_interior_facet_integral(domain);
         }
@@ -879,7 +1005,8 @@ void SystemAssembler::facet_wise_assembly(
         std::vector<ArrayView<const la_index>> mdofs(macro_dofs[1].size());
         for (std::size_t i = 0; i < macro_dofs[1].size(); ++i)
           mdofs[i].set(macro_dofs[1][i]);
-        tensors[1]->add_local(ufc[1]->macro_A.data(), mdofs);
+        add_to_tensor(*tensors[1], ufc[1]->macro_A.data(), mdofs,
+                      serialize_insertion);
       }
 
       const bool add_macro_element
@@ -889,7 +1016,8 @@ void SystemAssembler::facet_wise_assembly(
         std::vector<ArrayView<const la_index>> mdofs(macro_dofs[0].size());
         for (std::size_t i = 0; i < macro_dofs[0].size(); ++i)
           mdofs[i].set(macro_dofs[0][i]);
-        tensors[0]->add_local(ufc[0]->macro_A.data(), mdofs);
+        add_to_tensor(*tensors[0], ufc[0]->macro_A.data(), mdofs,
+                      serialize_insertion);
       }
       else if (tensors[0] && !add_macro_element && tensor_required_cell[0])
       {
@@ -900,7 +1028,8 @@ void SystemAssembler::facet_wise_assembly(
         // instead extract back out the diagonal cell blocks and add
         // them individually
         matrix_block_add(*tensors[0], data.Ae[0], ufc[0]->macro_A,
-                         compute_cell_tensor, cell_dofs[0]);
+                         compute_cell_tensor, cell_dofs[0],
+                         serialize_insertion);
       }
 
       // Mark cells as processed
@@ -911,7 +1040,7 @@ void SystemAssembler::facet_wise_assembly(
     {
       // Get mesh cell to which mesh facet belongs (pick first, there
       // is only one)
-      Cell cell(mesh, facet->entities(mesh.topology().dim())[0]);
+      Cell cell(mesh, facet.entities(mesh.topology().dim())[0]);
 
       // Check of attached cell needs to be processed
       compute_cell_tensor[0] = !cell_tensor_computed[cell.index()];
@@ -932,7 +1061,7 @@ void SystemAssembler::facet_wise_assembly(
         // Get exterior facet integrals for sub domain (if any)
         if (use_exterior_facet_domains)
         {
-          const std::size_t domain = (*exterior_facet_domains)[*facet];
+          const std::size_t domain = (*exterior_facet_domains)[facet];
           exterior_facet_integrals[form]
             = ufc[form]->get_exterior_facet_integral(domain);
         }
@@ -972,7 +1101,7 @@ void SystemAssembler::facet_wise_assembly(
                                     coordinate_dofs[0],
                                     tensor_required_cell,
                                     tensor_required_facet,
-                                    cell, *facet,
+                                    cell, facet,
                                     cell_integrals,
                                     exterior_facet_integrals,
                                     compute_cell_tensor[0]);
@@ -985,13 +1114,159 @@ void SystemAssembler::facet_wise_assembly(
       for (std::size_t form = 0; form < 2; ++form)
       {
         if (tensors[form])
-          tensors[form]->add_local(data.Ae[form].data(), cell_dofs[form][0]);
+        {
+          add_to_tensor(*tensors[form], data.Ae[form].data(),
+                        cell_dofs[form][0], serialize_insertion);
+        }
       }
 
       // Mark cell as processed
       cell_tensor_computed[cell.index()] = true;
     }
-    p++;
+
+    if (p)
+      (*p)++;
+  }
+}
+//-----------------------------------------------------------------------------
+void SystemAssembler::threaded_cell_wise_assembly(
+  std::array<GenericTensor*, 2>& tensors,
+  std::array<UFC*, 2>& ufc,
+  const std::vector<DirichletBC::Map>& boundary_values,
+  std::shared_ptr<const MeshFunction<std::size_t>> cell_domains,
+  std::shared_ptr<const MeshFunction<std::size_t>> exterior_facet_domains,
+  bool integrate_rhs)
+{
+  Timer timer("Assemble system (cell-wise, threaded)");
+
+  // Extract mesh
+  dolfin_assert(ufc[0]->dolfin_form.mesh());
+  const Mesh& mesh = *(ufc[0]->dolfin_form.mesh());
+  const std::size_t D = mesh.topology().dim();
+
+  // Compute facet connectivity before entering the parallel region
+  if (ufc[0]->form.has_exterior_facet_integrals()
+      || ufc[1]->form.has_exterior_facet_integrals())
+  {
+    mesh.init(D - 1);
+    mesh.init(D - 1, D);
+  }
+
+  // Colour cells such that cells of the same colour share no vertex
+  // (and hence no dofs)
+  const std::vector<std::size_t> coloring_type = {D, 0, D};
+  mesh.color(coloring_type);
+  auto coloring = mesh.topology().coloring.find(coloring_type);
+  dolfin_assert(coloring != mesh.topology().coloring.end());
+
+  // Remove ghost cells from colouring
+  const std::size_t num_regular_cells = mesh.topology().ghost_offset(D);
+  std::vector<std::vector<std::size_t>>
+    colored_cells(coloring->second.second.size());
+  for (std::size_t color = 0; color < colored_cells.size(); ++color)
+  {
+    for (auto c : coloring->second.second[color])
+    {
+      if (c < num_regular_cells)
+        colored_cells[color].push_back(c);
+    }
+  }
+
+  // Serialise insertion unless both tensors support concurrent
+  // insertion
+  bool serialize_insertion = false;
+  for (std::size_t i = 0; i < 2; ++i)
+  {
+    if (tensors[i] && !OpenMpAssembler::supports_concurrent_insertion(*tensors[i]))
+      serialize_insertion = true;
+  }
+
+  // Assemble colour by colour. Each thread owns its UFC and scratch
+  // data, and assembles a contiguous chunk of the cells of each
+  // colour.
+  Progress p("Assembling system (cell-wise, threaded)", colored_cells.size());
+  #pragma omp parallel num_threads(dolfin::num_threads())
+  {
+    UFC A_ufc(*ufc[0]), b_ufc(*ufc[1]);
+    std::array<UFC*, 2> thread_ufc = { {&A_ufc, &b_ufc} };
+    Scratch data(ufc[0]->dolfin_form, ufc[1]->dolfin_form);
+    std::vector<std::size_t> cells;
+
+    for (std::size_t color = 0; color < colored_cells.size(); ++color)
+    {
+      thread_chunk(cells, colored_cells[color]);
+      cell_wise_assembly(tensors, thread_ufc, data, boundary_values,
+                         cell_domains, exterior_facet_domains,
+                         integrate_rhs, &cells, serialize_insertion);
+
+      // Wait for all threads before moving to next colour
+      #pragma omp barrier
+      #pragma omp master
+      p++;
+    }
+  }
+}
+//-----------------------------------------------------------------------------
+void SystemAssembler::threaded_facet_wise_assembly(
+  std::array<GenericTensor*, 2>& tensors,
+  std::array<UFC*, 2>& ufc,
+  const std::vector<DirichletBC::Map>& boundary_values,
+  std::shared_ptr<const MeshFunction<std::size_t>> cell_domains,
+  std::shared_ptr<const MeshFunction<std::size_t>> exterior_facet_domains,
+  std::shared_ptr<const MeshFunction<std::size_t>> interior_facet_domains)
+{
+  Timer timer("Assemble system (facet-wise, threaded)");
+
+  // Extract mesh
+  dolfin_assert(ufc[0]->dolfin_form.mesh());
+  const Mesh& mesh = *(ufc[0]->dolfin_form.mesh());
+  const std::size_t D = mesh.topology().dim();
+
+  // Compute facet connectivity before entering the parallel region
+  mesh.init(D - 1);
+  mesh.init(D - 1, D);
+
+  // Colour facets such that the macro elements of facets of the same
+  // colour share no dofs. Since facets of one colour have no cell in
+  // common, the cell tensor flags are also free of races, and the
+  // facet that adds each cell tensor does not depend on the number
+  // of threads.
+  const std::vector<std::vector<std::size_t>> colored_facets
+    = color_facets(mesh);
+  std::vector<char> cell_tensor_computed(mesh.num_cells(), false);
+
+  // Serialise insertion unless both tensors support concurrent
+  // insertion
+  bool serialize_insertion = false;
+  for (std::size_t i = 0; i < 2; ++i)
+  {
+    if (tensors[i] && !OpenMpAssembler::supports_concurrent_insertion(*tensors[i]))
+      serialize_insertion = true;
+  }
+
+  // Assemble colour by colour
+  Progress p("Assembling system (facet-wise, threaded)",
+             colored_facets.size());
+  #pragma omp parallel num_threads(dolfin::num_threads())
+  {
+    UFC A_ufc(*ufc[0]), b_ufc(*ufc[1]);
+    std::array<UFC*, 2> thread_ufc = { {&A_ufc, &b_ufc} };
+    Scratch data(ufc[0]->dolfin_form, ufc[1]->dolfin_form);
+    std::vector<std::size_t> facets;
+
+    for (std::size_t color = 0; color < colored_facets.size(); ++color)
+    {
+      thread_chunk(facets, colored_facets[color]);
+      facet_wise_assembly(tensors, thread_ufc, data, boundary_values,
+                          cell_domains, exterior_facet_domains,
+                          interior_facet_domains, cell_tensor_computed,
+                          &facets, serialize_insertion);
+
+      // Wait for all threads before moving to next colour
+      #pragma omp barrier
+      #pragma omp master
+      p++;
+    }
   }
 }
 //-----------------------------------------------------------------------------
@@ -1140,7 +1415,8 @@ void SystemAssembler::matrix_block_add(
   std::vector<double>& Ae,
   std::vector<double>& macro_A,
   const std::array<bool, 2>& add_local_tensor,
-  const std::array<std::vector<ArrayView<const la_index>>, 2>& cell_dofs)
+  const std::array<std::vector<ArrayView<const la_index>>, 2>& cell_dofs,
+  bool serialize_insertion)
 {
   for (std::size_t c = 0; c < 2; ++c)
   {
@@ -1155,7 +1431,7 @@ void SystemAssembler::matrix_block_add(
         for (std::size_t j = 0; j < nn; j++)
           Ae[i*nn + j] = macro_A[2*nn*mm*c + 2*i*nn + nn*c +j];
       }
-      tensor.add_local(Ae.data(), cell_dofs[c]);
+      add_to_tensor(tensor, Ae.data(), cell_dofs[c], serialize_insertion);
     }
   }
 }
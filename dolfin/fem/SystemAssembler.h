@@ -55,6 +55,15 @@ namespace dolfin
   /// b. It differs from the default DOLFIN assembler in that it
   /// applies boundary conditions at the time of assembly, which
   /// preserves any symmetries in A.
+  ///
+  /// If the global parameter "num_threads" is positive, assembly is
+  /// multithreaded. Cells (cell-wise assembly) or facets (facet-wise
+  /// assembly) are coloured such that entities of the same colour
+  /// share no dofs, and the entities of each colour are assembled
+  /// concurrently. Since each entry of A and b receives at most one
+  /// contribution per colour and colours are processed in order, the
+  /// result is bitwise identical for any number of threads. It may
+  /// differ in rounding from serial assembly.
 
   class SystemAssembler : public AssemblerBase
   {
@@ -138,7 +147,9 @@ namespace dolfin
       const std::vector<DirichletBC::Map>& boundary_values,
       std::shared_ptr<const MeshFunction<std::size_t>> cell_domains,
       std::shared_ptr<const MeshFunction<std::size_t>> exterior_facet_domains,
-      bool integrate_rhs);
+      bool integrate_rhs,
+      const std::vector<std::size_t>* cells,
+      bool serialize_insertion);
 
     static void facet_wise_assembly(
       std::array<GenericTensor*, 2>& tensors,
@@ -147,6 +158,27 @@ namespace dolfin
       const std::vector<DirichletBC::Map>& boundary_values,
       std::shared_ptr<const MeshFunction<std::size_t>> cell_domains,
       std::shared_ptr<const MeshFunction<std::size_t>> exterior_facet_domains,
+      std::shared_ptr<const MeshFunction<std::size_t>> interior_facet_domains,
+      std::vector<char>& cell_tensor_computed,
+      const std::vector<std::size_t>* facets,
+      bool serialize_insertion);
+
+    // Multithreaded cell-wise assembly over coloured cells
+    static void threaded_cell_wise_assembly(
+      std::array<GenericTensor*, 2>& tensors,
+      std::array<UFC*, 2>& ufc,
+      const std::vector<DirichletBC::Map>& boundary_values,
+      std::shared_ptr<const MeshFunction<std::size_t>> cell_domains,
+      std::shared_ptr<const MeshFunction<std::size_t>> exterior_facet_domains,
+      bool integrate_rhs);
+
+    // Multithreaded facet-wise assembly over coloured facets
+    static void threaded_facet_wise_assembly(
+      std::array<GenericTensor*, 2>& tensors,
+      std::array<UFC*, 2>& ufc,
+      const std::vector<DirichletBC::Map>& boundary_values,
+      std::shared_ptr<const MeshFunction<std::size_t>> cell_domains,
+      std::shared_ptr<const MeshFunction<std::size_t>> exterior_facet_domains,
       std::shared_ptr<const MeshFunction<std::size_t>> interior_facet_domains);
 
     // Compute exterior facet (and possibly connected cell)
@@ -188,7 +220,8 @@ namespace dolfin
       std::vector<double>& Ae,
       std::vector<double>& macro_A,
       const std::array<bool, 2>& add_local_tensor,
-      const std::array<std::vector<ArrayView<const la_index>>, 2>& cell_dofs);
+      const std::array<std::vector<ArrayView<const la_index>>, 2>& cell_dofs,
+      bool serialize_insertion);
 
     static void apply_bc(double* A, double* b,
                          const std::vector<DirichletBC::Map>& boundary_values,
@@ -19,7 +19,12 @@
 // Modified by Garth N. Wells, 2010
 // Modified by Martin Alnaes, 2013-2015
 
+#ifdef HAS_OPENMP
+#include <omp.h>
+#endif
+
 #include <dolfin/common/types.h>
+#include <dolfin/function/Expression.h>
 #include <dolfin/function/FunctionSpace.h>
 #include <dolfin/function/GenericFunction.h>
 #include "GenericDofMap.h"
@@ -63,6 +68,16 @@ void UFC::init(const Form& a)
     coefficient_elements.push_back(FiniteElement(element));
   }
 
+  // Coefficients that are not expressions (e.g. Functions) read
+  // shared data (such as a PETSc vector) that is not thread-safe
+  // when restricted
+  serial_coefficients.resize(coefficients.size());
+  for (std::size_t i = 0; i < coefficients.size(); ++i)
+  {
+    serial_coefficients[i]
+      = !std::dynamic_pointer_cast<const Expression>(coefficients[i]);
+  }
+
   // Create cell integrals
   default_cell_integral
     = std::shared_ptr<ufc::cell_integral>(form.create_default_cell_integral());
@@ -164,12 +179,30 @@ void UFC::update(const Cell& c, const std::vector<double>& coordinate_dofs,
   {
     if (!enabled_coefficients[i])
       continue;
-    dolfin_assert(coefficients[i]);
-    coefficients[i]->restrict(_w[i].data(), coefficient_elements[i], c,
-                              coordinate_dofs.data(), ufc_cell);
+    restrict_coefficient(i, _w[i].data(), c, coordinate_dofs.data(), ufc_cell);
+  }
+}
+//-----------------------------------------------------------------------------
+void UFC::update(const Cell& c, const double* coordinate_dofs,
+                 const ufc::cell& ufc_cell,
+                 const std::vector<bool>& enabled_coefficients,
+                 double* const * w) const
+{
+  // Restrict coefficients to cell
+  for (std::size_t i = 0; i < coefficients.size(); ++i)
+  {
+    if (!enabled_coefficients[i])
+      continue;
+    restrict_coefficient(i, w[i], c, coordinate_dofs, ufc_cell);
   }
 }
 //-----------------------------------------------------------------------------
+std::size_t UFC::coefficient_dimension(std::size_t i) const
+{
+  dolfin_assert(i < coefficient_elements.size());
+  return coefficient_elements[i].space_dimension();
+}
+//-----------------------------------------------------------------------------
 void UFC::update(const Cell& c0, const std::vector<double>& coordinate_dofs0,
                  const ufc::cell& ufc_cell0,
                  const Cell& c1, const std::vector<double>& coordinate_dofs1,
@@ -181,13 +214,11 @@ void UFC::update(const Cell& c0, const std::vector<double>& coordinate_dofs0,
   {
     if (!enabled_coefficients[i])
       continue;
-    dolfin_assert(coefficients[i]);
     const std::size_t offset = coefficient_elements[i].space_dimension();
-    coefficients[i]->restrict(_macro_w[i].data(), coefficient_elements[i],
-                              c0, coordinate_dofs0.data(), ufc_cell0);
-    coefficients[i]->restrict(_macro_w[i].data() + offset,
-                              coefficient_elements[i],
-                              c1, coordinate_dofs1.data(), ufc_cell1);
+    restrict_coefficient(i, _macro_w[i].data(), c0, coordinate_dofs0.data(),
+                         ufc_cell0);
+    restrict_coefficient(i, _macro_w[i].data() + offset, c1,
+                         coordinate_dofs1.data(), ufc_cell1);
   }
 }
 //-----------------------------------------------------------------------------
@@ -221,3 +252,25 @@ void UFC::update(const Cell& c0, const std::vector<double>& coordinate_dofs0,
   }
 }
 //-----------------------------------------------------------------------------
+void UFC::restrict_coefficient(std::size_t i, double* w, const Cell& c,
+                               const double* coordinate_dofs,
+                               const ufc::cell& ufc_cell) const
+{
+  dolfin_assert(coefficients[i]);
+
+  // Restrict coefficients that are not thread-safe one thread at a
+  // time when called from a parallel region
+  #ifdef HAS_OPENMP
+  if (serial_coefficients[i] and omp_in_parallel())
+  {
+    #pragma omp critical (dolfin_ufc_restrict)
+    coefficients[i]->restrict(w, coefficient_elements[i], c, coordinate_dofs,
+                              ufc_cell);
+    return;
+  }
+  #endif
+
+  coefficients[i]->restrict(w, coefficient_elements[i], c, coordinate_dofs,
+                            ufc_cell);
+}
+//-----------------------------------------------------------------------------
@@ -91,6 +91,18 @@ namespace dolfin
                 const std::vector<double>& coordinate_dofs1,
                 const ufc::cell& ufc_cell1);
 
+    /// Restrict coefficients to a cell, writing the expansion
+    /// coefficients of coefficient i to w[i] (which must hold at
+    /// least coefficient_dimension(i) values). Used for assembling
+    /// batches of cells.
+    void update(const Cell& cell, const double* coordinate_dofs,
+                const ufc::cell& ufc_cell,
+                const std::vector<bool>& enabled_coefficients,
+                double* const * w) const;
+
+    /// Number of expansion coefficients of coefficient i on a cell
+    std::size_t coefficient_dimension(std::size_t i) const;
+
     /// Pointer to coefficient data. Used to support UFC interface.
     const double* const * w() const
     { return w_pointer.data(); }
@@ -112,9 +124,19 @@ namespace dolfin
 
   private:
 
+    // Restrict coefficient i to a cell, serialising the restriction
+    // between threads if the coefficient is not thread-safe
+    void restrict_coefficient(std::size_t i, double* w, const Cell& c,
+                              const double* coordinate_dofs,
+                              const ufc::cell& ufc_cell) const;
+
     // Finite elements for coefficients
     std::vector<FiniteElement> coefficient_elements;
 
+    // True for coefficients that must be restricted by one thread at
+    // a time (all but Expressions)
+    std::vector<bool> serial_coefficients;
+
     // Cell integrals (access through get_cell_integral to get proper
     // fallback to default)
     std::vector<std::shared_ptr<ufc::cell_integral>>
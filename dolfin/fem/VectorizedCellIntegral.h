@@ -0,0 +1,68 @@
+// Copyright (C) 2026 agent
+//
+// This file is part of DOLFIN.
+//
+// DOLFIN is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// DOLFIN is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with DOLFIN. If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef __VECTORIZED_CELL_INTEGRAL_H
+#define __VECTORIZED_CELL_INTEGRAL_H
+
+#include <cstddef>
+
+namespace dolfin
+{
+
+  /// This class defines the interface for cell integral kernels that
+  /// evaluate a fixed number of cells at once, typically one cell per
+  /// SIMD lane. A kernel is attached to a _Form_ with
+  /// Form::set_vectorized_cell_integral() and replaces the UFC cell
+  /// integral of the same subdomain during batched cell assembly
+  /// (see Assembler::cell_batch_size). Cells that do not fill a
+  /// complete set of lanes are tabulated with the UFC integral.
+  ///
+  /// All arrays are interleaved (lane-major): entry k of the cell in
+  /// lane l is stored at position k*num_lanes() + l. The layout of
+  /// the entries for a single cell is that of
+  /// ufc::cell_integral::tabulate_tensor.
+
+  class VectorizedCellIntegral
+  {
+  public:
+
+    /// Destructor
+    virtual ~VectorizedCellIntegral() {}
+
+    /// Return the number of cells that are evaluated together
+    virtual std::size_t num_lanes() const = 0;
+
+    /// Tabulate the cell tensors for num_lanes() cells
+    ///
+    /// @param[out] A (double*)
+    ///         The interleaved cell tensors.
+    /// @param[in] w (double**)
+    ///         The interleaved coefficients (one array per
+    ///         coefficient).
+    /// @param[in] coordinate_dofs (double*)
+    ///         The interleaved coordinate dofs.
+    /// @param[in] cell_orientations (int*)
+    ///         The orientation of each cell.
+    virtual void tabulate_tensor(double* A, const double* const* w,
+                                 const double* coordinate_dofs,
+                                 const int* cell_orientations) const = 0;
+
+  };
+
+}
+
+#endif
@@ -16,11 +16,13 @@
 // along with DOLFIN. If not, see <http://www.gnu.org/licenses/>.
 
 #include <dolfin/function/FunctionSpace.h>
+#include <dolfin/parameter/GlobalParameters.h>
 #include <dolfin/la/Scalar.h>
 #include <dolfin/mesh/Mesh.h>
 #include "Form.h"
 #include "MultiMeshForm.h"
 #include "Assembler.h"
+#include "OpenMpAssembler.h"
 #include "MixedAssembler.h"
 #include "SystemAssembler.h"
 #include "MultiMeshAssembler.h"
@@ -31,8 +33,18 @@ using namespace dolfin;
 //-----------------------------------------------------------------------------
 void dolfin::assemble(GenericTensor& A, const Form& a)
 {
-  Assembler assembler;
-  assembler.assemble(A, a);
+  // Use multithreaded assembler if requested
+  const int num_threads = parameters["num_threads"];
+  if (num_threads > 0)
+  {
+    OpenMpAssembler assembler;
+    assembler.assemble(A, a);
+  }
+  else
+  {
+    Assembler assembler;
+    assembler.assemble(A, a);
+  }
 }
 //-----------------------------------------------------------------------------
 void dolfin::assemble_mixed(GenericTensor& A, const Form& a, bool add)
@@ -18,11 +18,17 @@
 #include <dolfin/fem/LocalSolver.h>
 #include <dolfin/fem/solve.h>
 #include <dolfin/fem/Form.h>
+#include <dolfin/fem/FormLinearOperator.h>
 #include <dolfin/fem/AssemblerBase.h>
 #include <dolfin/fem/Assembler.h>
+#include <dolfin/fem/AssemblyPlan.h>
+#include <dolfin/fem/IncrementalAssembler.h>
+#include <dolfin/fem/OpenMpAssembler.h>
 #include <dolfin/fem/MixedAssembler.h>
 #include <dolfin/fem/SparsityPatternBuilder.h>
+#include <dolfin/fem/SumFactorizedOperator.h>
 #include <dolfin/fem/SystemAssembler.h>
+#include <dolfin/fem/VectorizedCellIntegral.h>
 #include <dolfin/fem/LinearVariationalProblem.h>
 #include <dolfin/fem/LinearVariationalSolver.h>
 #include <dolfin/fem/MixedLinearVariationalProblem.h>
@@ -26,6 +26,7 @@
 
 #include <dolfin/adaptivity/Extrapolation.h>
 #include <dolfin/common/Array.h>
+#include <dolfin/common/MPI.h>
 #include <dolfin/common/Timer.h>
 #include <dolfin/common/utils.h>
 #include <dolfin/fem/FiniteElement.h>
@@ -289,28 +290,7 @@ void Function::eval(Array<double>& values, const Array<double>& x) const
   // Find the cell that contains x
   const double* _x = x.data();
   const Point point(mesh.geometry().dim(), _x);
-
-  // Get index of first cell containing point
-  unsigned int id
-    = mesh.bounding_box_tree()->compute_first_entity_collision(point);
-
-  // If not found, use the closest cell
-  if (id == std::numeric_limits<unsigned int>::max())
-  {
-    // Check if the closest cell is within DOLFIN_EPS. This we can
-    // allow without _allow_extrapolation
-    std::pair<unsigned int, double> close
-      = mesh.bounding_box_tree()->compute_closest_entity(point);
-
-    if (_allow_extrapolation or close.second < DOLFIN_EPS)
-      id = close.first;
-    else
-    {
-      dolfin_error("Function.cpp",
-                   "evaluate function at point",
-                   "The point is not inside the domain. Consider calling \"Function::set_allow_extrapolation(true)\" on this Function to allow extrapolation");
-    }
-  }
+  const unsigned int id = find_cell(point);
 
   // Create cell that contains point
   const Cell cell(mesh, id);
@@ -365,6 +345,236 @@ void Function::eval(Array<double>& values, const Array<double>& x,
   }
 }
 //-----------------------------------------------------------------------------
+void Function::eval_points(std::vector<double>& values,
+                           const std::vector<double>& x) const
+{
+  dolfin_assert(_function_space);
+  dolfin_assert(_function_space->mesh());
+  const Mesh& mesh = *_function_space->mesh();
+  const std::size_t gdim = mesh.geometry().dim();
+
+  if (x.size() % gdim != 0)
+  {
+    dolfin_error("Function.cpp",
+                 "evaluate function at points",
+                 "Size of coordinate array (%d) is not a multiple of the geometric dimension (%d)",
+                 (int) x.size(), (int) gdim);
+  }
+  const std::size_t num_points = x.size()/gdim;
+
+  // Find the cell that contains each point. Consecutive points are
+  // often close, so the search walks from the cell of the previous
+  // point before searching the bounding box tree.
+  const BoundingBoxTree& tree = *mesh.bounding_box_tree();
+  std::vector<unsigned int> cells = tree.locate_cells(x);
+
+  // Points outside the mesh have been searched for in the tree
+  // already, so only check for a close cell
+  for (std::size_t i = 0; i < num_points; ++i)
+  {
+    if (cells[i] != std::numeric_limits<unsigned int>::max())
+      continue;
+
+    const Point point(gdim, x.data() + i*gdim);
+    std::pair<unsigned int, double> close = tree.compute_closest_entity(point);
+    if (_allow_extrapolation or close.second < DOLFIN_EPS)
+      cells[i] = close.first;
+    else
+    {
+      dolfin_error("Function.cpp",
+                   "evaluate function at point",
+                   "The point is not inside the domain. Consider calling \"Function::set_allow_extrapolation(true)\" on this Function to allow extrapolation");
+    }
+  }
+
+  eval_in_cells(values, x, cells);
+}
+//-----------------------------------------------------------------------------
+void Function::eval_points_collective(std::vector<double>& values,
+                                      const std::vector<double>& x) const
+{
+  dolfin_assert(_function_space);
+  dolfin_assert(_function_space->mesh());
+  const Mesh& mesh = *_function_space->mesh();
+  const std::size_t gdim = mesh.geometry().dim();
+  const MPI_Comm mpi_comm = mesh.mpi_comm();
+  const std::size_t num_processes = MPI::size(mpi_comm);
+
+  if (x.size() % gdim != 0)
+  {
+    dolfin_error("Function.cpp",
+                 "evaluate function at points",
+                 "Size of coordinate array (%d) is not a multiple of the geometric dimension (%d)",
+                 (int) x.size(), (int) gdim);
+  }
+  const std::size_t num_points = x.size()/gdim;
+
+  // Send each point to the processes whose bounding box contains
+  // it, keeping track of the local index of each sent point
+  std::shared_ptr<BoundingBoxTree> tree = mesh.bounding_box_tree();
+  std::vector<std::vector<double>> send_points(num_processes);
+  std::vector<std::vector<std::size_t>> send_indices(num_processes);
+  for (std::size_t i = 0; i < num_points; ++i)
+  {
+    const Point point(gdim, x.data() + i*gdim);
+    for (auto p : tree->compute_process_collisions(point))
+    {
+      send_points[p].insert(send_points[p].end(), x.data() + i*gdim,
+                            x.data() + (i + 1)*gdim);
+      send_indices[p].push_back(i);
+    }
+  }
+  std::vector<std::vector<double>> recv_points(num_processes);
+  MPI::all_to_all(mpi_comm, send_points, recv_points);
+
+  // Find an owned cell containing each received point. Points that
+  // are only contained in ghost cells are left to the owner of the
+  // cell.
+  const unsigned int not_found = std::numeric_limits<unsigned int>::max();
+  std::vector<double> points;
+  std::vector<unsigned int> cells;
+  std::vector<std::vector<unsigned int>> recv_cells(num_processes);
+  for (std::size_t p = 0; p < num_processes; ++p)
+  {
+    const std::size_t num_recv = recv_points[p].size()/gdim;
+    recv_cells[p].assign(num_recv, not_found);
+    for (std::size_t i = 0; i < num_recv; ++i)
+    {
+      const double* _x = recv_points[p].data() + i*gdim;
+      const Point point(gdim, _x);
+      for (auto c : tree->compute_entity_collisions(point))
+      {
+        if (!Cell(mesh, c).is_ghost())
+        {
+          recv_cells[p][i] = c;
+          points.insert(points.end(), _x, _x + gdim);
+          cells.push_back(c);
+          break;
+        }
+      }
+    }
+  }
+
+  // Evaluate at all found points at once
+  const std::size_t value_size_loc = value_size();
+  std::vector<double> found_values;
+  eval_in_cells(found_values, points, cells);
+
+  // Return a flag (1 if found, 0 otherwise) followed by the values
+  // for each received point
+  std::vector<std::vector<double>> send_values(num_processes);
+  std::size_t k = 0;
+  for (std::size_t p = 0; p < num_processes; ++p)
+  {
+    for (auto c : recv_cells[p])
+    {
+      if (c == not_found)
+        send_values[p].push_back(0.0);
+      else
+      {
+        send_values[p].push_back(1.0);
+        send_values[p].insert(send_values[p].end(),
+                              found_values.begin() + k*value_size_loc,
+                              found_values.begin() + (k + 1)*value_size_loc);
+        ++k;
+      }
+    }
+  }
+  std::vector<std::vector<double>> recv_values(num_processes);
+  MPI::all_to_all(mpi_comm, send_values, recv_values);
+
+  // Take the value of each point from the lowest ranked process that
+  // found it, so points on partition boundaries are resolved
+  // consistently
+  values.resize(num_points*value_size_loc);
+  std::vector<bool> found(num_points, false);
+  for (std::size_t p = 0; p < num_processes; ++p)
+  {
+    std::vector<double>::const_iterator v = recv_values[p].begin();
+    for (auto i : send_indices[p])
+    {
+      dolfin_assert(v != recv_values[p].end());
+      if (*v++ == 0.0)
+        continue;
+      if (!found[i])
+      {
+        std::copy(v, v + value_size_loc, values.begin() + i*value_size_loc);
+        found[i] = true;
+      }
+      v += value_size_loc;
+    }
+  }
+
+  for (std::size_t i = 0; i < num_points; ++i)
+  {
+    if (!found[i])
+    {
+      dolfin_error("Function.cpp",
+                   "evaluate function at points",
+                   "Point %d is not inside the domain on any process",
+                   (int) i);
+    }
+  }
+}
+//-----------------------------------------------------------------------------
+void Function::eval_in_cells(std::vector<double>& values,
+                             const std::vector<double>& x,
+                             const std::vector<unsigned int>& cells) const
+{
+  dolfin_assert(_function_space);
+  dolfin_assert(_function_space->mesh());
+  dolfin_assert(_function_space->element());
+  const Mesh& mesh = *_function_space->mesh();
+  const FiniteElement& element = *_function_space->element();
+  const std::size_t gdim = mesh.geometry().dim();
+  const std::size_t num_points = cells.size();
+  dolfin_assert(x.size() == num_points*gdim);
+
+  // Group points by cell
+  std::vector<std::size_t> order(num_points);
+  for (std::size_t i = 0; i < num_points; ++i)
+    order[i] = i;
+  std::stable_sort(order.begin(), order.end(),
+                   [&cells](std::size_t i, std::size_t j)
+                   { return cells[i] < cells[j]; });
+
+  // Evaluate at the points of each cell, restricting the function to
+  // the cell once
+  const std::size_t value_size_loc = value_size();
+  const std::size_t space_dimension = element.space_dimension();
+  values.resize(num_points*value_size_loc);
+  std::vector<double> coefficients(space_dimension);
+  std::vector<double> basis(space_dimension*value_size_loc);
+  std::vector<double> coordinate_dofs;
+  ufc::cell ufc_cell;
+  std::size_t k = 0;
+  while (k < num_points)
+  {
+    // Restrict function to cell
+    const unsigned int id = cells[order[k]];
+    const Cell cell(mesh, id);
+    cell.get_cell_data(ufc_cell);
+    cell.get_coordinate_dofs(coordinate_dofs);
+    restrict(coefficients.data(), element, cell, coordinate_dofs.data(),
+             ufc_cell);
+
+    // Compute linear combination at each point in cell
+    for (; k < num_points && cells[order[k]] == id; ++k)
+    {
+      const std::size_t i = order[k];
+      element.evaluate_basis_all(basis.data(), x.data() + i*gdim,
+                                 coordinate_dofs.data(),
+                                 ufc_cell.orientation);
+
+      double* _values = values.data() + i*value_size_loc;
+      std::fill(_values, _values + value_size_loc, 0.0);
+      for (std::size_t d = 0; d < space_dimension; ++d)
+        for (std::size_t j = 0; j < value_size_loc; ++j)
+          _values[j] += coefficients[d]*basis[d*value_size_loc + j];
+    }
+  }
+}
+//-----------------------------------------------------------------------------
 void Function::eval(Eigen::Ref<Eigen::VectorXd> values,
                     Eigen::Ref<const Eigen::VectorXd> x) const
 {
@@ -638,3 +848,33 @@ void Function::init_vector()
   _vector->zero();
 }
 //-----------------------------------------------------------------------------
+unsigned int Function::find_cell(const Point& point) const
+{
+  dolfin_assert(_function_space->mesh());
+  const Mesh& mesh = *_function_space->mesh();
+
+  // Get index of first cell containing point
+  unsigned int id
+    = mesh.bounding_box_tree()->compute_first_entity_collision(point);
+
+  // If not found, use the closest cell
+  if (id == std::numeric_limits<unsigned int>::max())
+  {
+    // Check if the closest cell is within DOLFIN_EPS. This we can
+    // allow without _allow_extrapolation
+    std::pair<unsigned int, double> close
+      = mesh.bounding_box_tree()->compute_closest_entity(point);
+
+    if (_allow_extrapolation or close.second < DOLFIN_EPS)
+      id = close.first;
+    else
+    {
+      dolfin_error("Function.cpp",
+                   "evaluate function at point",
+                   "The point is not inside the domain. Consider calling \"Function::set_allow_extrapolation(true)\" on this Function to allow extrapolation");
+    }
+  }
+
+  return id;
+}
+//-----------------------------------------------------------------------------
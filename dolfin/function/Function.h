@@ -49,6 +49,7 @@ namespace dolfin
   class Expression;
   class FunctionSpace;
   class GenericVector;
+  class Point;
   class SubDomain;
   template<typename T> class Array;
 
@@ -239,6 +240,35 @@ namespace dolfin
               Eigen::Ref<const Eigen::VectorXd> x,
               const dolfin::Cell& dolfin_cell, const ufc::cell& ufc_cell) const;
 
+    /// Evaluate function at a list of points. The cell of each point
+    /// is found by first checking the cell of the previous point and
+    /// its facet neighbours, so lists of nearby points (e.g. along a
+    /// line or particle paths) are cheap to locate. The function is
+    /// restricted once for each cell that contains points.
+    ///
+    /// @param    values (std::vector<double>)
+    ///         The values (value_size() values per point).
+    /// @param    x (std::vector<double>)
+    ///         The coordinates (geometric dimension values per point).
+    void eval_points(std::vector<double>& values,
+                     const std::vector<double>& x) const;
+
+    /// Evaluate function at a list of points given on any process
+    /// (collective). Each point is sent to the processes whose mesh
+    /// bounding box contains it, evaluated in an owned cell there and
+    /// the values are returned to the calling process. A point on a
+    /// partition boundary takes the value from the lowest ranked
+    /// process that owns a cell containing it. It is an error if a
+    /// point is not inside the domain; extrapolation is not
+    /// supported.
+    ///
+    /// @param    values (std::vector<double>)
+    ///         The values (value_size() values per point).
+    /// @param    x (std::vector<double>)
+    ///         The coordinates (geometric dimension values per point).
+    void eval_points_collective(std::vector<double>& values,
+                                const std::vector<double>& x) const;
+
     /// Interpolate function (on possibly non-matching meshes)
     ///
     /// @param    v (GenericFunction)
@@ -361,6 +391,16 @@ namespace dolfin
     // Initialize vector
     void init_vector();
 
+    // Find cell containing point, or the closest cell if
+    // extrapolation is allowed
+    unsigned int find_cell(const Point& point) const;
+
+    // Evaluate function at points in the given cells (one cell per
+    // point)
+    void eval_in_cells(std::vector<double>& values,
+                       const std::vector<double>& x,
+                       const std::vector<unsigned int>& cells) const;
+
     // The function space
     std::shared_ptr<const FunctionSpace> _function_space;
 
@@ -18,10 +18,17 @@
 // First added:  2013-04-09
 // Last changed: 2014-05-12
 
+#include <algorithm>
+#include <limits>
 #include <dolfin/common/NoDeleter.h>
+#include <dolfin/common/utils.h>
 #include <dolfin/geometry/Point.h>
 #include <dolfin/log/log.h>
+#include <dolfin/mesh/Cell.h>
 #include <dolfin/mesh/Mesh.h>
+#include <dolfin/mesh/MeshConnectivity.h>
+#include <dolfin/mesh/MeshGeometry.h>
+#include <dolfin/mesh/MeshTopology.h>
 #include "BoundingBoxTree1D.h"
 #include "BoundingBoxTree2D.h"
 #include "BoundingBoxTree3D.h"
@@ -29,6 +36,141 @@
 
 using namespace dolfin;
 
+namespace
+{
+  // Maximum number of cells visited by a walk before falling back to
+  // searching the tree
+  const std::size_t max_walk_steps = 64;
+
+  // Compute barycentric coordinates of point x with respect to the
+  // simplex with vertices v (tdim == gdim). Returns false if the
+  // simplex is degenerate.
+  bool barycentric_coordinates(double* lambda, const double* const* v,
+                               const double* x, std::size_t tdim)
+  {
+    switch (tdim)
+    {
+    case 1:
+    {
+      const double det = v[1][0] - v[0][0];
+      if (det == 0.0)
+        return false;
+      lambda[1] = (x[0] - v[0][0])/det;
+      lambda[0] = 1.0 - lambda[1];
+      return true;
+    }
+    case 2:
+    {
+      const double a[2] = {v[1][0] - v[0][0], v[1][1] - v[0][1]};
+      const double b[2] = {v[2][0] - v[0][0], v[2][1] - v[0][1]};
+      const double r[2] = {x[0] - v[0][0], x[1] - v[0][1]};
+      const double det = a[0]*b[1] - a[1]*b[0];
+      if (det == 0.0)
+        return false;
+      lambda[1] = (r[0]*b[1] - r[1]*b[0])/det;
+      lambda[2] = (a[0]*r[1] - a[1]*r[0])/det;
+      lambda[0] = 1.0 - lambda[1] - lambda[2];
+      return true;
+    }
+    case 3:
+    {
+      double a[3], b[3], c[3], r[3];
+      for (std::size_t i = 0; i < 3; ++i)
+      {
+        a[i] = v[1][i] - v[0][i];
+        b[i] = v[2][i] - v[0][i];
+        c[i] = v[3][i] - v[0][i];
+        r[i] = x[i] - v[0][i];
+      }
+
+      // Solve by Cramer's rule using triple products
+      auto triple = [](const double* p, const double* q, const double* w)
+        {
+          return p[0]*(q[1]*w[2] - q[2]*w[1])
+            - p[1]*(q[0]*w[2] - q[2]*w[0])
+            + p[2]*(q[0]*w[1] - q[1]*w[0]);
+        };
+      const double det = triple(a, b, c);
+      if (det == 0.0)
+        return false;
+      lambda[1] = triple(r, b, c)/det;
+      lambda[2] = triple(a, r, c)/det;
+      lambda[3] = triple(a, b, r)/det;
+      lambda[0] = 1.0 - lambda[1] - lambda[2] - lambda[3];
+      return true;
+    }
+    default:
+      return false;
+    }
+  }
+
+  // Walk from cell towards point. Returns the cell containing the
+  // point, or std::numeric_limits<unsigned int>::max() if the walk
+  // fails (leaves the local mesh, hits a degenerate cell or takes
+  // too many steps).
+  unsigned int walk(const Mesh& mesh, const Point& point, unsigned int cell)
+  {
+    const unsigned int not_found = std::numeric_limits<unsigned int>::max();
+    const std::size_t tdim = mesh.topology().dim();
+    const MeshGeometry& geometry = mesh.geometry();
+    const MeshConnectivity& cell_vertices = mesh.topology()(tdim, 0);
+    const MeshConnectivity& cell_facets = mesh.topology()(tdim, tdim - 1);
+    const MeshConnectivity& facet_cells = mesh.topology()(tdim - 1, tdim);
+
+    const double* v[4];
+    double lambda[4];
+    for (std::size_t step = 0; step < max_walk_steps; ++step)
+    {
+      // Compute barycentric coordinates of point in current cell
+      const unsigned int* vertices = cell_vertices(cell);
+      for (std::size_t i = 0; i < tdim + 1; ++i)
+        v[i] = geometry.x(vertices[i]);
+      if (!barycentric_coordinates(lambda, v, point.coordinates(), tdim))
+        return not_found;
+
+      // Find vertex with the most negative barycentric coordinate. If
+      // there is none, the point is (up to round-off) in the cell,
+      // which is checked with the exact predicates.
+      std::size_t i_min = 0;
+      for (std::size_t i = 1; i < tdim + 1; ++i)
+      {
+        if (lambda[i] < lambda[i_min])
+          i_min = i;
+      }
+      if (lambda[i_min] >= 0.0)
+        return Cell(mesh, cell).collides(point) ? cell : not_found;
+
+      // Find facet opposite to the vertex (the other vertex of an
+      // interval)
+      unsigned int facet = not_found;
+      if (tdim == 1)
+        facet = vertices[1 - i_min];
+      else
+      {
+        const MeshConnectivity& facet_vertices = mesh.topology()(tdim - 1, 0);
+        const unsigned int* facets = cell_facets(cell);
+        for (std::size_t j = 0; j < tdim + 1 && facet == not_found; ++j)
+        {
+          const unsigned int* fv = facet_vertices(facets[j]);
+          if (std::find(fv, fv + tdim, vertices[i_min]) == fv + tdim)
+            facet = facets[j];
+        }
+      }
+      dolfin_assert(facet != not_found);
+
+      // Stop at the boundary of the local mesh
+      if (facet_cells.size(facet) != 2)
+        return not_found;
+
+      // Step to neighbour across facet
+      const unsigned int* fc = facet_cells(facet);
+      cell = fc[0] == cell ? fc[1] : fc[0];
+    }
+
+    return not_found;
+  }
+}
+
 //-----------------------------------------------------------------------------
 BoundingBoxTree::BoundingBoxTree() : _mesh(0)
 {
@@ -84,6 +226,21 @@ void BoundingBoxTree::build(const std::vector<Point>& points, std::size_t gdim)
   _tree->build(points);
 }
 //-----------------------------------------------------------------------------
+bool BoundingBoxTree::refit(double max_quality_ratio)
+{
+  // Check that tree has been built
+  _check_built();
+  if (!_mesh)
+  {
+    dolfin_error("BoundingBoxTree.cpp",
+                 "refit bounding box tree",
+                 "Bounding box tree has not been built for a mesh");
+  }
+
+  // Delegate call to implementation
+  return _tree->refit(*_mesh, max_quality_ratio);
+}
+//-----------------------------------------------------------------------------
 std::vector<unsigned int>
 BoundingBoxTree::compute_collisions(const Point& point) const
 {
@@ -167,6 +324,84 @@ BoundingBoxTree::compute_first_entity_collision(const Point& point) const
   return _tree->compute_first_entity_collision(point, *_mesh);
 }
 //-----------------------------------------------------------------------------
+std::vector<unsigned int>
+BoundingBoxTree::compute_first_entity_collisions(const std::vector<double>& x) const
+{
+  // Check that tree has been built
+  _check_built();
+
+  // Delegate call to implementation
+  dolfin_assert(_tree);
+  dolfin_assert(_mesh);
+  return _tree->compute_first_entity_collisions(x, *_mesh);
+}
+//-----------------------------------------------------------------------------
+unsigned int BoundingBoxTree::locate_cell(const Point& point,
+                                          unsigned int hint) const
+{
+  const bool can_walk = _init_walk();
+  return _locate_cell(point, hint, can_walk);
+}
+//-----------------------------------------------------------------------------
+std::vector<unsigned int>
+BoundingBoxTree::locate_cells(const std::vector<double>& x,
+                              const std::vector<unsigned int>& hints) const
+{
+  const bool can_walk = _init_walk();
+
+  const std::size_t gdim = _mesh->geometry().dim();
+  const std::size_t num_points = hints.size();
+  if (x.size() != gdim*num_points)
+  {
+    dolfin_error("BoundingBoxTree.cpp",
+                 "locate cells containing points",
+                 "Size of coordinate array (%d) does not match number of hints (%d)",
+                 (int) x.size(), (int) num_points);
+  }
+
+  std::vector<unsigned int> cells(num_points);
+  #ifdef HAS_OPENMP
+  #pragma omp parallel for schedule(dynamic, 64) num_threads(dolfin::num_threads())
+  #endif
+  for (std::size_t i = 0; i < num_points; ++i)
+  {
+    const Point point(gdim, x.data() + i*gdim);
+    cells[i] = _locate_cell(point, hints[i], can_walk);
+  }
+
+  return cells;
+}
+//-----------------------------------------------------------------------------
+std::vector<unsigned int>
+BoundingBoxTree::locate_cells(const std::vector<double>& x) const
+{
+  const bool can_walk = _init_walk();
+
+  const std::size_t gdim = _mesh->geometry().dim();
+  if (x.size() % gdim != 0)
+  {
+    dolfin_error("BoundingBoxTree.cpp",
+                 "locate cells containing points",
+                 "Size of coordinate array (%d) is not a multiple of the geometric dimension (%d)",
+                 (int) x.size(), (int) gdim);
+  }
+  const std::size_t num_points = x.size()/gdim;
+
+  // Walk from the cell of the previous point (or from the previous
+  // hint if the point was not found)
+  std::vector<unsigned int> cells(num_points);
+  unsigned int hint = std::numeric_limits<unsigned int>::max();
+  for (std::size_t i = 0; i < num_points; ++i)
+  {
+    const Point point(gdim, x.data() + i*gdim);
+    cells[i] = _locate_cell(point, hint, can_walk);
+    if (cells[i] != std::numeric_limits<unsigned int>::max())
+      hint = cells[i];
+  }
+
+  return cells;
+}
+//-----------------------------------------------------------------------------
 std::pair<unsigned int, double>
 BoundingBoxTree::compute_closest_entity(const Point& point) const
 {
@@ -190,6 +425,32 @@ BoundingBoxTree::compute_closest_point(const Point& point) const
   return _tree->compute_closest_point(point);
 }
 //-----------------------------------------------------------------------------
+std::pair<std::vector<unsigned int>, std::vector<double>>
+BoundingBoxTree::compute_closest_entities(const std::vector<double>& x,
+                                          std::size_t k) const
+{
+  // Check that tree has been built
+  _check_built();
+
+  // Delegate call to implementation
+  dolfin_assert(_tree);
+  std::pair<std::vector<unsigned int>, std::vector<double>> closest;
+  _tree->compute_closest_entities(x, k, _mesh, closest.first, closest.second);
+  return closest;
+}
+//-----------------------------------------------------------------------------
+std::vector<std::vector<unsigned int>>
+BoundingBoxTree::compute_entities_within_radius(const std::vector<double>& x,
+                                                double radius) const
+{
+  // Check that tree has been built
+  _check_built();
+
+  // Delegate call to implementation
+  dolfin_assert(_tree);
+  return _tree->compute_entities_within_radius(x, radius, _mesh);
+}
+//-----------------------------------------------------------------------------
 bool BoundingBoxTree::collides(const Point& point) const
 {
   return compute_first_collision(point) != std::numeric_limits<unsigned int>::max();
@@ -200,6 +461,52 @@ bool BoundingBoxTree::collides_entity(const Point& point) const
   return compute_first_entity_collision(point) != std::numeric_limits<unsigned int>::max();
 }
 //-----------------------------------------------------------------------------
+bool BoundingBoxTree::_init_walk() const
+{
+  // Check that tree has been built
+  _check_built();
+  dolfin_assert(_tree);
+
+  if (!_mesh or _tree->tdim() != _mesh->topology().dim())
+  {
+    dolfin_error("BoundingBoxTree.cpp",
+                 "locate cells containing points",
+                 "Bounding box tree has not been built for the cells of a mesh");
+  }
+
+  // Walking requires simplices with barycentric coordinates in the
+  // geometric dimension
+  const Mesh& mesh = *_mesh;
+  const std::size_t tdim = mesh.topology().dim();
+  if (!mesh.type().is_simplex() or tdim != mesh.geometry().dim() or tdim == 0)
+    return false;
+
+  // Compute cell-facet-cell connectivity
+  if (tdim > 1)
+  {
+    mesh.init(tdim - 1, 0);
+    mesh.init(tdim, tdim - 1);
+  }
+  mesh.init(tdim - 1, tdim);
+  return true;
+}
+//-----------------------------------------------------------------------------
+unsigned int BoundingBoxTree::_locate_cell(const Point& point,
+                                           unsigned int hint,
+                                           bool can_walk) const
+{
+  dolfin_assert(_mesh);
+  unsigned int cell = std::numeric_limits<unsigned int>::max();
+  if (can_walk and hint < _mesh->num_cells())
+    cell = walk(*_mesh, point, hint);
+
+  // Fall back to searching the tree
+  if (cell == std::numeric_limits<unsigned int>::max())
+    cell = _tree->compute_first_entity_collision(point, *_mesh);
+
+  return cell;
+}
+//-----------------------------------------------------------------------------
 void BoundingBoxTree::_check_built() const
 {
   if (!_tree)
@@ -73,6 +73,25 @@ namespace dolfin
     ///         The geometric dimension.
     void build(const std::vector<Point>& points, std::size_t gdim);
 
+    /// Update bounding box tree after the vertices of the mesh have
+    /// moved (e.g. by ALE::move), without changing the mesh topology.
+    /// The bounding boxes are recomputed bottom-up in linear time,
+    /// keeping the tree structure. The tree is rebuilt if its quality
+    /// (the sum of the surface areas of the non-leaf bounding boxes
+    /// relative to the root bounding box) has grown by more than the
+    /// given factor since it was built. This is collective in
+    /// parallel.
+    ///
+    /// *Arguments*
+    ///     max_quality_ratio (double)
+    ///         The largest allowed growth of the quality measure
+    ///         before the tree is rebuilt (default 2.0).
+    ///
+    /// *Returns*
+    ///     bool
+    ///         True if the tree was rebuilt.
+    bool refit(double max_quality_ratio=2.0);
+
     /// Compute all collisions between bounding boxes and _Point_.
     ///
     /// *Returns*
@@ -198,6 +217,86 @@ namespace dolfin
     unsigned int
     compute_first_entity_collision(const Point& point) const;
 
+    /// Compute first collision between entities and each point of a
+    /// list of points. Points are traversed through the tree in
+    /// packets, and packets are distributed over threads if DOLFIN
+    /// is built with OpenMP. The result for each point is the same as
+    /// for compute_first_entity_collision.
+    ///
+    /// *Returns*
+    ///     std::vector<unsigned int>
+    ///         The local index for the first found entity that
+    ///         collides with (intersects) each point. If not found,
+    ///         std::numeric_limits<unsigned int>::max() is returned
+    ///         for the point.
+    ///
+    /// *Arguments*
+    ///     x (std::vector<double>)
+    ///         The point coordinates (gdim values per point).
+    std::vector<unsigned int>
+    compute_first_entity_collisions(const std::vector<double>& x) const;
+
+    /// Compute a cell that contains a point, starting from a hint
+    /// cell, for example the cell that contained a particle before
+    /// it moved. The search walks from cell to cell across the facet
+    /// opposite the vertex with the most negative barycentric
+    /// coordinate of the point. The tree is only searched if the walk
+    /// reaches the boundary of the local mesh, does not terminate
+    /// within a small number of steps, or if the mesh is not a
+    /// simplex mesh with equal topological and geometric dimension.
+    /// The tree must have been built for the cells of a mesh.
+    ///
+    /// *Returns*
+    ///     unsigned int
+    ///         The local index of a cell that collides with
+    ///         (contains) the point. If not found,
+    ///         std::numeric_limits<unsigned int>::max() is returned.
+    ///
+    /// *Arguments*
+    ///     point (_Point_)
+    ///         The point.
+    ///     hint (unsigned int)
+    ///         The local index of the cell to start from (the tree is
+    ///         searched if std::numeric_limits<unsigned int>::max()).
+    unsigned int locate_cell(const Point& point, unsigned int hint) const;
+
+    /// Compute a cell that contains each point of a list of points,
+    /// starting from a hint cell for each point (see locate_cell).
+    /// Points are distributed over threads if DOLFIN is built with
+    /// OpenMP.
+    ///
+    /// *Returns*
+    ///     std::vector<unsigned int>
+    ///         The local index of a cell that contains each point. If
+    ///         not found, std::numeric_limits<unsigned int>::max()
+    ///         is returned for the point.
+    ///
+    /// *Arguments*
+    ///     x (std::vector<double>)
+    ///         The point coordinates (gdim values per point).
+    ///     hints (std::vector<unsigned int>)
+    ///         The cell to start from for each point.
+    std::vector<unsigned int>
+    locate_cells(const std::vector<double>& x,
+                 const std::vector<unsigned int>& hints) const;
+
+    /// Compute a cell that contains each point of a list of points,
+    /// starting from the cell of the previous point (see
+    /// locate_cell). This is efficient for sequences of nearby
+    /// points. Points are processed in order.
+    ///
+    /// *Returns*
+    ///     std::vector<unsigned int>
+    ///         The local index of a cell that contains each point. If
+    ///         not found, std::numeric_limits<unsigned int>::max()
+    ///         is returned for the point.
+    ///
+    /// *Arguments*
+    ///     x (std::vector<double>)
+    ///         The point coordinates (gdim values per point).
+    std::vector<unsigned int>
+    locate_cells(const std::vector<double>& x) const;
+
     /// Compute closest entity to _Point_.
     ///
     /// *Returns*
@@ -240,6 +339,53 @@ namespace dolfin
     std::pair<unsigned int, double>
     compute_closest_point(const Point& point) const;
 
+    /// Compute the k closest entities to each point of a list of
+    /// points. For a tree built for a point cloud, the entities are
+    /// the points. Distances to mesh entities are only implemented
+    /// for cells and vertices. Points are distributed over threads if
+    /// DOLFIN is built with OpenMP. The search is local to this
+    /// process.
+    ///
+    /// *Returns*
+    ///     std::vector<unsigned int>
+    ///         The local indices of the k closest entities of each
+    ///         point (k values per point), sorted by distance. If the
+    ///         tree contains fewer than k entities, the remaining
+    ///         values are std::numeric_limits<unsigned int>::max().
+    ///     std::vector<double>
+    ///         The corresponding distances (infinite for missing
+    ///         entities).
+    ///
+    /// *Arguments*
+    ///     x (std::vector<double>)
+    ///         The point coordinates (gdim values per point).
+    ///     k (std::size_t)
+    ///         The number of entities to find for each point.
+    std::pair<std::vector<unsigned int>, std::vector<double>>
+    compute_closest_entities(const std::vector<double>& x,
+                             std::size_t k) const;
+
+    /// Compute all entities within given distance of each point of a
+    /// list of points. For a tree built for a point cloud, the
+    /// entities are the points. Distances to mesh entities are only
+    /// implemented for cells and vertices. Points are distributed
+    /// over threads if DOLFIN is built with OpenMP. The search is
+    /// local to this process.
+    ///
+    /// *Returns*
+    ///     std::vector<std::vector<unsigned int>>
+    ///         The local indices of the entities within the distance
+    ///         of each point (in no particular order).
+    ///
+    /// *Arguments*
+    ///     x (std::vector<double>)
+    ///         The point coordinates (gdim values per point).
+    ///     radius (double)
+    ///         The distance.
+    std::vector<std::vector<unsigned int>>
+    compute_entities_within_radius(const std::vector<double>& x,
+                                   double radius) const;
+
     /// Check whether given point collides with the bounding box tree.
     /// This is equivalent to calling compute_first_collision and
     /// checking whether any collision was detected.
@@ -264,6 +410,15 @@ namespace dolfin
     // Check that tree has been built
     void _check_built() const;
 
+    // Check that tree has been built for cells and initialise the
+    // connectivity used by locate_cell. Returns false if cells
+    // cannot be located by walking.
+    bool _init_walk() const;
+
+    // Locate cell containing point, walking from hint if possible
+    unsigned int _locate_cell(const Point& point, unsigned int hint,
+                              bool can_walk) const;
+
     // Dimension-dependent implementation
     std::shared_ptr<GenericBoundingBoxTree> _tree;
 
@@ -71,6 +71,21 @@ namespace dolfin
       return b[0] - eps <= x[0] && x[0] <= b[1] + eps;
     }
 
+    /// Check which points of a packet are in bounding box (node)
+    void points_in_bbox(const double* x, std::size_t num_points,
+                        const unsigned char* active, unsigned char* inside,
+                        unsigned int node) const
+    {
+      const double* b = _bbox_coordinates.data() + 2*node;
+      const double eps = DOLFIN_EPS_LARGE*(b[1] - b[0]);
+      const double b0 = b[0] - eps;
+      const double b1 = b[1] + eps;
+
+      // Branch-free to allow vectorisation
+      for (std::size_t p = 0; p < num_points; ++p)
+        inside[p] = active[p] & (b0 <= x[p]) & (x[p] <= b1);
+    }
+
     /// Check whether bounding box (a) collides with bounding box (node)
     bool bbox_in_bbox(const double* a, unsigned int node) const
     {
@@ -94,6 +94,28 @@ namespace dolfin
               b[1] - eps1 <= x[1] && x[1] <= b[3] + eps1);
     }
 
+    /// Check which points of a packet are in bounding box (node)
+    void points_in_bbox(const double* x, std::size_t num_points,
+                        const unsigned char* active, unsigned char* inside,
+                        unsigned int node) const
+    {
+      const double* b = _bbox_coordinates.data() + 4*node;
+      const double eps0 = DOLFIN_EPS_LARGE*(b[2] - b[0]);
+      const double eps1 = DOLFIN_EPS_LARGE*(b[3] - b[1]);
+      const double b0 = b[0] - eps0, b2 = b[2] + eps0;
+      const double b1 = b[1] - eps1, b3 = b[3] + eps1;
+      const double* x0 = x;
+      const double* x1 = x + num_points;
+
+      // Branch-free to allow vectorisation
+      for (std::size_t p = 0; p < num_points; ++p)
+      {
+        inside[p] = active[p]
+          & (b0 <= x0[p]) & (x0[p] <= b2)
+          & (b1 <= x1[p]) & (x1[p] <= b3);
+      }
+    }
+
     /// Check whether bounding box (a) collides with bounding box (node)
     bool bbox_in_bbox(const double* a, unsigned int node) const
     {
@@ -18,6 +18,7 @@
 // First added:  2014-02-03
 // Last changed: 2017-10-09
 
+#include <dolfin/mesh/Mesh.h>
 #include <dolfin/mesh/MeshEntity.h>
 #include <dolfin/mesh/CellType.h>
 #include "predicates.h"
@@ -189,6 +190,166 @@ bool CollisionPredicates::collides(const MeshEntity& entity_0,
   return false;
 }
 //-----------------------------------------------------------------------------
+std::vector<bool>
+CollisionPredicates::collides(const Mesh& mesh_0,
+                              const std::vector<unsigned int>& cells_0,
+                              const Mesh& mesh_1,
+                              const std::vector<unsigned int>& cells_1)
+{
+  dolfin_assert(cells_0.size() == cells_1.size());
+  const std::size_t num_pairs = cells_0.size();
+  const std::size_t tdim = mesh_0.topology().dim();
+  const std::size_t gdim = mesh_0.geometry().dim();
+  std::vector<bool> collisions(num_pairs, false);
+
+  // Check pairs one by one unless both meshes consist of triangles
+  // in 2D or tetrahedra in 3D
+  const bool batched = mesh_0.type().is_simplex()
+    and mesh_1.type().is_simplex()
+    and (gdim == 2 or gdim == 3)
+    and tdim == gdim
+    and mesh_1.topology().dim() == tdim
+    and mesh_1.geometry().dim() == gdim;
+  if (!batched)
+  {
+    for (std::size_t k = 0; k < num_pairs; k++)
+    {
+      collisions[k] = collides(MeshEntity(mesh_0, tdim, cells_0[k]),
+                               MeshEntity(mesh_1, tdim, cells_1[k]));
+    }
+    return collisions;
+  }
+
+  // Faces of a simplex, ordered such that a point x is inside the
+  // simplex if the orientation of (face, x) has the same sign as the
+  // orientation of the simplex (or is zero) for all faces
+  const std::size_t num_vertices = gdim + 1;
+  const std::size_t faces_2d[3][3] = {{1, 2, 0}, {2, 0, 0}, {0, 1, 0}};
+  const std::size_t faces_3d[4][3] = {{0, 1, 2}, {0, 3, 1}, {0, 2, 3},
+                                      {1, 3, 2}};
+
+  // Orientations computed for each pair: the two simplices, the
+  // faces of cell 0 with the vertices of cell 1 and the faces of
+  // cell 1 with the vertices of cell 0
+  const std::size_t num_orientations = 2 + 2*num_vertices*num_vertices;
+
+  // Pack the points of all orientations (argument j of orientation
+  // i is stored at args[j][i*gdim])
+  std::vector<std::vector<double>> args(num_vertices);
+  for (std::size_t j = 0; j < num_vertices; j++)
+    args[j].reserve(num_pairs*num_orientations*gdim);
+  std::vector<const double*> x(num_vertices);
+  auto add = [&args, &x, gdim, num_vertices]()
+    {
+      for (std::size_t j = 0; j < num_vertices; j++)
+        args[j].insert(args[j].end(), x[j], x[j] + gdim);
+    };
+
+  const MeshGeometry& g0 = mesh_0.geometry();
+  const MeshGeometry& g1 = mesh_1.geometry();
+  std::vector<const double*> v0(num_vertices), v1(num_vertices);
+  for (std::size_t k = 0; k < num_pairs; k++)
+  {
+    const unsigned int* e0 = MeshEntity(mesh_0, tdim, cells_0[k]).entities(0);
+    const unsigned int* e1 = MeshEntity(mesh_1, tdim, cells_1[k]).entities(0);
+    for (std::size_t i = 0; i < num_vertices; i++)
+    {
+      v0[i] = g0.x(e0[i]);
+      v1[i] = g1.x(e1[i]);
+    }
+
+    // Orientation of the simplices
+    x = v0;
+    add();
+    x = v1;
+    add();
+
+    // Faces of one simplex with the vertices of the other
+    for (std::size_t s = 0; s < 2; s++)
+    {
+      const std::vector<const double*>& p = s == 0 ? v0 : v1;
+      const std::vector<const double*>& q = s == 0 ? v1 : v0;
+      for (std::size_t f = 0; f < num_vertices; f++)
+      {
+        for (std::size_t j = 0; j < gdim; j++)
+          x[j] = p[gdim == 2 ? faces_2d[f][j] : faces_3d[f][j]];
+        for (std::size_t i = 0; i < num_vertices; i++)
+        {
+          x[gdim] = q[i];
+          add();
+        }
+      }
+    }
+  }
+
+  // Compute all orientations
+  std::vector<double> orientations(num_pairs*num_orientations);
+  if (gdim == 2)
+  {
+    orient2d_batch(args[0].data(), args[1].data(), args[2].data(),
+                   orientations.data(), orientations.size());
+  }
+  else
+  {
+    orient3d_batch(args[0].data(), args[1].data(), args[2].data(),
+                   args[3].data(), orientations.data(),
+                   orientations.size());
+  }
+
+  // Decide each pair from the vertex containment and face separation
+  // tests, or check the pair with the full predicate
+  for (std::size_t k = 0; k < num_pairs; k++)
+  {
+    const double* o = orientations.data() + k*num_orientations;
+    bool decided = false;
+    if (o[0] != 0.0 and o[1] != 0.0)
+    {
+      for (std::size_t s = 0; s < 2 and !decided; s++)
+      {
+        // Orientations of faces of one simplex with the vertices of
+        // the other, relative to the orientation of the simplex
+        const double sign = o[s] > 0.0 ? 1.0 : -1.0;
+        const double* of = o + 2 + s*num_vertices*num_vertices;
+
+        // A vertex is inside if it is not outside any face
+        for (std::size_t i = 0; i < num_vertices and !decided; i++)
+        {
+          bool inside = true;
+          for (std::size_t f = 0; f < num_vertices; f++)
+            inside = inside and sign*of[f*num_vertices + i] >= 0.0;
+          if (inside)
+          {
+            collisions[k] = true;
+            decided = true;
+          }
+        }
+
+        // The simplices are separated if all vertices are strictly
+        // outside one face
+        for (std::size_t f = 0; f < num_vertices and !decided; f++)
+        {
+          bool outside = true;
+          for (std::size_t i = 0; i < num_vertices; i++)
+            outside = outside and sign*of[f*num_vertices + i] < 0.0;
+          if (outside)
+          {
+            collisions[k] = false;
+            decided = true;
+          }
+        }
+      }
+    }
+
+    if (!decided)
+    {
+      collisions[k] = collides(MeshEntity(mesh_0, tdim, cells_0[k]),
+                               MeshEntity(mesh_1, tdim, cells_1[k]));
+    }
+  }
+
+  return collisions;
+}
+//-----------------------------------------------------------------------------
 // Low-level collision detection predicates
 //-----------------------------------------------------------------------------
 bool CollisionPredicates::collides_segment_point(const Point& p0,
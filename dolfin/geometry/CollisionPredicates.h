@@ -21,11 +21,14 @@
 #ifndef __COLLISION_PREDICATES_H
 #define __COLLISION_PREDICATES_H
 
+#include <vector>
+
 namespace dolfin
 {
 
   // Forward declarations
   class Point;
+  class Mesh;
   class MeshEntity;
 
   /// This class implements algorithms for detecting pairwise
@@ -65,6 +68,32 @@ namespace dolfin
     static bool collides(const MeshEntity& entity_0,
                          const MeshEntity& entity_1);
 
+    /// Check whether pairs of cells collide. For simplex cells with
+    /// equal topological and geometric dimension (triangles in 2D
+    /// and tetrahedra in 3D), the orientations needed for the vertex
+    /// containment and face separation tests of all pairs are
+    /// computed together by orient2d_batch/orient3d_batch. Only the
+    /// pairs that are not decided by these tests are checked one by
+    /// one with collides(entity_0, entity_1).
+    ///
+    /// *Arguments*
+    ///     mesh_0 (_Mesh_)
+    ///         The mesh of the first cell of each pair.
+    ///     cells_0 (std::vector<unsigned int>)
+    ///         The first cell of each pair.
+    ///     mesh_1 (_Mesh_)
+    ///         The mesh of the second cell of each pair.
+    ///     cells_1 (std::vector<unsigned int>)
+    ///         The second cell of each pair.
+    ///
+    /// *Returns*
+    ///     std::vector<bool>
+    ///         True for each pair of cells that collide.
+    static std::vector<bool> collides(const Mesh& mesh_0,
+                                      const std::vector<unsigned int>& cells_0,
+                                      const Mesh& mesh_1,
+                                      const std::vector<unsigned int>& cells_1);
+
     //--- Low-level collision detection predicates ---
 
     /// Check whether segment p0-p1 collides with point
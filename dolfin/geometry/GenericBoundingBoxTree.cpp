@@ -23,7 +23,16 @@
 // recursion and is more convenient than sending it around.
 #define MAX_DIM 6
 
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#ifdef HAS_OPENMP
+#include <omp.h>
+#endif
+
 #include <dolfin/common/MPI.h>
+#include <dolfin/common/utils.h>
+#include <dolfin/parameter/GlobalParameters.h>
 #include <dolfin/geometry/Point.h>
 #include <dolfin/mesh/Mesh.h>
 #include <dolfin/mesh/Cell.h>
@@ -37,7 +46,7 @@
 using namespace dolfin;
 
 //-----------------------------------------------------------------------------
-GenericBoundingBoxTree::GenericBoundingBoxTree() : _tdim(0)
+GenericBoundingBoxTree::GenericBoundingBoxTree() : _tdim(0), _build_quality(0.0)
 {
   // Do nothing
 }
@@ -100,13 +109,119 @@ void GenericBoundingBoxTree::build(const Mesh& mesh, std::size_t tdim)
   for (unsigned int i = 0; i < num_leaves; ++i)
     leaf_partition[i] = i;
 
-  // Recursively build the bounding box tree from the leaves
-  _build(leaf_bboxes, leaf_partition.begin(), leaf_partition.end(), _gdim);
+  // Get split strategy and number of threads
+  const std::string split_type = parameters["bounding_box_tree_split"];
+  SplitType split = SplitType::median;
+  if (split_type == "sah")
+    split = SplitType::sah;
+  else if (split_type == "morton")
+    split = SplitType::morton;
+
+  // Build the bounding box tree from the leaves
+  _build(leaf_bboxes, leaf_partition.begin(), leaf_partition.end(), _gdim,
+         split, num_threads());
 
   log(PROGRESS,
       "Computed bounding box tree with %d nodes for %d entities.",
       num_bboxes(), num_leaves);
 
+  // Store quality of tree for comparison after refitting
+  _build_quality = compute_quality();
+
+  // Build global tree of process bounding boxes
+  build_global_tree(mesh);
+}
+//-----------------------------------------------------------------------------
+bool GenericBoundingBoxTree::refit(const Mesh& mesh, double max_quality_ratio)
+{
+  // Refit only implemented for trees of mesh entities
+  if (_tdim == 0 || _bboxes.empty())
+  {
+    dolfin_error("GenericBoundingBoxTree.cpp",
+                 "refit bounding box tree",
+                 "Bounding box tree has not been built for mesh entities");
+  }
+
+  // Check that the number of entities has not changed
+  const unsigned int num_nodes = num_bboxes();
+  if (num_nodes != 2*mesh.num_entities(_tdim) - 1)
+  {
+    dolfin_error("GenericBoundingBoxTree.cpp",
+                 "refit bounding box tree",
+                 "Number of mesh entities has changed since the tree was built");
+  }
+
+  // Update bounding boxes bottom-up. Children are always stored
+  // before their parent.
+  const std::size_t _gdim = gdim();
+  for (unsigned int node = 0; node < num_nodes; ++node)
+  {
+    const BBox& bbox = _bboxes[node];
+    double* b = _bbox_coordinates.data() + 2*_gdim*node;
+    if (is_leaf(bbox, node))
+    {
+      // child_1 denotes entity for leaves
+      const MeshEntity entity(mesh, _tdim, bbox.child_1);
+      compute_bbox_of_entity(b, entity, _gdim);
+    }
+    else
+    {
+      dolfin_assert(bbox.child_0 < node && bbox.child_1 < node);
+      const double* b0 = _bbox_coordinates.data() + 2*_gdim*bbox.child_0;
+      const double* b1 = _bbox_coordinates.data() + 2*_gdim*bbox.child_1;
+      for (std::size_t i = 0; i < _gdim; ++i)
+      {
+        b[i] = std::min(b0[i], b1[i]);
+        b[_gdim + i] = std::max(b0[_gdim + i], b1[_gdim + i]);
+      }
+    }
+  }
+
+  // Point search tree is built from entity midpoints
+  _point_search_tree.reset();
+
+  // Rebuild if the quality has degraded too much
+  const double quality = compute_quality();
+  if (quality > max_quality_ratio*_build_quality)
+  {
+    log(PROGRESS,
+        "Rebuilding bounding box tree (quality %g, %g after build).",
+        quality, _build_quality);
+    build(mesh, _tdim);
+    return true;
+  }
+
+  // Update global tree of process bounding boxes
+  build_global_tree(mesh);
+
+  return false;
+}
+//-----------------------------------------------------------------------------
+double GenericBoundingBoxTree::compute_quality() const
+{
+  // Sum of surface areas of internal nodes relative to the root
+  const std::size_t _gdim = gdim();
+  const unsigned int num_nodes = num_bboxes();
+  if (num_nodes == 0)
+    return 0.0;
+  const double root_area = compute_bbox_area(get_bbox_coordinates(num_nodes - 1),
+                                             _gdim);
+  if (root_area <= 0.0)
+    return 0.0;
+
+  double area = 0.0;
+  for (unsigned int node = 0; node < num_nodes; ++node)
+  {
+    if (!is_leaf(_bboxes[node], node))
+      area += compute_bbox_area(get_bbox_coordinates(node), _gdim);
+  }
+
+  return area/root_area;
+}
+//-----------------------------------------------------------------------------
+void GenericBoundingBoxTree::build_global_tree(const Mesh& mesh)
+{
+  const std::size_t _gdim = gdim();
   const std::size_t mpi_size = MPI::size(mesh.mpi_comm());
   if (mpi_size > 1)
   {
@@ -253,6 +368,54 @@ GenericBoundingBoxTree::compute_first_entity_collision(const Point& point,
   return _compute_first_entity_collision(*this, point, num_bboxes() - 1, mesh);
 }
 //-----------------------------------------------------------------------------
+std::vector<unsigned int>
+GenericBoundingBoxTree::compute_first_entity_collisions(const std::vector<double>& x,
+                                                        const Mesh& mesh) const
+{
+  // Point in entity only implemented for cells. Consider extending this.
+  if (_tdim != mesh.topology().dim())
+  {
+    dolfin_error("GenericBoundingBoxTree.cpp",
+                 "compute collision between points and mesh entities",
+                 "Point-in-entity is only implemented for cells");
+  }
+
+  const std::size_t gdim = this->gdim();
+  if (x.size() % gdim != 0)
+  {
+    dolfin_error("GenericBoundingBoxTree.cpp",
+                 "compute collision between points and mesh entities",
+                 "Size of coordinate array (%d) is not a multiple of the geometric dimension (%d)",
+                 (int) x.size(), (int) gdim);
+  }
+
+  // Points are searched in packets that traverse the tree together
+  const std::size_t packet_size = 16;
+  const std::size_t num_points = x.size()/gdim;
+  const std::size_t num_packets = (num_points + packet_size - 1)/packet_size;
+  std::vector<unsigned int> entities(num_points,
+                                     std::numeric_limits<unsigned int>::max());
+
+  #ifdef HAS_OPENMP
+  #pragma omp parallel for schedule(dynamic) num_threads(num_threads())
+  #endif
+  for (std::size_t k = 0; k < num_packets; ++k)
+  {
+    // Store packet coordinates by component
+    const std::size_t offset = k*packet_size;
+    const std::size_t n = std::min(packet_size, num_points - offset);
+    double packet[3*packet_size];
+    for (std::size_t p = 0; p < n; ++p)
+      for (std::size_t i = 0; i < gdim; ++i)
+        packet[i*n + p] = x[(offset + p)*gdim + i];
+
+    _compute_first_entity_collisions(*this, packet, n, mesh,
+                                     entities.data() + offset);
+  }
+
+  return entities;
+}
+//-----------------------------------------------------------------------------
 std::pair<unsigned int, double>
 GenericBoundingBoxTree::compute_closest_entity(const Point& point,
                                                const Mesh& mesh) const
@@ -319,11 +482,82 @@ GenericBoundingBoxTree::compute_closest_point(const Point& point) const
   return ret;
 }
 //-----------------------------------------------------------------------------
+void GenericBoundingBoxTree::compute_closest_entities(const std::vector<double>& x,
+                                                      std::size_t k,
+                                                      const Mesh* mesh,
+                                                      std::vector<unsigned int>& entities,
+                                                      std::vector<double>& distances) const
+{
+  _check_distance_query(mesh, x, "compute closest entities of points");
+
+  const std::size_t gdim = this->gdim();
+  const std::size_t num_points = x.size()/gdim;
+  entities.assign(num_points*k, std::numeric_limits<unsigned int>::max());
+  distances.assign(num_points*k, std::numeric_limits<double>::infinity());
+  if (k == 0 or num_bboxes() == 0)
+    return;
+
+  #ifdef HAS_OPENMP
+  #pragma omp parallel num_threads(num_threads())
+  #endif
+  {
+    // Bounded priority queue of candidates, reused for all points
+    std::vector<std::pair<double, unsigned int>> heap;
+    heap.reserve(k);
+
+    #ifdef HAS_OPENMP
+    #pragma omp for schedule(dynamic, 64)
+    #endif
+    for (std::size_t i = 0; i < num_points; ++i)
+    {
+      const Point point(gdim, x.data() + i*gdim);
+      heap.clear();
+      _compute_closest_entities(*this, point, num_bboxes() - 1, mesh, k, heap);
+
+      // Store entities sorted by distance
+      std::sort_heap(heap.begin(), heap.end());
+      for (std::size_t j = 0; j < heap.size(); ++j)
+      {
+        entities[i*k + j] = heap[j].second;
+        distances[i*k + j] = std::sqrt(heap[j].first);
+      }
+    }
+  }
+}
+//-----------------------------------------------------------------------------
+std::vector<std::vector<unsigned int>>
+GenericBoundingBoxTree::compute_entities_within_radius(const std::vector<double>& x,
+                                                       double radius,
+                                                       const Mesh* mesh) const
+{
+  _check_distance_query(mesh, x, "compute entities within radius of points");
+
+  const std::size_t gdim = this->gdim();
+  const std::size_t num_points = x.size()/gdim;
+  std::vector<std::vector<unsigned int>> entities(num_points);
+  if (radius < 0.0 or num_bboxes() == 0)
+    return entities;
+
+  const double R2 = radius*radius;
+  #ifdef HAS_OPENMP
+  #pragma omp parallel for schedule(dynamic, 64) num_threads(num_threads())
+  #endif
+  for (std::size_t i = 0; i < num_points; ++i)
+  {
+    const Point point(gdim, x.data() + i*gdim);
+    _compute_entities_within_radius(*this, point, num_bboxes() - 1, mesh, R2,
+                                    entities[i]);
+  }
+
+  return entities;
+}
+//-----------------------------------------------------------------------------
 // Implementation of protected functions
 //-----------------------------------------------------------------------------
 void GenericBoundingBoxTree::clear()
 {
   _tdim = 0;
+  _build_quality = 0.0;
   _bboxes.clear();
   _bbox_coordinates.clear();
   _point_search_tree.reset();
@@ -333,41 +567,113 @@ unsigned int
 GenericBoundingBoxTree::_build(const std::vector<double>& leaf_bboxes,
                                const std::vector<unsigned int>::iterator& begin,
                                const std::vector<unsigned int>::iterator& end,
-                               std::size_t gdim)
+                               std::size_t gdim,
+                               SplitType split,
+                               std::size_t num_threads)
 {
   dolfin_assert(begin < end);
+  dolfin_assert(_bboxes.empty());
 
-  // Create empty bounding box data
-  BBox bbox;
+  // Allocate nodes (a binary tree with n leaves has 2n - 1 nodes)
+  const unsigned int num_nodes = 2*(end - begin) - 1;
+  _bboxes.resize(num_nodes);
+  _bbox_coordinates.resize(2*gdim*num_nodes);
+
+  // Sort leaves by Morton code. Subranges then remain sorted, so no
+  // further sorting is needed when splitting.
+  std::vector<std::uint64_t> morton_codes;
+  if (split == SplitType::morton)
+  {
+    compute_morton_codes(morton_codes, leaf_bboxes, gdim);
+    std::sort(begin, end, [&morton_codes](unsigned int i, unsigned int j)
+              { return morton_codes[i] < morton_codes[j]
+                  || (morton_codes[i] == morton_codes[j] && i < j); });
+  }
+
+  // Build tree from the root (stored last)
+  const unsigned int root = num_nodes - 1;
+  #ifdef HAS_OPENMP
+  if (num_threads > 1)
+  {
+    #pragma omp parallel num_threads(num_threads)
+    #pragma omp single
+    _build_subtree(leaf_bboxes, morton_codes, begin, end, gdim, root,
+                   split, true);
+  }
+  else
+  #endif
+  _build_subtree(leaf_bboxes, morton_codes, begin, end, gdim, root,
+                 split, false);
+
+  // Store nodes in breadth-first order
+  reorder_breadth_first(gdim);
+
+  return root;
+}
+//-----------------------------------------------------------------------------
+void
+GenericBoundingBoxTree::_build_subtree(const std::vector<double>& leaf_bboxes,
+                                       const std::vector<std::uint64_t>& morton_codes,
+                                       const std::vector<unsigned int>::iterator& begin,
+                                       const std::vector<unsigned int>::iterator& end,
+                                       std::size_t gdim, unsigned int node,
+                                       SplitType split, bool spawn_tasks)
+{
+  dolfin_assert(begin < end);
+
+  // Bounding box data for node
+  BBox& bbox = _bboxes[node];
+  double* b = _bbox_coordinates.data() + 2*gdim*node;
 
   // Reached leaf
   if (end - begin == 1)
   {
-    // Get bounding box coordinates for leaf
+    // Copy bounding box coordinates of leaf
     const unsigned int entity_index = *begin;
-    const double* b = leaf_bboxes.data() + 2*gdim*entity_index;
+    const double* leaf_b = leaf_bboxes.data() + 2*gdim*entity_index;
+    std::copy(leaf_b, leaf_b + 2*gdim, b);
 
     // Store bounding box data
-    bbox.child_0 = num_bboxes(); // child_0 == node denotes a leaf
+    bbox.child_0 = node;         // child_0 == node denotes a leaf
     bbox.child_1 = entity_index; // index of entity contained in leaf
-    return add_bbox(bbox, b, gdim);
+    return;
   }
 
   // Compute bounding box of all bounding boxes
-  double b[MAX_DIM];
   std::size_t axis;
   compute_bbox_of_bboxes(b, axis, leaf_bboxes, begin, end);
 
-  // Sort bounding boxes along longest axis
-  std::vector<unsigned int>::iterator middle = begin + (end - begin) / 2;
-  sort_bboxes(axis, leaf_bboxes, begin, middle, end);
-
-  // Split bounding boxes into two groups and call recursively
-  bbox.child_0 = _build(leaf_bboxes, begin, middle, gdim);
-  bbox.child_1 = _build(leaf_bboxes, middle, end, gdim);
+  // Split bounding boxes into two groups, falling back to the median
+  // along the longest axis
+  std::vector<unsigned int>::iterator middle = begin;
+  if (split == SplitType::sah)
+    middle = split_sah(leaf_bboxes, begin, end, gdim);
+  else if (split == SplitType::morton)
+    middle = split_morton(morton_codes, begin, end);
+  if (middle == begin || middle == end)
+  {
+    middle = begin + (end - begin) / 2;
+    sort_bboxes(axis, leaf_bboxes, begin, middle, end);
+  }
 
-  // Store bounding box data. Note that root box will be added last.
-  return add_bbox(bbox, b, gdim);
+  // The subtree of child_1 is stored directly before the node, and
+  // the subtree of child_0 directly before that
+  bbox.child_1 = node - 1;
+  bbox.child_0 = node - 2*(end - middle);
+
+  // Build subtrees, as tasks for large subtrees
+  const unsigned int child_0 = bbox.child_0;
+  #ifdef HAS_OPENMP
+  const bool spawn = spawn_tasks && end - begin > 4096;
+  #pragma omp task if (spawn) shared(leaf_bboxes, morton_codes)
+  #endif
+  _build_subtree(leaf_bboxes, morton_codes, begin, middle, gdim,
+                 child_0, split, spawn_tasks);
+  _build_subtree(leaf_bboxes, morton_codes, middle, end, gdim,
+                 bbox.child_1, split, spawn_tasks);
+  #ifdef HAS_OPENMP
+  #pragma omp taskwait
+  #endif
 }
 //-----------------------------------------------------------------------------
 unsigned int
@@ -629,6 +935,72 @@ GenericBoundingBoxTree::_compute_first_entity_collision(const GenericBoundingBox
 }
 //-----------------------------------------------------------------------------
 void
+GenericBoundingBoxTree::_compute_first_entity_collisions(const GenericBoundingBoxTree& tree,
+                                                         const double* x,
+                                                         std::size_t num_points,
+                                                         const Mesh& mesh,
+                                                         unsigned int* entities)
+{
+  // Get max integer to signify not found
+  const unsigned int not_found = std::numeric_limits<unsigned int>::max();
+  const std::size_t gdim = tree.gdim();
+
+  // Stack of nodes to visit, with the points of the packet that are
+  // active for each node. Nodes are visited in the same order as in
+  // _compute_first_entity_collision, so each point gets the same
+  // entity as with a single-point search.
+  std::vector<unsigned int> nodes(1, tree.num_bboxes() - 1);
+  std::vector<unsigned char> masks(num_points, 1);
+  std::vector<unsigned char> inside(num_points);
+  Point point;
+  while (!nodes.empty())
+  {
+    // Pop node and check which active points are in its bounding box
+    const unsigned int node = nodes.back();
+    nodes.pop_back();
+    tree.points_in_bbox(x, num_points, masks.data() + nodes.size()*num_points,
+                        inside.data(), node);
+    masks.resize(nodes.size()*num_points);
+
+    // Skip points found since the node was pushed
+    bool any_inside = false;
+    for (std::size_t p = 0; p < num_points; ++p)
+    {
+      inside[p] = inside[p] && entities[p] == not_found;
+      any_inside = any_inside || inside[p];
+    }
+    if (!any_inside)
+      continue;
+
+    const BBox& bbox = tree.get_bbox(node);
+    if (tree.is_leaf(bbox, node))
+    {
+      // Check entity (child_1 denotes entity index for leaves)
+      dolfin_assert(tree._tdim == mesh.topology().dim());
+      const unsigned int entity_index = bbox.child_1;
+      Cell cell(mesh, entity_index);
+      for (std::size_t p = 0; p < num_points; ++p)
+      {
+        if (!inside[p])
+          continue;
+        for (std::size_t i = 0; i < gdim; ++i)
+          point[i] = x[i*num_points + p];
+        if (cell.collides(point))
+          entities[p] = entity_index;
+      }
+    }
+    else
+    {
+      // Push children (child_0 is visited first)
+      nodes.push_back(bbox.child_1);
+      masks.insert(masks.end(), inside.begin(), inside.end());
+      nodes.push_back(bbox.child_0);
+      masks.insert(masks.end(), inside.begin(), inside.end());
+    }
+  }
+}
+//-----------------------------------------------------------------------------
+void
 GenericBoundingBoxTree::_compute_closest_entity(const GenericBoundingBoxTree& tree,
                                                 const Point& point,
                                                 unsigned int node,
@@ -704,6 +1076,370 @@ GenericBoundingBoxTree::_compute_closest_point(const GenericBoundingBoxTree& tre
   }
 }
 //-----------------------------------------------------------------------------
+void GenericBoundingBoxTree::_compute_closest_entities
+(const GenericBoundingBoxTree& tree,
+ const Point& point,
+ unsigned int node,
+ const Mesh* mesh,
+ std::size_t k,
+ std::vector<std::pair<double, unsigned int>>& heap)
+{
+  // Get bounding box for current node
+  const BBox& bbox = tree.get_bbox(node);
+
+  // If box is leaf, then compute distance and insert into heap,
+  // replacing the farthest candidate if the heap is full
+  if (tree.is_leaf(bbox, node))
+  {
+    const double r2 = tree._compute_squared_distance_entity(point, node, mesh);
+    if (heap.size() < k)
+    {
+      heap.push_back(std::make_pair(r2, bbox.child_1));
+      std::push_heap(heap.begin(), heap.end());
+    }
+    else if (r2 < heap.front().first)
+    {
+      std::pop_heap(heap.begin(), heap.end());
+      heap.back() = std::make_pair(r2, bbox.child_1);
+      std::push_heap(heap.begin(), heap.end());
+    }
+    return;
+  }
+
+  // Check children, closest first, skipping those outside radius
+  const double* x = point.coordinates();
+  unsigned int c0 = bbox.child_0;
+  unsigned int c1 = bbox.child_1;
+  double r2_0 = tree.compute_squared_distance_bbox(x, c0);
+  double r2_1 = tree.compute_squared_distance_bbox(x, c1);
+  if (r2_1 < r2_0)
+  {
+    std::swap(c0, c1);
+    std::swap(r2_0, r2_1);
+  }
+
+  if (heap.size() < k or r2_0 < heap.front().first)
+    _compute_closest_entities(tree, point, c0, mesh, k, heap);
+  if (heap.size() < k or r2_1 < heap.front().first)
+    _compute_closest_entities(tree, point, c1, mesh, k, heap);
+}
+//-----------------------------------------------------------------------------
+void GenericBoundingBoxTree::_compute_entities_within_radius
+(const GenericBoundingBoxTree& tree,
+ const Point& point,
+ unsigned int node,
+ const Mesh* mesh,
+ double R2,
+ std::vector<unsigned int>& entities)
+{
+  // Get bounding box for current node
+  const BBox& bbox = tree.get_bbox(node);
+
+  // If bounding box is outside radius, then don't search further
+  if (tree.compute_squared_distance_bbox(point.coordinates(), node) > R2)
+    return;
+
+  // If box is leaf, then check distance to entity
+  if (tree.is_leaf(bbox, node))
+  {
+    if (tree._compute_squared_distance_entity(point, node, mesh) <= R2)
+      entities.push_back(bbox.child_1);
+  }
+
+  // Check both children
+  else
+  {
+    _compute_entities_within_radius(tree, point, bbox.child_0, mesh, R2,
+                                    entities);
+    _compute_entities_within_radius(tree, point, bbox.child_1, mesh, R2,
+                                    entities);
+  }
+}
+//-----------------------------------------------------------------------------
+double
+GenericBoundingBoxTree::_compute_squared_distance_entity(const Point& point,
+                                                         unsigned int node,
+                                                         const Mesh* mesh) const
+{
+  // Leaves of point trees store the point as a degenerate box
+  if (_tdim == 0)
+    return compute_squared_distance_point(point.coordinates(), node);
+
+  // Get entity (child_1 denotes entity index for leaves)
+  dolfin_assert(mesh);
+  dolfin_assert(_tdim == mesh->topology().dim());
+  const Cell cell(*mesh, get_bbox(node).child_1);
+  return cell.squared_distance(point);
+}
+//-----------------------------------------------------------------------------
+void GenericBoundingBoxTree::_check_distance_query(const Mesh* mesh,
+                                                   const std::vector<double>& x,
+                                                   std::string task) const
+{
+  // Distance to entity only implemented for points and cells
+  if (_tdim > 0 and (!mesh or _tdim != mesh->topology().dim()))
+  {
+    dolfin_error("GenericBoundingBoxTree.cpp",
+                 task,
+                 "Distance queries are only implemented for points and cells");
+  }
+
+  const std::size_t gdim = this->gdim();
+  if (x.size() % gdim != 0)
+  {
+    dolfin_error("GenericBoundingBoxTree.cpp",
+                 task,
+                 "Size of coordinate array (%d) is not a multiple of the geometric dimension (%d)",
+                 (int) x.size(), (int) gdim);
+  }
+}
+//-----------------------------------------------------------------------------
+double GenericBoundingBoxTree::compute_bbox_area(const double* b,
+                                                 std::size_t gdim)
+{
+  // Length in 1D, half perimeter in 2D, half surface area in 3D
+  if (gdim == 1)
+    return b[1] - b[0];
+  else if (gdim == 2)
+    return (b[2] - b[0]) + (b[3] - b[1]);
+  const double dx = b[3] - b[0];
+  const double dy = b[4] - b[1];
+  const double dz = b[5] - b[2];
+  return dx*dy + dy*dz + dz*dx;
+}
+//-----------------------------------------------------------------------------
+std::vector<unsigned int>::iterator
+GenericBoundingBoxTree::split_sah(const std::vector<double>& leaf_bboxes,
+                                  const std::vector<unsigned int>::iterator& begin,
+                                  const std::vector<unsigned int>::iterator& end,
+                                  std::size_t gdim)
+{
+  auto area = [gdim](const double* b)
+  { return compute_bbox_area(b, gdim); };
+
+  // Compute bounds of leaf midpoints (scaled by two)
+  double c_min[MAX_DIM], c_max[MAX_DIM];
+  std::fill(c_min, c_min + gdim, std::numeric_limits<double>::max());
+  std::fill(c_max, c_max + gdim, std::numeric_limits<double>::lowest());
+  for (auto it = begin; it != end; ++it)
+  {
+    const double* b = leaf_bboxes.data() + 2*gdim*(*it);
+    for (std::size_t i = 0; i < gdim; ++i)
+    {
+      const double c = b[i] + b[gdim + i];
+      c_min[i] = std::min(c_min[i], c);
+      c_max[i] = std::max(c_max[i], c);
+    }
+  }
+
+  // Bin along the axis with largest midpoint extent
+  std::size_t axis = 0;
+  for (std::size_t i = 1; i < gdim; ++i)
+    if (c_max[i] - c_min[i] > c_max[axis] - c_min[axis])
+      axis = i;
+  const double extent = c_max[axis] - c_min[axis];
+  if (extent <= 0.0)
+    return begin;
+
+  // Count leaves and compute bounding box for each bin
+  const std::size_t num_bins = 16;
+  auto bin = [&](unsigned int leaf)
+  {
+    const double* b = leaf_bboxes.data() + 2*gdim*leaf;
+    const double c = b[axis] + b[gdim + axis];
+    return std::min(num_bins - 1,
+                    (std::size_t) (num_bins*(c - c_min[axis])/extent));
+  };
+  std::size_t counts[num_bins] = {};
+  double bin_bboxes[num_bins][MAX_DIM];
+  for (std::size_t k = 0; k < num_bins; ++k)
+  {
+    std::fill(bin_bboxes[k], bin_bboxes[k] + gdim,
+              std::numeric_limits<double>::max());
+    std::fill(bin_bboxes[k] + gdim, bin_bboxes[k] + 2*gdim,
+              std::numeric_limits<double>::lowest());
+  }
+  for (auto it = begin; it != end; ++it)
+  {
+    const std::size_t k = bin(*it);
+    const double* b = leaf_bboxes.data() + 2*gdim*(*it);
+    ++counts[k];
+    for (std::size_t i = 0; i < gdim; ++i)
+    {
+      bin_bboxes[k][i] = std::min(bin_bboxes[k][i], b[i]);
+      bin_bboxes[k][gdim + i] = std::max(bin_bboxes[k][gdim + i],
+                                         b[gdim + i]);
+    }
+  }
+
+  // Compute area and count to the right of each split
+  double right_area[num_bins];
+  std::size_t right_count[num_bins];
+  double bbox[MAX_DIM];
+  std::copy(bin_bboxes[num_bins - 1], bin_bboxes[num_bins - 1] + 2*gdim,
+            bbox);
+  right_count[num_bins - 1] = counts[num_bins - 1];
+  right_area[num_bins - 1] = area(bbox);
+  for (std::size_t k = num_bins - 1; k-- > 1; )
+  {
+    for (std::size_t i = 0; i < gdim; ++i)
+    {
+      bbox[i] = std::min(bbox[i], bin_bboxes[k][i]);
+      bbox[gdim + i] = std::max(bbox[gdim + i], bin_bboxes[k][gdim + i]);
+    }
+    right_count[k] = right_count[k + 1] + counts[k];
+    right_area[k] = area(bbox);
+  }
+
+  // Find split with lowest cost, sweeping from the left
+  std::size_t best_split = 0;
+  double best_cost = std::numeric_limits<double>::max();
+  std::size_t left_count = 0;
+  std::copy(bin_bboxes[0], bin_bboxes[0] + 2*gdim, bbox);
+  for (std::size_t k = 1; k < num_bins; ++k)
+  {
+    left_count += counts[k - 1];
+    if (k > 1)
+    {
+      for (std::size_t i = 0; i < gdim; ++i)
+      {
+        bbox[i] = std::min(bbox[i], bin_bboxes[k - 1][i]);
+        bbox[gdim + i] = std::max(bbox[gdim + i],
+                                  bin_bboxes[k - 1][gdim + i]);
+      }
+    }
+    if (left_count == 0 || right_count[k] == 0)
+      continue;
+
+    const double cost = left_count*area(bbox) + right_count[k]*right_area[k];
+    if (cost < best_cost)
+    {
+      best_cost = cost;
+      best_split = k;
+    }
+  }
+  if (best_split == 0)
+    return begin;
+
+  // Partition leaves
+  return std::partition(begin, end, [&](unsigned int leaf)
+                        { return bin(leaf) < best_split; });
+}
+//-----------------------------------------------------------------------------
+std::vector<unsigned int>::iterator
+GenericBoundingBoxTree::split_morton(const std::vector<std::uint64_t>& morton_codes,
+                                     const std::vector<unsigned int>::iterator& begin,
+                                     const std::vector<unsigned int>::iterator& end)
+{
+  // Find highest bit that differs between first and last code
+  const std::uint64_t diff = morton_codes[*begin] ^ morton_codes[*(end - 1)];
+  if (diff == 0)
+    return begin;
+  std::uint64_t bit = 1;
+  while (diff >> 1 >= bit)
+    bit <<= 1;
+
+  // Leaves are sorted by code, so the bit is set for a contiguous
+  // range at the end
+  return std::partition_point(begin, end, [&](unsigned int leaf)
+                              { return (morton_codes[leaf] & bit) == 0; });
+}
+//-----------------------------------------------------------------------------
+void
+GenericBoundingBoxTree::compute_morton_codes(std::vector<std::uint64_t>& morton_codes,
+                                             const std::vector<double>& leaf_bboxes,
+                                             std::size_t gdim)
+{
+  const std::size_t num_leaves = leaf_bboxes.size()/(2*gdim);
+  const std::size_t num_bits = 21;
+
+  // Compute bounds of leaf midpoints (scaled by two)
+  double c_min[MAX_DIM], c_max[MAX_DIM];
+  std::fill(c_min, c_min + gdim, std::numeric_limits<double>::max());
+  std::fill(c_max, c_max + gdim, std::numeric_limits<double>::lowest());
+  for (std::size_t j = 0; j < num_leaves; ++j)
+  {
+    const double* b = leaf_bboxes.data() + 2*gdim*j;
+    for (std::size_t i = 0; i < gdim; ++i)
+    {
+      const double c = b[i] + b[gdim + i];
+      c_min[i] = std::min(c_min[i], c);
+      c_max[i] = std::max(c_max[i], c);
+    }
+  }
+
+  // Quantise midpoints and interleave bits
+  const double scale = (double) (1 << num_bits);
+  morton_codes.resize(num_leaves);
+  for (std::size_t j = 0; j < num_leaves; ++j)
+  {
+    const double* b = leaf_bboxes.data() + 2*gdim*j;
+    std::uint64_t q[MAX_DIM];
+    for (std::size_t i = 0; i < gdim; ++i)
+    {
+      const double extent = c_max[i] - c_min[i];
+      const double c = b[i] + b[gdim + i];
+      const double s = extent > 0.0 ? (c - c_min[i])/extent : 0.0;
+      q[i] = std::min((std::uint64_t) (s*scale),
+                      ((std::uint64_t) 1 << num_bits) - 1);
+    }
+
+    std::uint64_t code = 0;
+    for (std::size_t k = num_bits; k-- > 0; )
+      for (std::size_t i = 0; i < gdim; ++i)
+        code = (code << 1) | ((q[i] >> k) & 1);
+    morton_codes[j] = code;
+  }
+}
+//-----------------------------------------------------------------------------
+void GenericBoundingBoxTree::reorder_breadth_first(std::size_t gdim)
+{
+  const unsigned int num_nodes = num_bboxes();
+
+  // Compute breadth-first ordering starting from the root
+  std::vector<unsigned int> order;
+  order.reserve(num_nodes);
+  order.push_back(num_nodes - 1);
+  for (std::size_t k = 0; k < order.size(); ++k)
+  {
+    const BBox& bbox = _bboxes[order[k]];
+    if (!is_leaf(bbox, order[k]))
+    {
+      order.push_back(bbox.child_0);
+      order.push_back(bbox.child_1);
+    }
+  }
+  dolfin_assert(order.size() == num_nodes);
+
+  // Renumber nodes so that the root remains last and each level
+  // precedes the level above it
+  std::vector<unsigned int> new_node(num_nodes);
+  for (unsigned int k = 0; k < num_nodes; ++k)
+    new_node[order[k]] = num_nodes - 1 - k;
+
+  std::vector<BBox> bboxes(num_nodes);
+  std::vector<double> bbox_coordinates(_bbox_coordinates.size());
+  for (unsigned int node = 0; node < num_nodes; ++node)
+  {
+    const unsigned int n = new_node[node];
+    BBox bbox = _bboxes[node];
+    if (is_leaf(bbox, node))
+      bbox.child_0 = n;
+    else
+    {
+      bbox.child_0 = new_node[bbox.child_0];
+      bbox.child_1 = new_node[bbox.child_1];
+    }
+    bboxes[n] = bbox;
+    std::copy(_bbox_coordinates.begin() + 2*gdim*node,
+              _bbox_coordinates.begin() + 2*gdim*(node + 1),
+              bbox_coordinates.begin() + 2*gdim*n);
+  }
+
+  _bboxes.swap(bboxes);
+  _bbox_coordinates.swap(bbox_coordinates);
+}
+//-----------------------------------------------------------------------------
 void GenericBoundingBoxTree::build_point_search_tree(const Mesh& mesh) const
 {
   // Don't build search tree if it already exists
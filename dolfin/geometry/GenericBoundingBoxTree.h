@@ -21,6 +21,7 @@
 #ifndef __GENERIC_BOUNDING_BOX_TREE_H
 #define __GENERIC_BOUNDING_BOX_TREE_H
 
+#include <cstdint>
 #include <memory>
 #include <sstream>
 #include <set>
@@ -50,12 +51,28 @@ namespace dolfin
     /// Factory function returning (empty) tree of appropriate dimension
     static std::shared_ptr<GenericBoundingBoxTree> create(unsigned int dim);
 
-    /// Build bounding box tree for mesh entities of given dimension
+    /// Build bounding box tree for mesh entities of given dimension.
+    /// The split strategy is given by the global parameter
+    /// "bounding_box_tree_split" ("median", "sah" or "morton") and
+    /// subtrees are built concurrently by "num_threads" threads
+    /// (serially if zero) when DOLFIN is built with OpenMP.
     void build(const Mesh& mesh, std::size_t tdim);
 
     /// Build bounding box tree for point cloud
     void build(const std::vector<Point>& points);
 
+    /// Update bounding boxes of a tree for mesh entities after the
+    /// mesh vertices have moved, keeping the tree topology. The tree
+    /// is rebuilt if its quality (see compute_quality()) exceeds
+    /// max_quality_ratio times the quality after the last build.
+    /// Returns true if the tree was rebuilt.
+    bool refit(const Mesh& mesh, double max_quality_ratio);
+
+    /// Compute quality of tree as the sum of the surface areas of
+    /// the non-leaf bounding boxes relative to the root bounding box
+    /// (lower is better)
+    double compute_quality() const;
+
     /// Compute all collisions between bounding boxes and _Point_
     std::vector<unsigned int>
     compute_collisions(const Point& point) const;
@@ -85,6 +102,12 @@ namespace dolfin
     unsigned int compute_first_entity_collision(const Point& point,
                                               const Mesh& mesh) const;
 
+    /// Compute first collision between entities and each point of a
+    /// list of points (gdim coordinates per point)
+    std::vector<unsigned int>
+    compute_first_entity_collisions(const std::vector<double>& x,
+                                    const Mesh& mesh) const;
+
     /// Compute closest entity and distance to _Point_
     std::pair<unsigned int, double> compute_closest_entity(const Point& point,
                                                            const Mesh& mesh) const;
@@ -92,11 +115,43 @@ namespace dolfin
     /// Compute closest point and distance to _Point_
     std::pair<unsigned int, double> compute_closest_point(const Point& point) const;
 
+    /// Compute the k closest entities (points for a point cloud) to
+    /// each point of a list of points (gdim coordinates per point).
+    /// The mesh is only used for trees of entities of dimension > 0.
+    /// Results are stored with k values per point, sorted by
+    /// distance and padded with std::numeric_limits<unsigned
+    /// int>::max() and infinite distance if the tree has fewer than
+    /// k entities.
+    void compute_closest_entities(const std::vector<double>& x,
+                                  std::size_t k,
+                                  const Mesh* mesh,
+                                  std::vector<unsigned int>& entities,
+                                  std::vector<double>& distances) const;
+
+    /// Compute all entities (points for a point cloud) within given
+    /// distance of each point of a list of points (gdim coordinates
+    /// per point). The mesh is only used for trees of entities of
+    /// dimension > 0.
+    std::vector<std::vector<unsigned int>>
+    compute_entities_within_radius(const std::vector<double>& x,
+                                   double radius,
+                                   const Mesh* mesh) const;
+
+    /// Return topological dimension of leaf entities
+    std::size_t tdim() const
+    { return _tdim; }
+
     /// Print out for debugging
     std::string str(bool verbose=false);
 
   protected:
 
+    /// Strategy for splitting the leaves of a node between its two
+    /// children: median along the longest axis, binned surface area
+    /// heuristic (SAH), or highest differing bit of the Morton codes
+    /// of the leaf midpoints (LBVH)
+    enum class SplitType { median, sah, morton };
+
     /// Bounding box data. Leaf nodes are indicated by setting child_0
     /// equal to the node itself. For leaf nodes, child_1 is set to the
     /// index of the entity contained in the leaf bounding box.
@@ -117,6 +172,9 @@ namespace dolfin
     /// List of bounding box coordinates
     std::vector<double> _bbox_coordinates;
 
+    /// Quality of tree after the last build
+    double _build_quality;
+
     /// Point search tree used to accelerate distance queries
     mutable std::shared_ptr<GenericBoundingBoxTree> _point_search_tree;
 
@@ -128,11 +186,24 @@ namespace dolfin
 
     //--- Recursive build functions ---
 
-    /// Build bounding box tree for entities (recursive)
+    /// Build bounding box tree for entities. Nodes are stored in
+    /// breadth-first order with the root last.
     unsigned int _build(const std::vector<double>& leaf_bboxes,
                         const std::vector<unsigned int>::iterator& begin,
                         const std::vector<unsigned int>::iterator& end,
-                        std::size_t gdim);
+                        std::size_t gdim,
+                        SplitType split=SplitType::median,
+                        std::size_t num_threads=1);
+
+    /// Build subtree for entities (recursive). The subtree for n
+    /// leaves is stored in the 2n - 1 nodes ending with the given
+    /// node, so that subtrees can be built concurrently.
+    void _build_subtree(const std::vector<double>& leaf_bboxes,
+                        const std::vector<std::uint64_t>& morton_codes,
+                        const std::vector<unsigned int>::iterator& begin,
+                        const std::vector<unsigned int>::iterator& end,
+                        std::size_t gdim, unsigned int node,
+                        SplitType split, bool spawn_tasks);
 
     /// Build bounding box tree for points (recursive)
     unsigned int _build(const std::vector<Point>& points,
@@ -177,6 +248,17 @@ namespace dolfin
                                     unsigned int node,
                                     const Mesh& mesh);
 
+    // Compute first entity collision for a packet of points. The
+    // coordinates are stored by component: x[i*num_points + p] is
+    // component i of point p. Entities must be initialised to
+    // std::numeric_limits<unsigned int>::max().
+    static void
+    _compute_first_entity_collisions(const GenericBoundingBoxTree& tree,
+                                     const double* x,
+                                     std::size_t num_points,
+                                     const Mesh& mesh,
+                                     unsigned int* entities);
+
     // Compute closest entity (recursive)
     static void _compute_closest_entity(const GenericBoundingBoxTree& tree,
                                         const Point& point,
@@ -193,6 +275,38 @@ namespace dolfin
                            unsigned int& closest_point,
                            double& R2);
 
+    // Compute k closest entities (recursive). The candidates are
+    // kept in a max-heap of at most k (squared distance, entity)
+    // pairs, so that the search radius is given by the top of the
+    // heap once it is full.
+    static void
+    _compute_closest_entities(const GenericBoundingBoxTree& tree,
+                              const Point& point,
+                              unsigned int node,
+                              const Mesh* mesh,
+                              std::size_t k,
+                              std::vector<std::pair<double, unsigned int>>& heap);
+
+    // Compute entities within squared distance R2 (recursive)
+    static void
+    _compute_entities_within_radius(const GenericBoundingBoxTree& tree,
+                                    const Point& point,
+                                    unsigned int node,
+                                    const Mesh* mesh,
+                                    double R2,
+                                    std::vector<unsigned int>& entities);
+
+    // Compute squared distance from point to leaf entity
+    double _compute_squared_distance_entity(const Point& point,
+                                            unsigned int node,
+                                            const Mesh* mesh) const;
+
+    // Check that the tree can be used for distance queries with the
+    // given mesh
+    void _check_distance_query(const Mesh* mesh,
+                               const std::vector<double>& x,
+                               std::string task) const;
+
     //--- Utility functions ---
 
     /// Compute point search tree if not already done
@@ -203,6 +317,37 @@ namespace dolfin
                                 const MeshEntity& entity,
                                 std::size_t gdim) const;
 
+    /// Build global tree of process bounding boxes (collective)
+    void build_global_tree(const Mesh& mesh);
+
+    /// Compute surface area of bounding box (length in 1D, half
+    /// perimeter in 2D and half surface area in 3D)
+    static double compute_bbox_area(const double* b, std::size_t gdim);
+
+    /// Compute split of leaf bounding boxes by the binned surface
+    /// area heuristic. Returns begin if no split was found.
+    static std::vector<unsigned int>::iterator
+    split_sah(const std::vector<double>& leaf_bboxes,
+              const std::vector<unsigned int>::iterator& begin,
+              const std::vector<unsigned int>::iterator& end,
+              std::size_t gdim);
+
+    /// Compute split of leaves sorted by Morton code at the highest
+    /// differing bit. Returns begin if all codes are equal.
+    static std::vector<unsigned int>::iterator
+    split_morton(const std::vector<std::uint64_t>& morton_codes,
+                 const std::vector<unsigned int>::iterator& begin,
+                 const std::vector<unsigned int>::iterator& end);
+
+    /// Compute Morton codes of the midpoints of leaf bounding boxes
+    static void
+    compute_morton_codes(std::vector<std::uint64_t>& morton_codes,
+                         const std::vector<double>& leaf_bboxes,
+                         std::size_t gdim);
+
+    /// Renumber nodes in breadth-first order with the root last
+    void reorder_breadth_first(std::size_t gdim);
+
     /// Sort points along given axis
     void sort_points(std::size_t axis,
                      const std::vector<Point>& points,
@@ -334,6 +479,14 @@ namespace dolfin
     virtual bool
     point_in_bbox(const double* x, unsigned int node) const = 0;
 
+    /// Check which points of a packet (x, stored by component) are
+    /// in bounding box (node). Sets inside[p] nonzero iff active[p]
+    /// is nonzero and point p is in the bounding box.
+    virtual void
+    points_in_bbox(const double* x, std::size_t num_points,
+                   const unsigned char* active, unsigned char* inside,
+                   unsigned int node) const = 0;
+
     /// Check whether bounding box (a) collides with bounding box (node)
     virtual bool
     bbox_in_bbox(const double* a, unsigned int node) const = 0;
@@ -15,6 +15,11 @@
 // You should have received a copy of the GNU Lesser General Public License
 // along with DOLFIN. If not, see <http://www.gnu.org/licenses/>.
 
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <map>
 #include <dolfin/log/log.h>
 #include <dolfin/mesh/Cell.h>
 #include <dolfin/mesh/Mesh.h>
@@ -24,27 +29,175 @@
 
 using namespace dolfin;
 
+//-----------------------------------------------------------------------------
+namespace
+{
+  // Quadrature rule on a reference simplex (points and weights)
+  typedef std::pair<std::vector<std::vector<double>>, std::vector<double>>
+    reference_rule;
+
+  // Choice of points made by SimplexQuadrature::compress, keyed by
+  // (gdim, order) followed by the quantised layout of the points
+  typedef std::map<std::vector<std::int64_t>, std::vector<std::size_t>>
+    compression_cache;
+
+  // Maximum number of memoised compressions
+  const std::size_t max_compression_cache_size = 10000;
+
+  // Compute the key for the layout of the points in a quadrature
+  // rule relative to their bounding box. Returns false if the
+  // bounding box is degenerate.
+  bool compression_key(std::vector<std::int64_t>& key,
+                       const std::vector<double>& x,
+                       std::size_t gdim,
+                       std::size_t N)
+  {
+    const std::size_t num_points = x.size()/gdim;
+    key.resize(2 + x.size());
+    key[0] = gdim;
+    key[1] = N;
+
+    for (std::size_t d = 0; d < gdim; ++d)
+    {
+      double xmin = x[d];
+      double xmax = x[d];
+      for (std::size_t i = 1; i < num_points; ++i)
+      {
+        xmin = std::min(xmin, x[i*gdim + d]);
+        xmax = std::max(xmax, x[i*gdim + d]);
+      }
+      const double hx = xmax - xmin;
+      if (!(hx > 0.0))
+        return false;
+
+      // Quantise relative to the bounding box so that rules for
+      // translated and scaled copies have the same key
+      for (std::size_t i = 0; i < num_points; ++i)
+        key[2 + i*gdim + d] = std::llround((x[i*gdim + d] - xmin)/hx*1e12);
+    }
+
+    return true;
+  }
+
+  // Compute the volume of a simplex relative to the reference
+  // simplex (inspired by ufc_geometry.h). The vertex coordinates are
+  // packed.
+  double volume_ratio(const double* x, std::size_t tdim, std::size_t gdim)
+  {
+    switch (tdim)
+    {
+    case 1:
+    {
+      // Reference interval is [-1, 1]
+      double det2 = 0.0;
+      for (std::size_t d = 0; d < gdim; ++d)
+      {
+        const double J = x[gdim + d] - x[d];
+        det2 += J*J;
+      }
+      return 0.5*std::sqrt(det2);
+    }
+    case 2:
+    {
+      if (gdim == 2)
+        return 0.5*std::abs(_orient2d(x, x + 2, x + 4));
+
+      const std::array<double, 6> J = {{x[3] - x[0], x[6] - x[0],
+                                        x[4] - x[1], x[7] - x[1],
+                                        x[5] - x[2], x[8] - x[2]}};
+      const double d_0 = J[2]*J[5] - J[4]*J[3];
+      const double d_1 = J[4]*J[1] - J[0]*J[5];
+      const double d_2 = J[0]*J[3] - J[2]*J[1];
+      return 0.5*std::sqrt(d_0*d_0 + d_1*d_1 + d_2*d_2);
+    }
+    case 3:
+    {
+      const std::array<double, 9> J = {{x[3] - x[0], x[6] - x[0], x[9] - x[0],
+                                        x[4] - x[1], x[7] - x[1], x[10] - x[1],
+                                        x[5] - x[2], x[8] - x[2], x[11] - x[2]}};
+      const std::array<double, 3> d = {{J[4]*J[8] - J[5]*J[7],
+                                        J[2]*J[7] - J[1]*J[8],
+                                        J[1]*J[5] - J[2]*J[4]}};
+      return std::abs(J[0]*d[0] + J[3]*d[1] + J[6]*d[2])/6.0;
+    }
+    default:
+      dolfin_assert(false);
+    }
+
+    return 0.0;
+  }
+}
 //-----------------------------------------------------------------------------
 SimplexQuadrature::SimplexQuadrature(std::size_t tdim, std::size_t order)
+  : _tdim(tdim)
 {
-  // Create and store quadrature rule for reference simplex
-  switch (tdim)
+  // Reference rules are shared by all instances
+  static std::map<std::pair<std::size_t, std::size_t>, reference_rule> cache;
+  const std::pair<std::size_t, std::size_t> key(tdim, order);
+
+  bool cached = false;
+#ifdef HAS_OPENMP
+  #pragma omp critical (dolfin_simplex_quadrature_cache)
+#endif
   {
-  case 1:
-    setup_qr_reference_interval(order);
-    break;
-  case 2:
-    setup_qr_reference_triangle(order);
-    break;
-  case 3:
-    setup_qr_reference_tetrahedron(order);
-    break;
-  default:
-    dolfin_error("SimplexQuadrature.cpp",
-                 "setup quadrature rule for reference simplex",
-                 "Only implemented for topological dimension 1, 2, 3");
+    auto it = cache.find(key);
+    if (it != cache.end())
+    {
+      _p = it->second.first;
+      _w = it->second.second;
+      cached = true;
+    }
+  }
+
+  if (!cached)
+  {
+    // Create and store quadrature rule for reference simplex
+    switch (tdim)
+    {
+    case 1:
+      setup_qr_reference_interval(order);
+      break;
+    case 2:
+      setup_qr_reference_triangle(order);
+      break;
+    case 3:
+      setup_qr_reference_tetrahedron(order);
+      break;
+    default:
+      dolfin_error("SimplexQuadrature.cpp",
+                   "setup quadrature rule for reference simplex",
+                   "Only implemented for topological dimension 1, 2, 3");
+    }
+
+#ifdef HAS_OPENMP
+    #pragma omp critical (dolfin_simplex_quadrature_cache)
+#endif
+    cache.insert(std::make_pair(key, reference_rule(_p, _w)));
   }
 
+  // Compute barycentric coordinates of the points, so that mapping a
+  // point is a weighted sum of the vertex coordinates
+  const std::size_t num_vertices = tdim + 1;
+  _b.resize(num_vertices*_w.size());
+  for (std::size_t i = 0; i < _w.size(); ++i)
+  {
+    double* b = _b.data() + i*num_vertices;
+    if (tdim == 1)
+    {
+      // Reference interval is [-1, 1]
+      b[0] = 0.5*(1. - _p[0][i]);
+      b[1] = 0.5*(1. + _p[0][i]);
+    }
+    else
+    {
+      b[tdim] = 1.;
+      for (std::size_t j = 0; j < tdim; ++j)
+      {
+        b[j] = _p[i][j];
+        b[tdim] -= _p[i][j];
+      }
+    }
+  }
 }
 //-----------------------------------------------------------------------------
 std::pair<std::vector<double>, std::vector<double>>
@@ -98,70 +251,93 @@ std::pair<std::vector<double>, std::vector<double>>
   return quadrature_rule;
 }
 //-----------------------------------------------------------------------------
-std::pair<std::vector<double>, std::vector<double>>
-  SimplexQuadrature::compute_quadrature_rule_interval(const std::vector<Point>& coordinates,
-						      std::size_t gdim) const
+std::size_t
+SimplexQuadrature::compute_quadrature_rule(const std::vector<Point>& coordinates,
+                                           std::size_t gdim,
+                                           double* points,
+                                           double* weights) const
 {
-  log(PROGRESS, "Create quadrature rule using given interval coordinates");
-
-  std::pair<std::vector<double>, std::vector<double>> quadrature_rule;
-
-  // Find the determinant of the Jacobian (inspired by ufc_geometry.h)
-  double det = -1;
+  // No quadrature points for a vertex
+  if (coordinates.size() == 1)
+    return 0;
 
-  switch (gdim)
-  {
-  case 1:
+  if (coordinates.size() != _tdim + 1)
   {
-      det = coordinates[1].x() - coordinates[0].x();
-      break;
-  }
-  case 2:
-  {
-    const std::array<double, 2> J = {{coordinates[1].x() - coordinates[0].x(),
-                                      coordinates[1].y() - coordinates[0].y()}};
-    const double det2 = J[0]*J[0] + J[1]*J[1];
-    det = std::sqrt(det2);
-    break;
+    dolfin_error("SimplexQuadrature.cpp",
+                 "compute quadrature rule for simplex",
+                 "Simplex has %d vertices, expecting %d",
+                 (int) coordinates.size(), (int) (_tdim + 1));
   }
-  case 3:
+
+  // Pack vertex coordinates
+  std::array<double, 12> x;
+  for (std::size_t v = 0; v < coordinates.size(); ++v)
+    for (std::size_t d = 0; d < gdim; ++d)
+      x[v*gdim + d] = coordinates[v][d];
+
+  compute_quadrature_rules(x.data(), 1, gdim, points, weights);
+  return _w.size();
+}
+//-----------------------------------------------------------------------------
+void SimplexQuadrature::compute_quadrature_rules(const double* coordinates,
+                                                 std::size_t num_simplices,
+                                                 std::size_t gdim,
+                                                 double* points,
+                                                 double* weights) const
+{
+  // Check that the geometric dimension is supported
+  if (gdim < _tdim or gdim > 3 or (_tdim == 2 and gdim < 2))
   {
-    const std::array<double, 3>  J = {{coordinates[1].x() - coordinates[0].x(),
-                                       coordinates[1].y() - coordinates[0].y(),
-                                       coordinates[1].z() - coordinates[0].z()}};
-    const double det2 = J[0]*J[0] + J[1]*J[1];
-    det = std::sqrt(det2);
-    break;
-  }
-  default:
+    const std::string simplex = _tdim == 1 ? "interval"
+      : (_tdim == 2 ? "triangle" : "tetrahedron");
     dolfin_error("SimplexQuadrature.cpp",
-                 "compute quadrature rule for interval",
-                 "Not implemented for dimension %d", gdim);
+                 "compute quadrature rule for " + simplex,
+                 "Not implemented for dimension %d", (int) gdim);
   }
 
-  // Map (local) quadrature points (note that _p is a
-  // std::vector<std::vector<double> >)
-  quadrature_rule.first.resize(gdim*_p[0].size());
-  for (std::size_t i = 0; i < _p[0].size(); ++i)
+  const std::size_t num_vertices = _tdim + 1;
+  const std::size_t num_points = _w.size();
+  const double* b = _b.data();
+
+  for (std::size_t s = 0; s < num_simplices; ++s)
   {
-    for (std::size_t d = 0; d < gdim; ++d)
+    const double* x = coordinates + s*num_vertices*gdim;
+
+    // Store weights
+    const double scale = volume_ratio(x, _tdim, gdim);
+    double* w = weights + s*num_points;
+    for (std::size_t i = 0; i < num_points; ++i)
     {
-      quadrature_rule.first[d + i*gdim]
-        = 0.5*(coordinates[0][d]*(1. - _p[0][i])
-	       + coordinates[1][d]*(1. + _p[0][i]));
-      dolfin_assert(std::isfinite(quadrature_rule.first[d + i*gdim]));
+      w[i] = scale*_w[i];
+      dolfin_assert(std::isfinite(w[i]));
     }
-  }
-  dolfin_assert(det >= 0);
 
-  // Store weights
-  quadrature_rule.second.assign(_w.size(), 0.5*std::abs(det));
-  for (std::size_t i = 0; i < _w.size(); ++i)
-  {
-    quadrature_rule.second[i] *= _w[i];
-    dolfin_assert(std::isfinite(quadrature_rule.second[i]));
+    // Map (local) quadrature points
+    double* p = points + s*num_points*gdim;
+    for (std::size_t i = 0; i < num_points; ++i)
+    {
+      for (std::size_t d = 0; d < gdim; ++d)
+      {
+        double y = 0.0;
+        for (std::size_t v = 0; v < num_vertices; ++v)
+          y += b[i*num_vertices + v]*x[v*gdim + d];
+        p[i*gdim + d] = y;
+      }
+    }
   }
-  dolfin_assert(quadrature_rule.first.size() == gdim*quadrature_rule.second.size());
+}
+//-----------------------------------------------------------------------------
+std::pair<std::vector<double>, std::vector<double>>
+  SimplexQuadrature::compute_quadrature_rule_interval(const std::vector<Point>& coordinates,
+						      std::size_t gdim) const
+{
+  log(PROGRESS, "Create quadrature rule using given interval coordinates");
+
+  std::pair<std::vector<double>, std::vector<double>> quadrature_rule;
+  quadrature_rule.first.resize(gdim*_w.size());
+  quadrature_rule.second.resize(_w.size());
+  compute_quadrature_rule(coordinates, gdim, quadrature_rule.first.data(),
+                          quadrature_rule.second.data());
 
   return quadrature_rule;
 }
@@ -173,63 +349,10 @@ SimplexQuadrature::compute_quadrature_rule_triangle(const std::vector<Point>& co
   log(PROGRESS, "Create quadrature rule using given triangle coordinates");
 
   std::pair<std::vector<double>, std::vector<double>> quadrature_rule;
-
-  // Find the determinant of the Jacobian (inspired by ufc_geometry.h)
-  double det = 0; // To keep compiler happy
-
-  switch (gdim)
-  {
-  case 2:
-  {
-    det = orient2d(coordinates[0], coordinates[1], coordinates[2]);
-
-    break;
-  }
-  case 3:
-  {
-    const std::array<double, 6> J = {{coordinates[1].x() - coordinates[0].x(),
-                                      coordinates[2].x() - coordinates[0].x(),
-                                      coordinates[1].y() - coordinates[0].y(),
-                                      coordinates[2].y() - coordinates[0].y(),
-                                      coordinates[1].z() - coordinates[0].z(),
-                                      coordinates[2].z() - coordinates[0].z()}};
-    const double d_0 = J[2]*J[5] - J[4]*J[3];
-    const double d_1 = J[4]*J[1] - J[0]*J[5];
-    const double d_2 = J[0]*J[3] - J[2]*J[1];
-    const double det2 = d_0*d_0 + d_1*d_1 + d_2*d_2;
-    det = std::sqrt(det2);
-
-    break;
-  }
-  default:
-    dolfin_error("SimplexQuadrature.cpp",
-                 "compute quadrature rule for triangle",
-                 "Not implemented for dimension ", gdim);
-  }
-
-  // Store points
-  quadrature_rule.first.resize(gdim*_p.size());
-  for (std::size_t i = 0; i < _p.size(); ++i)
-  {
-    for (std::size_t d = 0; d < gdim; ++d)
-    {
-      quadrature_rule.first[d + i*gdim]
-        = _p[i][0]*coordinates[0][d]
-        + _p[i][1]*coordinates[1][d]
-        + (1. - _p[i][0] - _p[i][1])*coordinates[2][d];
-      dolfin_assert(std::isfinite(quadrature_rule.first[d + i*gdim]));
-    }
-  }
-
-  // Store weights
-  quadrature_rule.second.assign(_w.size(), 0.5*std::abs(det));
-  for (std::size_t i = 0; i < _w.size(); ++i)
-  {
-    quadrature_rule.second[i] *= _w[i];
-    dolfin_assert(std::isfinite(quadrature_rule.second[i]));
-  }
-
-  dolfin_assert(quadrature_rule.first.size() == gdim*quadrature_rule.second.size());
+  quadrature_rule.first.resize(gdim*_w.size());
+  quadrature_rule.second.resize(_w.size());
+  compute_quadrature_rule(coordinates, gdim, quadrature_rule.first.data(),
+                          quadrature_rule.second.data());
 
   return quadrature_rule;
 }
@@ -241,55 +364,10 @@ SimplexQuadrature::compute_quadrature_rule_tetrahedron(const std::vector<Point>&
   log(PROGRESS, "Create quadrature rule using given tetrahedron coordinates");
 
   std::pair<std::vector<double>, std::vector<double>> quadrature_rule;
-
-  // Find the determinant of the Jacobian (from ufc_geometry.h)
-  double det = 0; // To keep compiler happy
-
-  switch (gdim)
-  {
-  case 3:
-  {
-    const std::array<double, 9> J = {{coordinates[1].x() - coordinates[0].x(),
-                                      coordinates[2].x() - coordinates[0].x(),
-                                      coordinates[3].x() - coordinates[0].x(),
-                                      coordinates[1].y() - coordinates[0].y(),
-                                      coordinates[2].y() - coordinates[0].y(),
-                                      coordinates[3].y() - coordinates[0].y(),
-                                      coordinates[1].z() - coordinates[0].z(),
-                                      coordinates[2].z() - coordinates[0].z(),
-                                      coordinates[3].z() - coordinates[0].z()}};
-    const std::array<double, 3> d = {{J[4]*J[8] - J[5]*J[7],
-                                      J[2]*J[7] - J[1]*J[8],
-                                      J[1]*J[5] - J[2]*J[4]}};
-    det = J[0]*d[0] + J[3]*d[1] + J[6]*d[2];
-    break;
-  }
-  default:
-    dolfin_error("SimplexQuadrature.cpp",
-                 "compute quadrature rule for tetrahedron",
-                 "Not implemented for dimension ", gdim);
-  }
-
-  // Store points
-  quadrature_rule.first.resize(gdim*_p.size());
-  for (std::size_t i = 0; i < _p.size(); ++i)
-  {
-    for (std::size_t d = 0; d < gdim; ++d)
-    {
-      quadrature_rule.first[d + i*gdim]
-        = _p[i][0]*coordinates[0][d]
-        + _p[i][1]*coordinates[1][d]
-        + _p[i][2]*coordinates[2][d]
-        + (1. - _p[i][0] - _p[i][1] - _p[i][2])*coordinates[3][d];
-    }
-  }
-
-  // Store weights
-  quadrature_rule.second.assign(_w.size(), std::abs(det)/6.0);
-  for (std::size_t i = 0; i < _w.size(); ++i)
-    quadrature_rule.second[i] *= _w[i];
-
-  dolfin_assert(quadrature_rule.first.size() == gdim*quadrature_rule.second.size());
+  quadrature_rule.first.resize(gdim*_w.size());
+  quadrature_rule.second.resize(_w.size());
+  compute_quadrature_rule(coordinates, gdim, quadrature_rule.first.data(),
+                          quadrature_rule.second.data());
 
   return quadrature_rule;
 }
@@ -315,62 +393,125 @@ SimplexQuadrature::compress(std::pair<std::vector<double>, std::vector<double>>&
   log(PROGRESS, "Compressing %d quadrature points down to %d",
       qr.second.size(), N_compressed_min);
 
-  // Copy the input qr since we'll overwrite the input
-  const std::pair<std::vector<double>, std::vector<double>> qr_input = qr;
+  // Check if the choice of points is known for this layout of points
+  static compression_cache cache;
+  std::vector<std::int64_t> key;
+  const bool memoise = compression_key(key, qr.first, gdim, N);
+  std::vector<std::size_t> indices;
+  bool cached = false;
+  if (memoise)
+  {
+#ifdef HAS_OPENMP
+    #pragma omp critical (dolfin_simplex_quadrature_compression)
+#endif
+    {
+      auto it = cache.find(key);
+      if (it != cache.end())
+      {
+        indices = it->second;
+        cached = true;
+      }
+    }
+  }
 
-  // Create Vandermonde-type matrix using a basis of Chebyshev
-  // polynomials of the first kind
-  const Eigen::MatrixXd V = Chebyshev_Vandermonde_matrix(qr_input, gdim, N);
+  std::vector<double> weights;
+  if (cached)
+  {
+    // Only compute the weights for the known points
+    weights = compressed_weights(qr, indices, gdim, N);
+  }
+  else
+  {
+    // Create Vandermonde-type matrix using a basis of Chebyshev
+    // polynomials of the first kind
+    const Eigen::MatrixXd V = Chebyshev_Vandermonde_matrix(qr, gdim, N);
 
-  // A QR decomposition selects the subset of N columns (geometrically
-  // the N columns with same volume as spanned by all M columns).
-  Eigen::ColPivHouseholderQR<Eigen::MatrixXd> QR(V);
-  Eigen::MatrixXd Q = QR.householderQ();
+    // A QR decomposition selects the subset of N columns
+    // (geometrically the N columns with same volume as spanned by all
+    // M columns).
+    Eigen::ColPivHouseholderQR<Eigen::MatrixXd> QR(V);
+    Eigen::MatrixXd Q = QR.householderQ();
 
-  // We do not need the full Q matrix but only what's known as the
-  // "economy size" decomposition
-  Q *= Eigen::MatrixXd::Identity(V.rows(), std::min(V.rows(), V.cols()));
+    // We do not need the full Q matrix but only what's known as the
+    // "economy size" decomposition
+    Q *= Eigen::MatrixXd::Identity(V.rows(), std::min(V.rows(), V.cols()));
 
-  // We'll use Q^T
-  Q.transposeInPlace();
+    // We'll use Q^T
+    Q.transposeInPlace();
 
-  // Compute weights in the new basis
-  Eigen::Map<const Eigen::VectorXd> w_base(qr_input.second.data(),
-					   qr_input.second.size());
-  const Eigen::VectorXd nu = Q*w_base;
+    // Compute weights in the new basis
+    Eigen::Map<const Eigen::VectorXd> w_base(qr.second.data(),
+                                             qr.second.size());
+    const Eigen::VectorXd nu = Q*w_base;
 
-  // Compute new weights
-  const Eigen::VectorXd w_new = Q.colPivHouseholderQr().solve(nu);
+    // Compute new weights
+    const Eigen::VectorXd w_new = Q.colPivHouseholderQr().solve(nu);
 
-  // Construct new qr using the non-zero weights. First find the
-  // indices for these weights.
-  std::vector<std::size_t> indices;
-  for (int i = 0; i < w_new.size(); ++i)
-  {
-    if (std::abs(w_new[i]) > 0.0)
-      indices.push_back(i);
+    // Construct new qr using the non-zero weights. First find the
+    // indices for these weights.
+    for (int i = 0; i < w_new.size(); ++i)
+    {
+      if (std::abs(w_new[i]) > 0.0)
+      {
+        indices.push_back(i);
+        weights.push_back(w_new[i]);
+      }
+    }
+
+    if (memoise)
+    {
+#ifdef HAS_OPENMP
+      #pragma omp critical (dolfin_simplex_quadrature_compression)
+#endif
+      {
+        if (cache.size() >= max_compression_cache_size)
+          cache.clear();
+        cache.insert(std::make_pair(key, indices));
+      }
+    }
   }
 
-  // Resize qr and overwrite the points and weights
+  // Overwrite the points and weights. This can be done in place
+  // since the indices are increasing.
   dolfin_assert(indices.size() <= N_compressed_min);
-  qr.first.resize(gdim*indices.size());
-  qr.second.resize(indices.size());
-
   for (std::size_t i = 0; i < indices.size(); ++i)
   {
     // Save points
     for (std::size_t d = 0; d < gdim; ++d)
-      qr.first[gdim*i + d] = qr_input.first[gdim*indices[i] + d];
+      qr.first[gdim*i + d] = qr.first[gdim*indices[i] + d];
 
     // Save weights
-    qr.second[i] = w_new[indices[i]];
+    qr.second[i] = weights[i];
   }
+  qr.first.resize(gdim*indices.size());
+  qr.second.resize(indices.size());
 
   // Return indices. These are useful for mapping additional data, for
   // example the normals.
   return indices;
 }
 //-----------------------------------------------------------------------------
+std::vector<double> SimplexQuadrature::compressed_weights
+(const std::pair<std::vector<double>, std::vector<double>>& qr,
+ const std::vector<std::size_t>& indices,
+ std::size_t gdim,
+ std::size_t N)
+{
+  // Compute the moments of the Chebyshev basis with the given rule
+  const Eigen::MatrixXd V = Chebyshev_Vandermonde_matrix(qr, gdim, N);
+  Eigen::Map<const Eigen::VectorXd> w_base(qr.second.data(),
+                                           qr.second.size());
+  const Eigen::VectorXd nu = V.transpose()*w_base;
+
+  // Find the weights for the kept points with the same moments
+  Eigen::MatrixXd A(V.cols(), indices.size());
+  for (std::size_t i = 0; i < indices.size(); ++i)
+    A.col(i) = V.row(indices[i]).transpose();
+  const Eigen::VectorXd w = A.colPivHouseholderQr().solve(nu);
+
+  return std::vector<double>(w.data(), w.data() + w.size());
+}
+//-----------------------------------------------------------------------------
 void SimplexQuadrature::setup_qr_reference_interval(std::size_t order)
 {
   // Create quadrature rule with points on reference element [-1, 1].
@@ -32,6 +32,9 @@ namespace dolfin
   class Cell;
 
   /// This class defines quadrature rules for simplices.
+  ///
+  /// The rules on the reference simplex are computed once for each
+  /// topological dimension and order and shared by all instances.
 
   class SimplexQuadrature
   {
@@ -47,6 +50,14 @@ namespace dolfin
     ///
     SimplexQuadrature(std::size_t tdim, std::size_t order);
 
+    /// Return the topological dimension of the simplex
+    std::size_t tdim() const
+    { return _tdim; }
+
+    /// Return the number of quadrature points
+    std::size_t num_points() const
+    { return _w.size(); }
+
     /// Compute quadrature rule for cell.
     ///
     /// *Arguments*
@@ -78,6 +89,53 @@ namespace dolfin
     compute_quadrature_rule(const std::vector<Point>& coordinates,
 			    std::size_t gdim) const;
 
+    /// Compute quadrature rule for simplex without allocating
+    /// memory. The simplex must have the topological dimension of
+    /// the reference simplex.
+    ///
+    /// *Arguments*
+    ///     coordinates (std::vector<Point>)
+    ///         Vertex coordinates for the simplex
+    ///     gdim (std::size_t)
+    ///         The geometric dimension.
+    ///     points (double*)
+    ///         Array of size gdim*num_points() for the (flattened)
+    ///         quadrature points.
+    ///     weights (double*)
+    ///         Array of size num_points() for the quadrature weights.
+    ///
+    /// *Returns*
+    ///     std::size_t
+    ///         The number of quadrature points (zero for a vertex).
+    std::size_t compute_quadrature_rule(const std::vector<Point>& coordinates,
+                                        std::size_t gdim,
+                                        double* points,
+                                        double* weights) const;
+
+    /// Compute quadrature rules for a number of simplices at once.
+    /// The simplices must have the topological dimension of the
+    /// reference simplex.
+    ///
+    /// *Arguments*
+    ///     coordinates (const double*)
+    ///         Packed vertex coordinates, gdim*(tdim + 1) values for
+    ///         each simplex.
+    ///     num_simplices (std::size_t)
+    ///         The number of simplices.
+    ///     gdim (std::size_t)
+    ///         The geometric dimension.
+    ///     points (double*)
+    ///         Array of size num_simplices*gdim*num_points() for the
+    ///         (flattened) quadrature points, ordered by simplex.
+    ///     weights (double*)
+    ///         Array of size num_simplices*num_points() for the
+    ///         quadrature weights, ordered by simplex.
+    void compute_quadrature_rules(const double* coordinates,
+                                  std::size_t num_simplices,
+                                  std::size_t gdim,
+                                  double* points,
+                                  double* weights) const;
+
     /// Compute quadrature rule for interval.
     ///
     /// *Arguments*
@@ -144,6 +202,12 @@ namespace dolfin
     ///     std::vector<std::size_t>
     ///         The indices of the points that were kept (empty
     ///         if no compression was made)
+    ///
+    /// The choice of points only depends on the layout of the points
+    /// relative to their bounding box. It is memoised, so that a rule
+    /// with the same layout (for example on a translated or scaled
+    /// copy of a sub-simplex) only requires the weights to be
+    /// recomputed.
     static std::vector<std::size_t>
     compress(std::pair<std::vector<double>, std::vector<double>>& qr,
 	     std::size_t gdim,
@@ -156,6 +220,14 @@ namespace dolfin
     void setup_qr_reference_triangle(std::size_t order);
     void setup_qr_reference_tetrahedron(std::size_t order);
 
+    // Compute the weights of a compressed rule that uses the given
+    // points of qr, by matching the moments of qr
+    static std::vector<double>
+      compressed_weights
+      (const std::pair<std::vector<double>, std::vector<double>>& qr,
+       const std::vector<std::size_t>& indices,
+       std::size_t gdim, std::size_t N);
+
     // Utility function for computing a Vandermonde type matrix in a
     // Chebyshev basis
     static Eigen::MatrixXd
@@ -277,10 +349,17 @@ namespace dolfin
     static double ts_mult(std::vector<double>& u, double h, int n);
     static double rk2_leg(double t1, double t2, double x, int n);
 
+    // Topological dimension of the reference simplex
+    std::size_t _tdim;
+
     // Quadrature rule on reference simplex (points and weights)
     std::vector<std::vector<double> > _p;
     std::vector<double> _w;
 
+    // Barycentric coordinates of the quadrature points (tdim + 1
+    // values for each point)
+    std::vector<double> _b;
+
   };
 
 }
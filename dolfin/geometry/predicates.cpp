@@ -1,3 +1,4 @@
+#include <vector>
 #include <dolfin/geometry/Point.h>
 #include "predicates.h"
 
@@ -2370,3 +2371,83 @@ namespace dolfin
   /// Initialize the predicate
   PredicateInitialization predicate_initialization;
 }
+
+//-----------------------------------------------------------------------------
+void dolfin::orient2d_batch(const double* a, const double* b, const double* c,
+                            double* det, std::size_t num_points)
+{
+  // Compute approximate determinants and the sums used for the error
+  // bounds (the same quantities as in _orient2d)
+  std::vector<double> detsum(num_points);
+  #ifdef HAS_OPENMP
+  #pragma omp simd
+  #endif
+  for (std::size_t i = 0; i < num_points; i++)
+  {
+    const double detleft = (a[2*i] - c[2*i])*(b[2*i + 1] - c[2*i + 1]);
+    const double detright = (a[2*i + 1] - c[2*i + 1])*(b[2*i] - c[2*i]);
+    det[i] = detleft - detright;
+    detsum[i] = fabs(detleft) + fabs(detright);
+  }
+
+  // Use adaptive exact arithmetic where the sign is uncertain
+  for (std::size_t i = 0; i < num_points; i++)
+  {
+    if (fabs(det[i]) < ccwerrboundA*detsum[i])
+      det[i] = orient2dadapt(a + 2*i, b + 2*i, c + 2*i, detsum[i]);
+  }
+}
+//-----------------------------------------------------------------------------
+void dolfin::orient3d_batch(const double* a, const double* b, const double* c,
+                            const double* d, double* det,
+                            std::size_t num_points)
+{
+  // Compute approximate determinants and permanents used for the
+  // error bounds (the same quantities as in _orient3d)
+  std::vector<double> permanent(num_points);
+  #ifdef HAS_OPENMP
+  #pragma omp simd
+  #endif
+  for (std::size_t i = 0; i < num_points; i++)
+  {
+    const double* pa = a + 3*i;
+    const double* pb = b + 3*i;
+    const double* pc = c + 3*i;
+    const double* pd = d + 3*i;
+
+    const double adx = pa[0] - pd[0];
+    const double bdx = pb[0] - pd[0];
+    const double cdx = pc[0] - pd[0];
+    const double ady = pa[1] - pd[1];
+    const double bdy = pb[1] - pd[1];
+    const double cdy = pc[1] - pd[1];
+    const double adz = pa[2] - pd[2];
+    const double bdz = pb[2] - pd[2];
+    const double cdz = pc[2] - pd[2];
+
+    const double bdxcdy = bdx*cdy;
+    const double cdxbdy = cdx*bdy;
+    const double cdxady = cdx*ady;
+    const double adxcdy = adx*cdy;
+    const double adxbdy = adx*bdy;
+    const double bdxady = bdx*ady;
+
+    det[i] = adz*(bdxcdy - cdxbdy)
+           + bdz*(cdxady - adxcdy)
+           + cdz*(adxbdy - bdxady);
+    permanent[i] = (fabs(bdxcdy) + fabs(cdxbdy))*fabs(adz)
+                 + (fabs(cdxady) + fabs(adxcdy))*fabs(bdz)
+                 + (fabs(adxbdy) + fabs(bdxady))*fabs(cdz);
+  }
+
+  // Use adaptive exact arithmetic where the sign is uncertain
+  for (std::size_t i = 0; i < num_points; i++)
+  {
+    if (fabs(det[i]) <= o3derrboundA*permanent[i])
+    {
+      det[i] = orient3dadapt(a + 3*i, b + 3*i, c + 3*i, d + 3*i,
+                             permanent[i]);
+    }
+  }
+}
+//-----------------------------------------------------------------------------
@@ -12,6 +12,8 @@
 #ifndef __PREDICATES_H
 #define __PREDICATES_H
 
+#include <cstddef>
+
 namespace dolfin
 {
 
@@ -39,6 +41,22 @@ namespace dolfin
   /// Convenience function using dolfin::Point
   double orient3d(const Point& a, const Point& b, const Point& c, const Point& d);
 
+  /// Compute orient2d for num_points triples of 2D points. The
+  /// coordinates are packed, so that triple i is given by a + 2*i,
+  /// b + 2*i and c + 2*i. A floating-point filter is evaluated for
+  /// all triples in a single vectorisable loop and the adaptive exact
+  /// arithmetic is only used for the triples where the sign is
+  /// uncertain. The result for each triple is the same as that of
+  /// _orient2d.
+  void orient2d_batch(const double* a, const double* b, const double* c,
+                      double* det, std::size_t num_points);
+
+  /// Compute orient3d for num_points quadruples of 3D points. The
+  /// coordinates are packed, so that quadruple i is given by a + 3*i,
+  /// b + 3*i, c + 3*i and d + 3*i. See orient2d_batch.
+  void orient3d_batch(const double* a, const double* b, const double* c,
+                      const double* d, double* det, std::size_t num_points);
+
   /// Class used for automatic initialization of tolerances at startup.
   /// A global instance is defined inside predicates.cpp to ensure that
   /// the constructor and thus exactinit() is called.
@@ -24,6 +24,7 @@
 #include <iomanip>
 #include <iostream>
 #include <string>
+#include <utility>
 #include <boost/unordered_map.hpp>
 #include <boost/filesystem.hpp>
 #include <boost/multi_array.hpp>
@@ -1941,7 +1942,8 @@ void HDF5File::read(Mesh& input_mesh,
   else
   {
     const std::string ghost_mode = dolfin::parameters["ghost_mode"];
-    MeshPartitioning::build_distributed_mesh(input_mesh, local_mesh_data, ghost_mode);
+    MeshPartitioning::build_distributed_mesh(input_mesh, std::move(local_mesh_data),
+                                             ghost_mode);
   }
 
 }
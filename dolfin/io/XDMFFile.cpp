@@ -22,6 +22,7 @@
 #include <ostream>
 #include <sstream>
 #include <string>
+#include <utility>
 #include <vector>
 #include <boost/algorithm/string.hpp>
 #include <boost/container/vector.hpp>
@@ -1414,7 +1415,8 @@ void XDMFFile::read(Mesh& mesh) const
 
     // Build mesh
     const std::string ghost_mode = dolfin::parameters["ghost_mode"];
-    MeshPartitioning::build_distributed_mesh(mesh, local_mesh_data, ghost_mode);
+    MeshPartitioning::build_distributed_mesh(mesh, std::move(local_mesh_data),
+                                             ghost_mode);
   }
 }
 //----------------------------------------------------------------------------
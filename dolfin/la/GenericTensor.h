@@ -94,6 +94,35 @@ namespace dolfin
       const std::vector<ArrayView<const dolfin::la_index>>& rows) = 0;
 
 
+    /// Add a batch of blocks of values using local indices. The
+    /// blocks are stored one after the other in block, and rows[i]
+    /// holds the dimension-i indices of all blocks, also stored one
+    /// after the other (each block has rows[i].size()/num_blocks
+    /// indices in dimension i). The default implementation calls
+    /// add_local once per block.
+    virtual void add_local_batch(
+      const double* block, std::size_t num_blocks,
+      const std::vector<ArrayView<const dolfin::la_index>>& rows)
+    {
+      std::vector<ArrayView<const dolfin::la_index>> block_rows(rows.size());
+      std::size_t block_size = 1;
+      for (std::size_t i = 0; i < rows.size(); ++i)
+      {
+        dolfin_assert(rows[i].size() % num_blocks == 0);
+        block_size *= rows[i].size()/num_blocks;
+      }
+
+      for (std::size_t b = 0; b < num_blocks; ++b)
+      {
+        for (std::size_t i = 0; i < rows.size(); ++i)
+        {
+          const std::size_t n = rows[i].size()/num_blocks;
+          block_rows[i].set(n, rows[i].data() + b*n);
+        }
+        add_local(block + b*block_size, block_rows);
+      }
+    }
+
     /// Add block of values using global indices
     virtual void add(const double* block, const dolfin::la_index* num_rows,
                      const dolfin::la_index * const * rows) = 0;
@@ -139,6 +139,12 @@ namespace dolfin
                            std::size_t n, const dolfin::la_index* cols)
     { matrix->add_local(block, m, rows, n, cols); }
 
+    /// Add a batch of blocks of values using local indices
+    virtual void add_local_batch(
+      const double* block, std::size_t num_blocks,
+      const std::vector<ArrayView<const dolfin::la_index>>& rows)
+    { matrix->add_local_batch(block, num_blocks, rows); }
+
     /// Add multiple of given matrix (AXPY operation)
     virtual void axpy(double a, const GenericMatrix& A,
                       bool same_nonzero_pattern)
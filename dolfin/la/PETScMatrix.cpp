@@ -27,6 +27,7 @@
 
 #ifdef HAS_PETSC
 
+#include <algorithm>
 #include <iomanip>
 #include <iostream>
 #include <numeric>
@@ -59,19 +60,22 @@ PETScMatrix::PETScMatrix() : PETScMatrix(MPI_COMM_WORLD)
   // Do nothing
 }
 //-----------------------------------------------------------------------------
-PETScMatrix::PETScMatrix(MPI_Comm comm) : PETScBaseMatrix()
+PETScMatrix::PETScMatrix(MPI_Comm comm) : PETScBaseMatrix(),
+  _values_diag(NULL), _values_offdiag(NULL), _nnz_diag(0)
 {
   // Create uninitialised matrix
   PetscErrorCode ierr = MatCreate(comm, &_matA);
   if (ierr != 0) petsc_error(ierr, __FILE__, "MatCreate");
 }
 //-----------------------------------------------------------------------------
-PETScMatrix::PETScMatrix(Mat A) : PETScBaseMatrix(A)
+PETScMatrix::PETScMatrix(Mat A) : PETScBaseMatrix(A),
+  _values_diag(NULL), _values_offdiag(NULL), _nnz_diag(0)
 {
   // Reference count to A is incremented in base class
 }
 //-----------------------------------------------------------------------------
-PETScMatrix::PETScMatrix(const PETScMatrix& A) : PETScBaseMatrix()
+PETScMatrix::PETScMatrix(const PETScMatrix& A) : PETScBaseMatrix(),
+  _values_diag(NULL), _values_offdiag(NULL), _nnz_diag(0)
 {
   dolfin_assert(A.mat());
   if (!A.empty())
@@ -299,6 +303,25 @@ void PETScMatrix::add_local(const double* block,
   if (ierr != 0) petsc_error(ierr, __FILE__, "MatSetValuesLocal");
 }
 //-----------------------------------------------------------------------------
+void PETScMatrix::add_local_batch(
+  const double* block, std::size_t num_blocks,
+  const std::vector<ArrayView<const dolfin::la_index>>& rows)
+{
+  dolfin_assert(_matA);
+  dolfin_assert(rows.size() == 2);
+  dolfin_assert(rows[0].size() % num_blocks == 0);
+  dolfin_assert(rows[1].size() % num_blocks == 0);
+  const std::size_t m = rows[0].size()/num_blocks;
+  const std::size_t n = rows[1].size()/num_blocks;
+  for (std::size_t b = 0; b < num_blocks; ++b)
+  {
+    PetscErrorCode ierr = MatSetValuesLocal(_matA, m, rows[0].data() + b*m,
+                                            n, rows[1].data() + b*n,
+                                            block + b*m*n, ADD_VALUES);
+    if (ierr != 0) petsc_error(ierr, __FILE__, "MatSetValuesLocal");
+  }
+}
+//-----------------------------------------------------------------------------
 void PETScMatrix::axpy(double a, const GenericMatrix& A,
                        bool same_nonzero_pattern)
 {
@@ -554,6 +577,10 @@ void PETScMatrix::apply(std::string mode)
 {
   Timer timer("Apply (PETScMatrix)");
 
+  // Finish direct insertion if still active
+  if (_values_diag)
+    end_direct_insertion();
+
   dolfin_assert(_matA);
   PetscErrorCode ierr;
   if (mode == "add")
@@ -816,4 +843,243 @@ void PETScMatrix::convert_to_aij()
   }
 }
 //-----------------------------------------------------------------------------
+void PETScMatrix::compute_value_offsets(std::vector<std::int64_t>& offsets,
+                                        std::size_t m,
+                                        const dolfin::la_index* rows,
+                                        std::size_t n,
+                                        const dolfin::la_index* cols) const
+{
+  dolfin_assert(_matA);
+  PetscErrorCode ierr;
+
+  // Check that matrix has been assembled (the AIJ structure is not
+  // complete before the first assembly)
+  PetscBool assembled = PETSC_FALSE;
+  ierr = MatAssembled(_matA, &assembled);
+  if (ierr != 0) petsc_error(ierr, __FILE__, "MatAssembled");
+  if (!assembled)
+  {
+    dolfin_error("PETScMatrix.cpp",
+                 "compute value offsets of PETSc matrix",
+                 "Matrix has not been assembled");
+  }
+
+  // Get diagonal and off-diagonal blocks
+  Mat Ad = NULL, Ao = NULL;
+  const PetscInt* colmap = NULL;
+  get_aij_blocks(Ad, Ao, colmap);
+
+  // Map local indices to global indices
+  ISLocalToGlobalMapping rmapping = NULL, cmapping = NULL;
+  ierr = MatGetLocalToGlobalMapping(_matA, &rmapping, &cmapping);
+  if (ierr != 0) petsc_error(ierr, __FILE__, "MatGetLocalToGlobalMapping");
+  std::vector<PetscInt> global_rows(m), global_cols(n);
+  ierr = ISLocalToGlobalMappingApply(rmapping, m, rows, global_rows.data());
+  if (ierr != 0) petsc_error(ierr, __FILE__, "ISLocalToGlobalMappingApply");
+  ierr = ISLocalToGlobalMappingApply(cmapping, n, cols, global_cols.data());
+  if (ierr != 0) petsc_error(ierr, __FILE__, "ISLocalToGlobalMappingApply");
+
+  // Get ownership ranges
+  PetscInt row0, row1, col0, col1;
+  ierr = MatGetOwnershipRange(_matA, &row0, &row1);
+  if (ierr != 0) petsc_error(ierr, __FILE__, "MatGetOwnershipRange");
+  ierr = MatGetOwnershipRangeColumn(_matA, &col0, &col1);
+  if (ierr != 0) petsc_error(ierr, __FILE__, "MatGetOwnershipRangeColumn");
+
+  // Get CSR structure of diagonal and off-diagonal blocks
+  PetscInt num_rows = 0, num_ghost_cols = 0;
+  const PetscInt *ia_d = NULL, *ja_d = NULL, *ia_o = NULL, *ja_o = NULL;
+  PetscBool done;
+  ierr = MatGetRowIJ(Ad, 0, PETSC_FALSE, PETSC_FALSE, &num_rows, &ia_d, &ja_d,
+                     &done);
+  if (ierr != 0) petsc_error(ierr, __FILE__, "MatGetRowIJ");
+  if (Ao)
+  {
+    ierr = MatGetRowIJ(Ao, 0, PETSC_FALSE, PETSC_FALSE, &num_rows, &ia_o,
+                       &ja_o, &done);
+    if (ierr != 0) petsc_error(ierr, __FILE__, "MatGetRowIJ");
+    ierr = MatGetSize(Ao, NULL, &num_ghost_cols);
+    if (ierr != 0) petsc_error(ierr, __FILE__, "MatGetSize");
+  }
+  const std::int64_t nnz_diag = ia_d[num_rows];
+
+  // Find position of each entry
+  for (std::size_t i = 0; i < m; ++i)
+  {
+    // Mark entries in off-process rows
+    if (global_rows[i] < row0 || global_rows[i] >= row1)
+    {
+      offsets.insert(offsets.end(), n, -1);
+      continue;
+    }
+
+    const PetscInt row = global_rows[i] - row0;
+    for (std::size_t j = 0; j < n; ++j)
+    {
+      const PetscInt col = global_cols[j];
+      std::int64_t pos = -1;
+      if (col >= col0 && col < col1)
+      {
+        // Diagonal block (local column index)
+        const PetscInt* begin = ja_d + ia_d[row];
+        const PetscInt* end = ja_d + ia_d[row + 1];
+        const PetscInt* it = std::lower_bound(begin, end, col - col0);
+        if (it != end && *it == col - col0)
+          pos = it - ja_d;
+      }
+      else if (Ao)
+      {
+        // Off-diagonal block (index into colmap)
+        const PetscInt* c = std::lower_bound(colmap, colmap + num_ghost_cols,
+                                             col);
+        if (c != colmap + num_ghost_cols && *c == col)
+        {
+          const PetscInt ghost_col = c - colmap;
+          const PetscInt* begin = ja_o + ia_o[row];
+          const PetscInt* end = ja_o + ia_o[row + 1];
+          const PetscInt* it = std::lower_bound(begin, end, ghost_col);
+          if (it != end && *it == ghost_col)
+            pos = nnz_diag + (it - ja_o);
+        }
+      }
+
+      if (pos < 0)
+      {
+        dolfin_error("PETScMatrix.cpp",
+                     "compute value offsets of PETSc matrix",
+                     "Entry (%d, %d) is not in the non-zero pattern",
+                     (int) global_rows[i], (int) col);
+      }
+      offsets.push_back(pos);
+    }
+  }
+
+  // Restore CSR structure
+  ierr = MatRestoreRowIJ(Ad, 0, PETSC_FALSE, PETSC_FALSE, &num_rows, &ia_d,
+                         &ja_d, &done);
+  if (ierr != 0) petsc_error(ierr, __FILE__, "MatRestoreRowIJ");
+  if (Ao)
+  {
+    ierr = MatRestoreRowIJ(Ao, 0, PETSC_FALSE, PETSC_FALSE, &num_rows, &ia_o,
+                           &ja_o, &done);
+    if (ierr != 0) petsc_error(ierr, __FILE__, "MatRestoreRowIJ");
+  }
+}
+//-----------------------------------------------------------------------------
+void PETScMatrix::begin_direct_insertion()
+{
+  dolfin_assert(!_values_diag);
+
+  Mat Ad = NULL, Ao = NULL;
+  const PetscInt* colmap = NULL;
+  get_aij_blocks(Ad, Ao, colmap);
+
+  // Get number of non-zeroes in diagonal block
+  MatInfo info;
+  PetscErrorCode ierr = MatGetInfo(Ad, MAT_LOCAL, &info);
+  if (ierr != 0) petsc_error(ierr, __FILE__, "MatGetInfo");
+  _nnz_diag = info.nz_used;
+
+  // Get value arrays
+  ierr = MatSeqAIJGetArray(Ad, &_values_diag);
+  if (ierr != 0) petsc_error(ierr, __FILE__, "MatSeqAIJGetArray");
+  if (Ao)
+  {
+    ierr = MatSeqAIJGetArray(Ao, &_values_offdiag);
+    if (ierr != 0) petsc_error(ierr, __FILE__, "MatSeqAIJGetArray");
+  }
+}
+//-----------------------------------------------------------------------------
+void PETScMatrix::add_local_direct(const double* block,
+                                   std::size_t m,
+                                   const dolfin::la_index* rows,
+                                   std::size_t n,
+                                   const dolfin::la_index* cols,
+                                   const std::int64_t* offsets)
+{
+  dolfin_assert(_values_diag);
+  for (std::size_t i = 0; i < m; ++i)
+  {
+    for (std::size_t j = 0; j < n; ++j)
+    {
+      const std::int64_t pos = offsets[i*n + j];
+      if (pos >= _nnz_diag)
+      {
+        dolfin_assert(_values_offdiag);
+        _values_offdiag[pos - _nnz_diag] += block[i*n + j];
+      }
+      else if (pos >= 0)
+        _values_diag[pos] += block[i*n + j];
+      else
+      {
+        _stash_rows.push_back(rows[i]);
+        _stash_cols.push_back(cols[j]);
+        _stash_values.push_back(block[i*n + j]);
+      }
+    }
+  }
+}
+//-----------------------------------------------------------------------------
+void PETScMatrix::end_direct_insertion()
+{
+  dolfin_assert(_values_diag);
+
+  Mat Ad = NULL, Ao = NULL;
+  const PetscInt* colmap = NULL;
+  get_aij_blocks(Ad, Ao, colmap);
+
+  // Restore value arrays
+  PetscErrorCode ierr = MatSeqAIJRestoreArray(Ad, &_values_diag);
+  if (ierr != 0) petsc_error(ierr, __FILE__, "MatSeqAIJRestoreArray");
+  if (Ao)
+  {
+    ierr = MatSeqAIJRestoreArray(Ao, &_values_offdiag);
+    if (ierr != 0) petsc_error(ierr, __FILE__, "MatSeqAIJRestoreArray");
+  }
+  _values_diag = NULL;
+  _values_offdiag = NULL;
+
+  // Add stashed values (communicated to the owning process by
+  // apply())
+  for (std::size_t k = 0; k < _stash_values.size(); ++k)
+  {
+    ierr = MatSetValuesLocal(_matA, 1, &_stash_rows[k], 1, &_stash_cols[k],
+                             &_stash_values[k], ADD_VALUES);
+    if (ierr != 0) petsc_error(ierr, __FILE__, "MatSetValuesLocal");
+  }
+  _stash_rows.clear();
+  _stash_cols.clear();
+  _stash_values.clear();
+}
+//-----------------------------------------------------------------------------
+void PETScMatrix::get_aij_blocks(Mat& Ad, Mat& Ao,
+                                 const PetscInt*& colmap) const
+{
+  dolfin_assert(_matA);
+  PetscBool is_seqaij = PETSC_FALSE, is_mpiaij = PETSC_FALSE;
+  PetscErrorCode ierr;
+  ierr = PetscObjectTypeCompare((PetscObject)_matA, MATSEQAIJ, &is_seqaij);
+  if (ierr != 0) petsc_error(ierr, __FILE__, "PetscObjectTypeCompare");
+  ierr = PetscObjectTypeCompare((PetscObject)_matA, MATMPIAIJ, &is_mpiaij);
+  if (ierr != 0) petsc_error(ierr, __FILE__, "PetscObjectTypeCompare");
+
+  if (is_mpiaij)
+  {
+    ierr = MatMPIAIJGetSeqAIJ(_matA, &Ad, &Ao, &colmap);
+    if (ierr != 0) petsc_error(ierr, __FILE__, "MatMPIAIJGetSeqAIJ");
+  }
+  else if (is_seqaij)
+  {
+    Ad = _matA;
+    Ao = NULL;
+    colmap = NULL;
+  }
+  else
+  {
+    dolfin_error("PETScMatrix.cpp",
+                 "access local blocks of PETSc matrix",
+                 "Direct insertion requires an AIJ matrix");
+  }
+}
+//-----------------------------------------------------------------------------
 #endif
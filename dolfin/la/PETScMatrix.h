@@ -30,9 +30,11 @@
 
 #ifdef HAS_PETSC
 
+#include <cstdint>
 #include <map>
 #include <memory>
 #include <string>
+#include <vector>
 
 #include <petscmat.h>
 #include <petscsys.h>
@@ -158,6 +160,11 @@ namespace dolfin
                            std::size_t m, const dolfin::la_index* rows,
                            std::size_t n, const dolfin::la_index* cols);
 
+    /// Add a batch of blocks of values using local indices
+    virtual void add_local_batch(
+      const double* block, std::size_t num_blocks,
+      const std::vector<ArrayView<const dolfin::la_index>>& rows);
+
     /// Add multiple of given matrix (AXPY operation)
     virtual void axpy(double a, const GenericMatrix& A,
                       bool same_nonzero_pattern);
@@ -246,8 +253,50 @@ namespace dolfin
     /// Convert matrix to AIJ format
     void convert_to_aij();
 
+    /// Compute the position of each entry of a dense block (given by
+    /// local row and column indices) in the local value arrays of an
+    /// assembled AIJ matrix, and append the positions to offsets.
+    /// Entries in rows that are owned by another process are marked
+    /// with -1. The positions are used by add_local_direct().
+    void compute_value_offsets(std::vector<std::int64_t>& offsets,
+                               std::size_t m, const dolfin::la_index* rows,
+                               std::size_t n, const dolfin::la_index* cols) const;
+
+    /// Begin direct insertion into the local value arrays of the
+    /// matrix
+    void begin_direct_insertion();
+
+    /// Add block of values using local indices, writing directly into
+    /// the local value arrays at the positions computed by
+    /// compute_value_offsets(). Values in rows owned by another
+    /// process are stashed until end_direct_insertion() is called.
+    void add_local_direct(const double* block,
+                          std::size_t m, const dolfin::la_index* rows,
+                          std::size_t n, const dolfin::la_index* cols,
+                          const std::int64_t* offsets);
+
+    /// End direct insertion and add stashed values. apply() must be
+    /// called afterwards to finalise the matrix.
+    void end_direct_insertion();
+
   private:
 
+    // Get local diagonal and off-diagonal blocks of AIJ matrix, and
+    // global column indices of the off-diagonal block (Ao and colmap
+    // are NULL for a sequential matrix)
+    void get_aij_blocks(Mat& Ad, Mat& Ao, const PetscInt*& colmap) const;
+
+    // Value arrays of diagonal and off-diagonal blocks during direct
+    // insertion, and number of non-zeroes in diagonal block
+    PetscScalar* _values_diag;
+    PetscScalar* _values_offdiag;
+    std::int64_t _nnz_diag;
+
+    // Stashed values (local indices) in off-process rows during
+    // direct insertion
+    std::vector<dolfin::la_index> _stash_rows, _stash_cols;
+    std::vector<double> _stash_values;
+
     // Create PETSc nullspace object
     MatNullSpace create_petsc_nullspace(const VectorSpaceBasis& nullspace) const;
 
@@ -158,6 +158,12 @@ namespace dolfin
                            const dolfin::la_index* rows)
     { vector->add_local(block, m, rows); }
 
+    /// Add a batch of blocks of values using local indices
+    virtual void add_local_batch(
+      const double* block, std::size_t num_blocks,
+      const std::vector<ArrayView<const dolfin::la_index>>& rows)
+    { vector->add_local_batch(block, num_blocks, rows); }
+
     /// Get all values on local process
     virtual void get_local(std::vector<double>& values) const
     { vector->get_local(values); }
@@ -73,7 +73,7 @@ void BoundaryComputation::compute_boundary(const Mesh& mesh,
   editor.open(boundary, mesh.type().facet_type(), D - 1, mesh.geometry().dim());
 
   // Generate facet - cell connectivity if not generated
-  mesh.init(D - 1, D);
+  mesh.init_transient(D - 1, D);
 
   // Temporary arrays for assignment of indices to vertices on the boundary
   std::map<std::size_t, std::size_t> boundary_vertices;
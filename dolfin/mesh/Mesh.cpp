@@ -218,6 +218,16 @@ void Mesh::init(std::size_t d0, std::size_t d1) const
     mesh->order();
 }
 //-----------------------------------------------------------------------------
+void Mesh::init_transient(std::size_t d0, std::size_t d1) const
+{
+  // Connectivity that exists already keeps its state
+  const bool computed = !_topology(d0, d1).empty();
+
+  init(d0, d1);
+  if (!computed and d1 > 0 and !_topology(d0, d1).empty())
+    _topology.set_transient(d0, d1, true);
+}
+//-----------------------------------------------------------------------------
 void Mesh::init() const
 {
   // Compute all entities
@@ -278,6 +288,12 @@ dolfin::Mesh Mesh::renumber_by_color() const
   return MeshRenumbering::renumber_by_color(*this, coloring_type);
 }
 //-----------------------------------------------------------------------------
+std::pair<std::vector<std::size_t>, std::vector<std::size_t>>
+Mesh::reorder(std::string method)
+{
+  return MeshRenumbering::reorder(*this, method);
+}
+//-----------------------------------------------------------------------------
 void Mesh::scale(double factor)
 {
   MeshTransformation::scale(*this, factor);
@@ -306,6 +306,20 @@ namespace dolfin
     ///         Topological dimension.
     void init(std::size_t d0, std::size_t d1) const;
 
+    /// Compute connectivity between given pair of dimensions and
+    /// mark it as transient (see MeshTopology::set_transient) if it
+    /// has not been computed before. Use for connectivity that is
+    /// only needed temporarily. The connectivity is not released
+    /// automatically; call MeshTopology::evict() (when no mesh
+    /// entity iterators over it are in use) to release it.
+    ///
+    /// @param    d0 (std::size_t)
+    ///         Topological dimension.
+    ///
+    /// @param    d1 (std::size_t)
+    ///         Topological dimension.
+    void init_transient(std::size_t d0, std::size_t d1) const;
+
     /// Compute all entities and connectivity.
     void init() const;
 
@@ -337,6 +351,18 @@ namespace dolfin
     /// @return Mesh
     Mesh renumber_by_color() const;
 
+    /// Reorder cells and vertices in place to improve data locality
+    /// (see MeshRenumbering::reorder).
+    ///
+    /// @param    method (std::string)
+    ///         "hilbert", "morton" or "rcm".
+    /// @return std::pair<std::vector<std::size_t>, std::vector<std::size_t>>
+    ///         New index of each (old) vertex and of each (old) cell,
+    ///         for renumbering mesh functions with
+    ///         MeshRenumbering::reorder.
+    std::pair<std::vector<std::size_t>, std::vector<std::size_t>>
+      reorder(std::string method="hilbert");
+
     /// Scale mesh coordinates with given factor.
     ///
     /// *Arguments*
@@ -518,6 +544,7 @@ namespace dolfin
     friend class MeshEditor;
     friend class TopologyComputation;
     friend class MeshPartitioning;
+    friend class MeshRenumbering;
 
     // Mesh topology
     mutable MeshTopology _topology;
@@ -20,6 +20,9 @@
 // First added:  2006-05-09
 // Last changed: 2014-01-09
 
+#include <algorithm>
+#include <cstdint>
+#include <limits>
 #include <sstream>
 #include <boost/functional/hash.hpp>
 #include <dolfin/log/log.h>
@@ -27,15 +30,50 @@
 
 using namespace dolfin;
 
+namespace
+{
+  // Append unsigned integer as variable-length integer (7 bits per
+  // byte, high bit set on all but the last byte)
+  void write_varint(std::vector<unsigned char>& data, std::uint64_t value)
+  {
+    while (value >= 0x80)
+    {
+      data.push_back(static_cast<unsigned char>(value | 0x80));
+      value >>= 7;
+    }
+    data.push_back(static_cast<unsigned char>(value));
+  }
+
+  // Read variable-length integer and advance position
+  std::uint64_t read_varint(const unsigned char*& p)
+  {
+    std::uint64_t value = 0;
+    unsigned int shift = 0;
+    while (*p & 0x80)
+    {
+      value |= static_cast<std::uint64_t>(*p++ & 0x7f) << shift;
+      shift += 7;
+    }
+    value |= static_cast<std::uint64_t>(*p++) << shift;
+    return value;
+  }
+
+  // Read zigzag encoded difference and advance position
+  std::int64_t read_difference(const unsigned char*& p)
+  {
+    const std::uint64_t z = read_varint(p);
+    return static_cast<std::int64_t>(z >> 1) ^ -static_cast<std::int64_t>(z & 1);
+  }
+}
 //-----------------------------------------------------------------------------
 MeshConnectivity::MeshConnectivity(std::size_t d0, std::size_t d1)
-  : _d0(d0), _d1(d1)
+  : _d0(d0), _d1(d1), _num_entities(0), _stride(0), _num_compressed(0)
 {
   // Do nothing
 }
 //-----------------------------------------------------------------------------
 MeshConnectivity::MeshConnectivity(const MeshConnectivity& connectivity)
-  : _d0(0), _d1(0)
+  : _d0(0), _d1(0), _num_entities(0), _stride(0), _num_compressed(0)
 {
   *this = connectivity;
 }
@@ -53,7 +91,12 @@ MeshConnectivity::operator= (const MeshConnectivity& connectivity)
   _d1 = connectivity._d1;
   _connections = connectivity._connections;
   _num_global_connections = connectivity._num_global_connections;
+  _num_entities = connectivity._num_entities;
+  _stride = connectivity._stride;
   index_to_position = connectivity.index_to_position;
+  _compressed_connections = connectivity._compressed_connections;
+  _compressed_offsets = connectivity._compressed_offsets;
+  _num_compressed = connectivity._num_compressed;
 
   return *this;
 }
@@ -62,6 +105,120 @@ void MeshConnectivity::clear()
 {
   std::vector<unsigned int>().swap(_connections);
   std::vector<unsigned int>().swap(index_to_position);
+  std::vector<unsigned char>().swap(_compressed_connections);
+  std::vector<unsigned int>().swap(_compressed_offsets);
+  _num_entities = 0;
+  _stride = 0;
+  _num_compressed = 0;
+}
+//-----------------------------------------------------------------------------
+void MeshConnectivity::compress()
+{
+  // Skip if already compressed or if offsets are implicit
+  if (compressed() or _stride > 0 or _num_entities == 0)
+    return;
+
+  // Encode number of connections and differences between consecutive
+  // connections (zigzag encoded to handle negative differences) for
+  // each entity. Entities are encoded independently so that they can
+  // be decoded in any order.
+  std::vector<unsigned char> data;
+  std::vector<unsigned int> offsets(_num_entities);
+  data.reserve(_num_entities + _connections.size());
+  for (std::size_t e = 0; e < _num_entities; e++)
+  {
+    // Keep uncompressed storage if positions would overflow
+    if (data.size() > std::numeric_limits<unsigned int>::max())
+      return;
+
+    offsets[e] = data.size();
+    const std::size_t n = index_to_position[e + 1] - index_to_position[e];
+    write_varint(data, n);
+    std::int64_t previous = 0;
+    for (std::size_t i = index_to_position[e]; i < index_to_position[e + 1];
+         i++)
+    {
+      const std::int64_t diff = (std::int64_t) _connections[i] - previous;
+      write_varint(data, (static_cast<std::uint64_t>(diff) << 1)
+                   ^ static_cast<std::uint64_t>(diff >> 63));
+      previous = _connections[i];
+    }
+  }
+  data.shrink_to_fit();
+
+  // Replace uncompressed data
+  _num_compressed = _connections.size();
+  _compressed_connections.swap(data);
+  _compressed_offsets.swap(offsets);
+  std::vector<unsigned int>().swap(_connections);
+  std::vector<unsigned int>().swap(index_to_position);
+}
+//-----------------------------------------------------------------------------
+void MeshConnectivity::decompress()
+{
+  if (!compressed())
+    return;
+
+  index_to_position.resize(_num_entities + 1);
+  _connections.resize(_num_compressed);
+
+  // Decode connections
+  const unsigned char* p = _compressed_connections.data();
+  std::size_t pos = 0;
+  for (std::size_t e = 0; e < _num_entities; e++)
+  {
+    index_to_position[e] = pos;
+    const std::size_t n = read_varint(p);
+    std::int64_t previous = 0;
+    for (std::size_t i = 0; i < n; i++)
+    {
+      previous += read_difference(p);
+      dolfin_assert(pos < _connections.size());
+      _connections[pos++] = previous;
+    }
+  }
+  index_to_position[_num_entities] = pos;
+  dolfin_assert(pos == _num_compressed);
+  dolfin_assert(p == _compressed_connections.data()
+                + _compressed_connections.size());
+
+  std::vector<unsigned char>().swap(_compressed_connections);
+  std::vector<unsigned int>().swap(_compressed_offsets);
+  _num_compressed = 0;
+}
+//-----------------------------------------------------------------------------
+std::size_t MeshConnectivity::compressed_size(std::size_t entity) const
+{
+  if (entity >= _num_entities)
+    return 0;
+  const unsigned char* p
+    = _compressed_connections.data() + _compressed_offsets[entity];
+  return read_varint(p);
+}
+//-----------------------------------------------------------------------------
+void MeshConnectivity::decode(std::size_t entity,
+                              std::vector<unsigned int>& connections) const
+{
+  dolfin_assert(entity < _num_entities);
+  const unsigned char* p
+    = _compressed_connections.data() + _compressed_offsets[entity];
+  const std::size_t n = read_varint(p);
+  connections.resize(n);
+  std::int64_t previous = 0;
+  for (std::size_t i = 0; i < n; i++)
+  {
+    previous += read_difference(p);
+    connections[i] = previous;
+  }
+}
+//-----------------------------------------------------------------------------
+std::size_t MeshConnectivity::memory_usage() const
+{
+  return sizeof(unsigned int)*(_connections.capacity()
+                               + _num_global_connections.capacity()
+                               + index_to_position.capacity()
+                               + _compressed_offsets.capacity())
+    + _compressed_connections.capacity();
 }
 //-----------------------------------------------------------------------------
 void MeshConnectivity::init(std::size_t num_entities,
@@ -76,11 +233,13 @@ void MeshConnectivity::init(std::size_t num_entities,
   // Allocate
   _connections.resize(size);
   std::fill(_connections.begin(), _connections.end(), 0);
-  index_to_position.resize(num_entities + 1);
+  _num_entities = num_entities;
 
-  // Initialize data
-  for (std::size_t e = 0; e < index_to_position.size(); e++)
-    index_to_position[e] = e*num_connections;
+  // Offsets are implicit unless there are no connections
+  if (num_connections > 0)
+    _stride = num_connections;
+  else
+    index_to_position.assign(num_entities + 1, 0);
 }
 //-----------------------------------------------------------------------------
 void MeshConnectivity::init(std::vector<std::size_t>& num_connections)
@@ -88,8 +247,20 @@ void MeshConnectivity::init(std::vector<std::size_t>& num_connections)
   // Clear old data if any
   clear();
 
-  // Initialize offsets and compute total size
+  // Use implicit offsets if the number of connections is the same
+  // for all entities
   const std::size_t num_entities = num_connections.size();
+  if (num_entities > 0 and num_connections[0] > 0
+      and std::all_of(num_connections.begin(), num_connections.end(),
+                      [&num_connections](std::size_t n)
+                      { return n == num_connections[0]; }))
+  {
+    init(num_entities, num_connections[0]);
+    return;
+  }
+
+  // Initialize offsets and compute total size
+  _num_entities = num_entities;
   index_to_position.resize(num_entities + 1);
   std::size_t size = 0;
   for (std::size_t e = 0; e < num_entities; e++)
@@ -107,29 +278,37 @@ void MeshConnectivity::init(std::vector<std::size_t>& num_connections)
 void MeshConnectivity::set(std::size_t entity, std::size_t connection,
                            std::size_t pos)
 {
-  dolfin_assert((entity + 1) < index_to_position.size());
-  dolfin_assert(pos < index_to_position[entity + 1]
-                - index_to_position[entity]);
-  _connections[index_to_position[entity] + pos] = connection;
+  dolfin_assert(entity < _num_entities);
+  dolfin_assert(pos < size(entity));
+  _connections[offset(entity) + pos] = connection;
 }
 //-----------------------------------------------------------------------------
 void MeshConnectivity::set(std::size_t entity, std::size_t* connections)
 {
-  dolfin_assert((entity + 1) < index_to_position.size());
+  dolfin_assert(entity < _num_entities);
   dolfin_assert(connections);
 
   // Copy data
-  const std::size_t num_connections
-    = index_to_position[entity + 1] - index_to_position[entity];
-  std::copy(connections, connections + num_connections,
-            _connections.begin() + index_to_position[entity]);
+  std::copy(connections, connections + size(entity),
+            _connections.begin() + offset(entity));
 }
 //-----------------------------------------------------------------------------
 std::size_t MeshConnectivity::hash() const
 {
-  // Compute local hash key
+  // Compute local hash key (of the decoded connections if
+  // compressed)
   boost::hash<std::vector<unsigned int>> uhash;
-  return uhash(_connections);
+  if (!compressed())
+    return uhash(_connections);
+
+  std::vector<unsigned int> connections, buffer;
+  connections.reserve(_num_compressed);
+  for (std::size_t e = 0; e < _num_entities; e++)
+  {
+    decode(e, buffer);
+    connections.insert(connections.end(), buffer.begin(), buffer.end());
+  }
+  return uhash(connections);
 }
 //-----------------------------------------------------------------------------
 std::string MeshConnectivity::str(bool verbose) const
@@ -139,21 +318,20 @@ std::string MeshConnectivity::str(bool verbose) const
   if (verbose)
   {
     s << str(false) << std::endl << std::endl;
-    for (std::size_t e = 0; e < index_to_position.size() - 1; e++)
+    std::vector<unsigned int> buffer;
+    for (std::size_t e = 0; e < _num_entities; e++)
     {
+      const unsigned int* connections = (*this)(e, buffer);
       s << "  " << e << ":";
-      for (std::size_t i = index_to_position[e]; i < index_to_position[e + 1];
-           i++)
-      {
-        s << " " << _connections[i];
-      }
+      for (std::size_t i = 0; i < size(e); i++)
+        s << " " << connections[i];
       s << std::endl;
     }
   }
   else
   {
     s << "<MeshConnectivity " << _d0 << " -- " << _d1 << " of size "
-      << _connections.size() << ">";
+      << size() << ">";
   }
 
   return s.str();
@@ -35,6 +35,18 @@ namespace dolfin
   /// number of entities and the number of connections for each entity,
   /// which may either be equal for all entities or different, or by
   /// giving the entire (sparse) connectivity pattern.
+  ///
+  /// If all entities have the same number of connections (e.g. cell
+  /// -- vertex or cell -- facet), the position of the connections for
+  /// an entity is computed from its index and no offset array is
+  /// stored. Connectivities with a variable number of connections
+  /// (e.g. vertex -- cell) can be compressed by compress(). The
+  /// compressed form is then the stored form: the connections of an
+  /// entity are decoded on access by the mesh entity iterators, by
+  /// MeshEntity and by operator()(entity, buffer). Decoding does not
+  /// modify the connectivity, so it may be done from several
+  /// threads. The pointer accessors operator()(entity) and
+  /// operator()() need uncompressed storage (see decompress()).
 
   class MeshConnectivity
   {
@@ -54,19 +66,26 @@ namespace dolfin
 
     /// Return true if the total number of connections is equal to zero
     bool empty() const
-    { return _connections.empty(); }
+    { return _connections.empty() and !compressed(); }
 
     /// Return total number of connections
     std::size_t size() const
-    { return _connections.size(); }
+    { return compressed() ? _num_compressed : _connections.size(); }
 
     /// Return number of connections for given entity
     std::size_t size(std::size_t entity) const
     {
-      return (entity + 1) < index_to_position.size()
-          ? index_to_position[entity + 1] - index_to_position[entity] : 0;
+      if (_stride > 0)
+        return entity < _num_entities ? _stride : 0;
+      if ((entity + 1) < index_to_position.size())
+        return index_to_position[entity + 1] - index_to_position[entity];
+      return compressed() ? compressed_size(entity) : 0;
     }
 
+    /// Return true if the global number of connections has been set
+    bool have_global_size() const
+    { return !_num_global_connections.empty(); }
+
     /// Return global number of connections for given entity
     std::size_t size_global(std::size_t entity) const
     {
@@ -79,20 +98,60 @@ namespace dolfin
       }
     }
 
-    /// Return array of connections for given entity
+    /// Return array of connections for given entity (the
+    /// connectivity must not be compressed)
     const unsigned int* operator() (std::size_t entity) const
     {
-      return (entity + 1) < index_to_position.size()
-        ? &_connections[index_to_position[entity]] : 0;
+      if (_stride > 0)
+        return entity < _num_entities ? &_connections[entity*_stride] : 0;
+      if ((entity + 1) < index_to_position.size())
+        return &_connections[index_to_position[entity]];
+      if (compressed())
+      {
+        dolfin_error("MeshConnectivity.h",
+                     "access mesh connectivity",
+                     "Connectivity is compressed. Use operator()(entity, buffer) or decompress()");
+      }
+      return 0;
+    }
+
+    /// Return array of connections for given entity. Compressed
+    /// connections are decoded into the given buffer, so the
+    /// returned array is valid until the buffer is next modified.
+    const unsigned int* operator() (std::size_t entity,
+                                    std::vector<unsigned int>& buffer) const
+    {
+      if (!compressed())
+        return (*this)(entity);
+      decode(entity, buffer);
+      return buffer.data();
     }
 
     /// Return contiguous array of connections for all entities
+    /// (empty if the connectivity is compressed)
     const std::vector<unsigned int>& operator() () const
     { return _connections; }
 
     /// Clear all data
     void clear();
 
+    /// Compress connections using a delta and variable-length
+    /// integer encoding. Connectivities with a fixed number of
+    /// connections per entity are not changed. The connections stay
+    /// compressed until decompress() is called and are decoded for
+    /// one entity at a time on access.
+    void compress();
+
+    /// Restore uncompressed storage of compressed connections
+    void decompress();
+
+    /// Return true if the connections are stored in compressed form
+    bool compressed() const
+    { return !_compressed_connections.empty(); }
+
+    /// Return memory used by the connectivity (in bytes)
+    std::size_t memory_usage() const;
+
     /// Initialize number of entities and number of connections (equal
     /// for all)
     void init(std::size_t num_entities, std::size_t num_connections);
@@ -109,13 +168,12 @@ namespace dolfin
     template<typename T>
     void set(std::size_t entity, const T& connections)
     {
-      dolfin_assert((entity + 1) < index_to_position.size());
-      dolfin_assert(connections.size()
-                    == index_to_position[entity + 1]-index_to_position[entity]);
+      dolfin_assert(entity < _num_entities);
+      dolfin_assert(connections.size() == size(entity));
 
       // Copy data
       std::copy(connections.begin(), connections.end(),
-                _connections.begin() + index_to_position[entity]);
+                _connections.begin() + offset(entity));
     }
 
     /// Set all connections for given entity
@@ -130,15 +188,32 @@ namespace dolfin
       // Clear old data if any
       clear();
 
-      // Initialize offsets and compute total size
-      index_to_position.resize(connections.size() + 1);
-      std::int32_t size = 0;
+      // Check if the number of connections is the same for all
+      // entities
+      _num_entities = connections.size();
+      const std::size_t stride
+        = connections.size() > 0 ? connections[0].size() : 0;
+      bool fixed = stride > 0;
       for (std::size_t e = 0; e < connections.size(); e++)
+        fixed = fixed and connections[e].size() == stride;
+
+      // Initialize offsets (if any) and compute total size
+      std::int32_t size = 0;
+      if (fixed)
+      {
+        _stride = stride;
+        size = _num_entities*stride;
+      }
+      else
       {
-        index_to_position[e] = size;
-        size += connections[e].size();
+        index_to_position.resize(connections.size() + 1);
+        for (std::size_t e = 0; e < connections.size(); e++)
+        {
+          index_to_position[e] = size;
+          size += connections[e].size();
+        }
+        index_to_position[connections.size()] = size;
       }
-      index_to_position[connections.size()] = size;
 
       // Initialize connections
       _connections.reserve(size);
@@ -152,8 +227,7 @@ namespace dolfin
     void
       set_global_size(const std::vector<unsigned int>& num_global_connections)
     {
-      dolfin_assert(num_global_connections.size()
-                    == index_to_position.size() - 1);
+      dolfin_assert(num_global_connections.size() == _num_entities);
       _num_global_connections = num_global_connections;
     }
 
@@ -165,6 +239,17 @@ namespace dolfin
 
   private:
 
+    // Return position of first connection for given entity
+    std::size_t offset(std::size_t entity) const
+    { return _stride > 0 ? entity*_stride : index_to_position[entity]; }
+
+    // Return number of connections for given entity from compressed
+    // storage
+    std::size_t compressed_size(std::size_t entity) const;
+
+    // Decode compressed connections of given entity
+    void decode(std::size_t entity, std::vector<unsigned int>& connections) const;
+
     // Dimensions (only used for pretty-printing)
     std::size_t _d0, _d1;
 
@@ -175,9 +260,29 @@ namespace dolfin
     // computed)
     std::vector<unsigned int> _num_global_connections;
 
-    // Position of first connection for each entity (using local index)
+    // Number of entities
+    std::size_t _num_entities;
+
+    // Number of connections for each entity if equal for all
+    // entities, otherwise zero
+    std::size_t _stride;
+
+    // Position of first connection for each entity (using local
+    // index), empty if the number of connections is fixed
     std::vector<unsigned int> index_to_position;
 
+    // Number of connections for each entity followed by the
+    // differences between consecutive connections, as variable-length
+    // integers (empty if not compressed)
+    std::vector<unsigned char> _compressed_connections;
+
+    // Position of compressed connections for each entity in
+    // _compressed_connections (empty if not compressed)
+    std::vector<unsigned int> _compressed_offsets;
+
+    // Total number of connections when compressed
+    std::size_t _num_compressed;
+
   };
 
 }
@@ -73,8 +73,8 @@ bool MeshEntity::incident(const MeshEntity& entity) const
     return false;
 
   // Get list of entities for given topological dimension
-  const unsigned int* entities = _mesh->topology()(_dim, entity._dim)(_local_index);
-  const std::size_t num_entities = _mesh->topology()(_dim, entity._dim).size(_local_index);
+  const unsigned int* entities = this->entities(entity._dim);
+  const std::size_t num_entities = this->num_entities(entity._dim);
 
   // Check if any entity matches
   for (std::size_t i = 0; i < num_entities; ++i)
@@ -96,8 +96,8 @@ std::size_t MeshEntity::index(const MeshEntity& entity) const
   }
 
   // Get list of entities for given topological dimension
-  const unsigned int* entities = _mesh->topology()(_dim, entity._dim)(_local_index);
-  const std::size_t num_entities = _mesh->topology()(_dim, entity._dim).size(_local_index);
+  const unsigned int* entities = this->entities(entity._dim);
+  const std::size_t num_entities = this->num_entities(entity._dim);
 
   // Check if any entity matches
   for (std::size_t i = 0; i < num_entities; ++i)
@@ -153,7 +153,9 @@ namespace dolfin
     { return _mesh->topology()(_dim, dim).size_global(_local_index); }
 
     /// Return array of indices for incident mesh entities of given
-    /// topological dimension
+    /// topological dimension. If the connectivity is compressed, the
+    /// indices are decoded into storage held by this entity, which
+    /// is reused by the next call for a compressed connectivity.
     ///
     /// @param     dim (std::size_t)
     ///         The topological dimension.
@@ -163,8 +165,9 @@ namespace dolfin
     const unsigned int* entities(std::size_t dim) const
     {
       const unsigned int* initialized_mesh_entities
-        = _mesh->topology()(_dim, dim)(_local_index);
-      dolfin_assert(initialized_mesh_entities);
+        = _mesh->topology()(_dim, dim)(_local_index, _connections);
+      dolfin_assert(initialized_mesh_entities
+                    or num_entities(dim) == 0);
       return initialized_mesh_entities;
     }
 
@@ -266,6 +269,9 @@ namespace dolfin
     // Local index of entity within topological dimension
     std::size_t _local_index;
 
+    // Incident entities decoded from compressed connectivity
+    mutable std::vector<unsigned int> _connections;
+
   };
 
 }
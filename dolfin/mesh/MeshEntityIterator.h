@@ -130,14 +130,29 @@ namespace dolfin
       else
       {
         pos_end = c.size(entity.index());
-        index = c(entity.index());
+        index = c(entity.index(), _connections);
       }
     }
 
     /// Copy constructor
     MeshEntityIterator(const MeshEntityIterator& it)
       : _entity(it._entity), _pos(it._pos), pos_end(it.pos_end),
-      index(it.index) {}
+      index(it.index), _connections(it._connections)
+    {
+      if (!_connections.empty())
+        index = _connections.data();
+    }
+
+    /// Assignment
+    MeshEntityIterator& operator=(const MeshEntityIterator& it)
+    {
+      _entity = it._entity;
+      _pos = it._pos;
+      pos_end = it.pos_end;
+      _connections = it._connections;
+      index = _connections.empty() ? it.index : _connections.data();
+      return *this;
+    }
 
     /// Destructor
     virtual ~MeshEntityIterator() {}
@@ -169,7 +184,9 @@ namespace dolfin
       // request for entity)
       return ((const_cast<MeshEntityIterator *>(this))->operator*()
             == (const_cast<MeshEntityIterator *>(&it))->operator*()
-            && _pos == it._pos && index == it.index);
+            && _pos == it._pos && (index == it.index
+                                   || (!_connections.empty()
+                                       && _connections == it._connections)));
     }
 
     /// Comparison operator
@@ -223,6 +240,10 @@ namespace dolfin
     // Mapping from pos to index (if any)
     const unsigned int* index;
 
+    // Incident entities decoded from compressed connectivity (index
+    // points to these if not empty)
+    std::vector<unsigned int> _connections;
+
   };
 
 }
@@ -97,13 +97,29 @@ namespace dolfin
       else
       {
         pos_end = c.size(entity.index());
-        index = c(entity.index());
+        index = c(entity.index(), _connections);
       }
     }
 
     /// Copy constructor
     MeshEntityIteratorBase(const MeshEntityIteratorBase& it)
-      : _entity(it._entity), _pos(it._pos), pos_end(it.pos_end), index(it.index) {}
+      : _entity(it._entity), _pos(it._pos), pos_end(it.pos_end),
+      index(it.index), _connections(it._connections)
+    {
+      if (!_connections.empty())
+        index = _connections.data();
+    }
+
+    /// Assignment
+    MeshEntityIteratorBase& operator=(const MeshEntityIteratorBase& it)
+    {
+      _entity = it._entity;
+      _pos = it._pos;
+      pos_end = it.pos_end;
+      _connections = it._connections;
+      index = _connections.empty() ? it.index : _connections.data();
+      return *this;
+    }
 
     /// Destructor
     ~MeshEntityIteratorBase() {}
@@ -135,7 +151,9 @@ namespace dolfin
 
       return ((const_cast<MeshEntityIteratorBase<T> *>(this))->operator*()
             == (const_cast<MeshEntityIteratorBase<T> *>(&it))->operator*()
-            && _pos == it._pos && index == it.index);
+            && _pos == it._pos && (index == it.index
+                                   || (!_connections.empty()
+                                       && _connections == it._connections)));
     }
 
     /// Comparison operator
@@ -188,6 +206,10 @@ namespace dolfin
     // Mapping from pos to index (if any)
     const unsigned int* index;
 
+    // Incident entities decoded from compressed connectivity (index
+    // points to these if not empty)
+    std::vector<unsigned int> _connections;
+
   };
 
 }
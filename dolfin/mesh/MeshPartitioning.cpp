@@ -112,6 +112,22 @@ void MeshPartitioning::build_distributed_mesh(Mesh& mesh,
                                               const LocalMeshData& local_data,
                                               const std::string ghost_mode)
 {
+  build_distributed_mesh(mesh, local_data, ghost_mode, NULL);
+}
+//-----------------------------------------------------------------------------
+void MeshPartitioning::build_distributed_mesh(Mesh& mesh,
+                                              LocalMeshData&& local_data,
+                                              const std::string ghost_mode)
+{
+  build_distributed_mesh(mesh, local_data, ghost_mode, &local_data);
+}
+//-----------------------------------------------------------------------------
+void MeshPartitioning::build_distributed_mesh(Mesh& mesh,
+                                              const LocalMeshData& local_data,
+                                              const std::string ghost_mode,
+                                              LocalMeshData* owned_data)
+{
+  dolfin_assert(!owned_data or owned_data == &local_data);
   log(PROGRESS, "Building distributed mesh");
 
   Timer timer("Build distributed mesh from local mesh data");
@@ -153,7 +169,8 @@ void MeshPartitioning::build_distributed_mesh(Mesh& mesh,
   }
 
   // Build mesh from local mesh data and provided cell partition
-  build(mesh, local_data, cell_partition, ghost_procs, ghost_mode);
+  build(mesh, local_data, cell_partition, ghost_procs, ghost_mode,
+        owned_data);
 
   // Create MeshDomains from local_data
   // FIXME: probably not working with ghost cells?
@@ -210,7 +227,8 @@ MeshPartitioning::partition_cells(const MPI_Comm& mpi_comm,
 void MeshPartitioning::build(Mesh& mesh, const LocalMeshData& mesh_data,
                              const std::vector<int>& cell_partition,
                              const std::map<std::int64_t, std::vector<int>>& ghost_procs,
-                             const std::string ghost_mode)
+                             const std::string ghost_mode,
+                             LocalMeshData* owned_data)
 {
   // Distribute cells
   log(PROGRESS, "Distribute mesh (cell and vertices)");
@@ -246,6 +264,15 @@ void MeshPartitioning::build(Mesh& mesh, const LocalMeshData& mesh_data,
                        new_cell_vertices, new_global_cell_indices,
                        new_cell_partition, shared_cells);
 
+  // Release distributed cell data
+  if (owned_data)
+  {
+    owned_data->topology.cell_vertices.resize(boost::extents[0][0]);
+    std::vector<std::int64_t>().swap(owned_data->topology.global_cell_indices);
+    std::vector<int>().swap(owned_data->topology.cell_partition);
+    std::vector<std::size_t>().swap(owned_data->topology.cell_weight);
+  }
+
   if (ghost_mode == "shared_vertex")
   {
     // Send/receive additional cells defined by connectivity to the shared
@@ -326,6 +353,13 @@ void MeshPartitioning::build(Mesh& mesh, const LocalMeshData& mesh_data,
                       vertex_coordinates, vertex_global_to_local,
                       shared_vertices);
 
+  // Release distributed vertex data
+  if (owned_data)
+  {
+    owned_data->geometry.vertex_coordinates.resize(boost::extents[0][0]);
+    std::vector<std::int64_t>().swap(owned_data->geometry.vertex_indices);
+  }
+
   timer.stop();
 
   // Build lcoal mesh from new_mesh_data
@@ -739,77 +773,39 @@ MeshPartitioning::distribute_cells(
     }
   }
 
-  // Send all cells to their destinations including their global
-  // indices.  First element of vector is cell count of unghosted
-  // cells, second element is count of ghost cells.
+  // Count cells (unghosted and ghosted) sent to each process
   std::vector<std::vector<std::size_t>>
-    send_cell_vertices(mpi_size, std::vector<std::size_t>(2, 0));
-
+    send_cell_count(mpi_size, std::vector<std::size_t>(2, 0));
   for (unsigned int i = 0; i != cell_partition.size(); ++i)
   {
-    // If cell is in ghost_procs map, use that to determine
-    // destinations, otherwise just use the cell_partition vector
     auto map_it = ghost_procs.find(i);
     if (map_it != ghost_procs.end())
     {
       const std::vector<int>& destinations = map_it->second;
       for (auto dest = destinations.begin(); dest != destinations.end(); ++dest)
-      {
-        // Create reference to destination vector
-        std::vector<std::size_t>& send_cell_dest = send_cell_vertices[*dest];
-
-        // Count of ghost cells, followed by ghost processes
-        send_cell_dest.push_back(destinations.size());
-        send_cell_dest.insert(send_cell_dest.end(), destinations.begin(),
-                              destinations.end());
-
-        // Global cell index
-        send_cell_dest.push_back(mesh_data.topology.global_cell_indices[i]);
-
-        // Global vertex indices
-        send_cell_dest.insert(send_cell_dest.end(),
-                              mesh_data.topology.cell_vertices[i].begin(),
-                              mesh_data.topology.cell_vertices[i].end());
-
-        // First entry is the owner, so this counts as a 'local' cell
-        // subsequent entries are 'remote ghosts'
-        if (dest == destinations.begin())
-          send_cell_dest[0]++;
-        else
-          send_cell_dest[1]++;
-      }
+        ++send_cell_count[*dest][dest == destinations.begin() ? 0 : 1];
     }
     else
-    {
-      // Single destination (unghosted cell)
-      std::vector<std::size_t>& send_cell_dest
-        = send_cell_vertices[cell_partition[i]];
-      send_cell_dest.push_back(0);
-
-      // Global cell index
-      send_cell_dest.push_back(mesh_data.topology.global_cell_indices[i]);
-
-      // Global vertex indices
-      send_cell_dest.insert(send_cell_dest.end(),
-                            mesh_data.topology.cell_vertices[i].begin(),
-                            mesh_data.topology.cell_vertices[i].end());
-      send_cell_dest[0]++;
-    }
+      ++send_cell_count[cell_partition[i]][0];
   }
 
-  // Distribute cell-vertex connectivity and ownership information
-  std::vector<std::vector<std::size_t>> received_cell_vertices(mpi_size);
-  MPI::all_to_all(mpi_comm, send_cell_vertices, received_cell_vertices);
-
-  // Count number of received cells (first entry in vector) and find
-  // out how many ghost cells there are...
+  // Receive counts and compute position of the first cell received
+  // from each process. Cells owned by this process come first,
+  // followed by ghost cells, each ordered by sending process.
+  std::vector<std::vector<std::size_t>> received_cell_count(mpi_size);
+  MPI::all_to_all(mpi_comm, send_cell_count, received_cell_count);
+  std::vector<std::size_t> local_pos(mpi_size), ghost_pos(mpi_size);
   std::size_t local_count = 0;
   std::size_t ghost_count = 0;
   for (std::size_t p = 0; p < mpi_size; ++p)
   {
-    std::vector<std::size_t>& received_data = received_cell_vertices[p];
-    local_count += received_data[0];
-    ghost_count += received_data[1];
+    local_pos[p] = local_count;
+    local_count += received_cell_count[p][0];
+  }
+  for (std::size_t p = 0; p < mpi_size; ++p)
+  {
+    ghost_pos[p] = local_count + ghost_count;
+    ghost_count += received_cell_count[p][1];
   }
 
   const std::size_t all_count = ghost_count + local_count;
@@ -819,50 +815,114 @@ MeshPartitioning::distribute_cells(
   new_global_cell_indices.resize(all_count);
   new_cell_partition.resize(all_count);
 
-  // Unpack received data
-  // Create a map from cells which are shared, to the remote processes
-  // which share them - corral ghost cells to end of range
-  std::size_t c = 0;
-  std::size_t gc = local_count;
-  for (std::size_t p = 0; p < mpi_size; ++p)
+  // Send cells in rounds of at most chunk_size cells per process to
+  // bound the size of the send buffers. Only the send side is
+  // bounded: a process may receive up to chunk_size cells (plus ghost
+  // copies) from every other process in one round. Each round is a
+  // collective all-to-all exchange, including the message counts.
+  const int chunk_size = parameters["mesh_distribution_chunk_size"];
+  const std::size_t chunk = chunk_size > 0
+    ? chunk_size : std::max(num_local_cells, (std::size_t) 1);
+  const std::size_t num_rounds
+    = MPI::max(mpi_comm, (num_local_cells + chunk - 1)/chunk);
+  std::vector<std::vector<std::size_t>> send_cell_vertices(mpi_size);
+  std::vector<std::vector<std::size_t>> received_cell_vertices(mpi_size);
+  for (std::size_t round = 0; round < num_rounds; ++round)
   {
-    std::vector<std::size_t>& received_data = received_cell_vertices[p];
-    for (auto it = received_data.begin() + 2; it != received_data.end();
-         it += (*it + num_cell_vertices + 2))
+    // Send cells to their destinations including their global
+    // indices
+    for (auto& send_cell_dest : send_cell_vertices)
+      send_cell_dest.clear();
+    const std::size_t cell_end
+      = std::min(num_local_cells, (round + 1)*chunk);
+    for (std::size_t i = round*chunk; i < cell_end; ++i)
     {
-      auto tmp_it = it;
-      const unsigned int num_ghosts = *tmp_it++;
-
-      // Determine owner, and indexing.
-      // Note that *tmp_it may be equal to mpi_rank
-      const std::size_t owner = (num_ghosts == 0) ? mpi_rank : *tmp_it;
-      const std::size_t idx = (owner == mpi_rank) ? c : gc;
-
-      dolfin_assert(idx < new_cell_partition.size());
-      new_cell_partition[idx] = owner;
-      if (num_ghosts != 0)
+      // If cell is in ghost_procs map, use that to determine
+      // destinations, otherwise just use the cell_partition vector
+      auto map_it = ghost_procs.find(i);
+      if (map_it != ghost_procs.end())
+      {
+        const std::vector<int>& destinations = map_it->second;
+        for (auto dest = destinations.begin(); dest != destinations.end();
+             ++dest)
+        {
+          // Create reference to destination vector
+          std::vector<std::size_t>& send_cell_dest = send_cell_vertices[*dest];
+
+          // Count of ghost cells, followed by ghost processes (the
+          // first entry is the owner)
+          send_cell_dest.push_back(destinations.size());
+          send_cell_dest.insert(send_cell_dest.end(), destinations.begin(),
+                                destinations.end());
+
+          // Global cell index
+          send_cell_dest.push_back(mesh_data.topology.global_cell_indices[i]);
+
+          // Global vertex indices
+          send_cell_dest.insert(send_cell_dest.end(),
+                                mesh_data.topology.cell_vertices[i].begin(),
+                                mesh_data.topology.cell_vertices[i].end());
+        }
+      }
+      else
       {
-        std::set<unsigned int> proc_set(tmp_it, tmp_it + num_ghosts);
+        // Single destination (unghosted cell)
+        std::vector<std::size_t>& send_cell_dest
+          = send_cell_vertices[cell_partition[i]];
+        send_cell_dest.push_back(0);
+
+        // Global cell index
+        send_cell_dest.push_back(mesh_data.topology.global_cell_indices[i]);
 
-        // Remove self from set of sharing processes
-        proc_set.erase(mpi_rank);
-        shared_cells.insert({idx, proc_set});
-        tmp_it += num_ghosts;
+        // Global vertex indices
+        send_cell_dest.insert(send_cell_dest.end(),
+                              mesh_data.topology.cell_vertices[i].begin(),
+                              mesh_data.topology.cell_vertices[i].end());
       }
+    }
 
-      new_global_cell_indices[idx] = *tmp_it++;
-      for (std::size_t j = 0; j < num_cell_vertices; ++j)
-        new_cell_vertices[idx][j] = *tmp_it++;
+    // Distribute cell-vertex connectivity and ownership information
+    MPI::all_to_all(mpi_comm, send_cell_vertices, received_cell_vertices);
 
-      if (owner == mpi_rank)
-        ++c;
-      else
-        ++gc;
+    // Unpack received data
+    // Create a map from cells which are shared, to the remote processes
+    // which share them - corral ghost cells to end of range
+    for (std::size_t p = 0; p < mpi_size; ++p)
+    {
+      std::vector<std::size_t>& received_data = received_cell_vertices[p];
+      for (auto it = received_data.begin(); it != received_data.end();
+           it += (*it + num_cell_vertices + 2))
+      {
+        auto tmp_it = it;
+        const unsigned int num_ghosts = *tmp_it++;
+
+        // Determine owner, and indexing.
+        // Note that *tmp_it may be equal to mpi_rank
+        const std::size_t owner = (num_ghosts == 0) ? mpi_rank : *tmp_it;
+        const std::size_t idx
+          = (owner == mpi_rank) ? local_pos[p]++ : ghost_pos[p]++;
+
+        dolfin_assert(idx < new_cell_partition.size());
+        new_cell_partition[idx] = owner;
+        if (num_ghosts != 0)
+        {
+          std::set<unsigned int> proc_set(tmp_it, tmp_it + num_ghosts);
+
+          // Remove self from set of sharing processes
+          proc_set.erase(mpi_rank);
+          shared_cells.insert({idx, proc_set});
+          tmp_it += num_ghosts;
+        }
+
+        new_global_cell_indices[idx] = *tmp_it++;
+        for (std::size_t j = 0; j < num_cell_vertices; ++j)
+          new_cell_vertices[idx][j] = *tmp_it++;
+      }
     }
   }
 
-  dolfin_assert(c == local_count);
-  dolfin_assert(gc == all_count);
+  dolfin_assert(local_pos.back() == local_count);
+  dolfin_assert(ghost_pos.back() == all_count);
   return local_count;
 }
 //-----------------------------------------------------------------------------
@@ -956,51 +1016,71 @@ void MeshPartitioning::distribute_vertices(
   build_shared_vertices(mpi_comm, shared_vertices_local,
                         vertex_global_to_local, received_vertex_indices);
 
-  // Distribute vertex coordinates
+  // Initialise coordinates array
+  vertex_coordinates.resize(boost::extents[vertex_indices.size()][gdim]);
+
+  // Distribute vertex coordinates in rounds of at most chunk_size
+  // vertices per pair of processes to bound the size of the
+  // communication buffers. A process may send and receive up to
+  // chunk_size vertices per other process in one round.
+  const int chunk_size = parameters["mesh_distribution_chunk_size"];
+  std::size_t max_requests = 1;
+  for (int p = 0; p < mpi_size; ++p)
+    max_requests = std::max(max_requests, received_vertex_indices[p].size());
+  const std::size_t chunk = chunk_size > 0
+    ? chunk_size : MPI::max(mpi_comm, max_requests);
+  const std::size_t num_rounds
+    = MPI::max(mpi_comm, (max_requests + chunk - 1)/chunk);
+
   std::vector<std::vector<double>> send_vertex_coordinates(mpi_size);
+  std::vector<std::vector<double>> received_vertex_coordinates;
   const std::pair<std::size_t, std::size_t> local_vertex_range = {ranges[mpi_rank], ranges[mpi_rank + 1]};
-  for (int p = 0; p < mpi_size; ++p)
+  std::size_t num_received_vertices = 0;
+  for (std::size_t round = 0; round < num_rounds; ++round)
   {
-    send_vertex_coordinates[p].reserve(received_vertex_indices[p].size()*gdim);
-    for (auto q = received_vertex_indices[p].begin();
-         q != received_vertex_indices[p].end(); ++q)
+    for (int p = 0; p < mpi_size; ++p)
     {
-      dolfin_assert(*q >= local_vertex_range.first && *q < local_vertex_range.second);
+      const std::vector<std::size_t>& requests = received_vertex_indices[p];
+      const std::size_t begin = std::min(requests.size(), round*chunk);
+      const std::size_t end = std::min(requests.size(), begin + chunk);
+      send_vertex_coordinates[p].clear();
+      send_vertex_coordinates[p].reserve((end - begin)*gdim);
+      for (std::size_t i = begin; i < end; ++i)
+      {
+        dolfin_assert(requests[i] >= local_vertex_range.first
+                      && requests[i] < local_vertex_range.second);
 
-      const std::size_t location = *q - local_vertex_range.first;
-      send_vertex_coordinates[p].insert(send_vertex_coordinates[p].end(),
-                                        mesh_data.geometry.vertex_coordinates[location].begin(),
-                                        mesh_data.geometry.vertex_coordinates[location].end());
+        const std::size_t location = requests[i] - local_vertex_range.first;
+        send_vertex_coordinates[p].insert(send_vertex_coordinates[p].end(),
+                                          mesh_data.geometry.vertex_coordinates[location].begin(),
+                                          mesh_data.geometry.vertex_coordinates[location].end());
+      }
     }
-  }
-
-  // Send actual coordinates to destinations
-  std::vector<std::vector<double>> received_vertex_coordinates;
-  MPI::all_to_all(mpi_comm, send_vertex_coordinates,
-                  received_vertex_coordinates);
-
-  // Count number of received local vertices and check it agrees with map
-  std::size_t num_received_vertices = 0;
-  for (int p = 0; p < mpi_size; ++p)
-    num_received_vertices += received_vertex_coordinates[p].size()/gdim;
-  dolfin_assert(num_received_vertices == vertex_indices.size());
 
-  // Initialise coordinates array
-  vertex_coordinates.resize(boost::extents[vertex_indices.size()][gdim]);
+    // Send actual coordinates to destinations
+    MPI::all_to_all(mpi_comm, send_vertex_coordinates,
+                    received_vertex_coordinates);
 
-  // Store coordinates according to global_to_local mapping
-  for (int p = 0; p < mpi_size; ++p)
-  {
-    for (std::size_t i = 0; i < received_vertex_coordinates[p].size()/gdim; ++i)
+    // Store coordinates according to global_to_local mapping
+    for (int p = 0; p < mpi_size; ++p)
     {
-      const std::int64_t global_vertex_index = vertex_location[p][i];
-      auto v = vertex_global_to_local.find(global_vertex_index);
-      dolfin_assert(v != vertex_global_to_local.end());
-      dolfin_assert(vertex_indices[v->second] == global_vertex_index);
-      for (int j = 0; j < gdim; ++j)
-        vertex_coordinates[v->second][j] = received_vertex_coordinates[p][i*gdim + j];
+      const std::size_t offset = round*chunk;
+      for (std::size_t i = 0; i < received_vertex_coordinates[p].size()/gdim;
+           ++i)
+      {
+        const std::int64_t global_vertex_index = vertex_location[p][offset + i];
+        auto v = vertex_global_to_local.find(global_vertex_index);
+        dolfin_assert(v != vertex_global_to_local.end());
+        dolfin_assert(vertex_indices[v->second] == global_vertex_index);
+        for (int j = 0; j < gdim; ++j)
+          vertex_coordinates[v->second][j] = received_vertex_coordinates[p][i*gdim + j];
+      }
+      num_received_vertices += received_vertex_coordinates[p].size()/gdim;
     }
   }
+
+  // Check number of received vertices agrees with map
+  dolfin_assert(num_received_vertices == vertex_indices.size());
 }
 //-----------------------------------------------------------------------------
 void MeshPartitioning::build_shared_vertices(MPI_Comm mpi_comm,
@@ -78,6 +78,16 @@ namespace dolfin
     static void build_distributed_mesh(Mesh& mesh, const LocalMeshData& data,
                                        const std::string ghost_mode);
 
+    /// Build a distributed mesh from 'local mesh data' that is
+    /// distributed across processes. The cell and vertex data are
+    /// released as soon as they have been distributed, which reduces
+    /// the peak memory when reading large meshes (see also the
+    /// parameter "mesh_distribution_chunk_size", which bounds the
+    /// data sent per process and round; a process may receive up to
+    /// the chunk size from every other process in each round).
+    static void build_distributed_mesh(Mesh& mesh, LocalMeshData&& data,
+                                       const std::string ghost_mode);
+
     /// Build a MeshValueCollection based on LocalMeshValueCollection
     template<typename T>
       static void
@@ -87,6 +97,13 @@ namespace dolfin
 
   private:
 
+    // Build a distributed mesh from local mesh data. If owned_data is
+    // not null, it must point to data, and its cell and vertex data
+    // are released once distributed.
+    static void build_distributed_mesh(Mesh& mesh, const LocalMeshData& data,
+                                       const std::string ghost_mode,
+                                       LocalMeshData* owned_data);
+
     // Compute cell partitioning from local mesh data. Returns a
     // vector 'cell -> process' vector for cells in LocalMeshData, and
     // a map 'local cell index -> processes' to which ghost cells must
@@ -99,11 +116,13 @@ namespace dolfin
                          std::map<std::int64_t, std::vector<int>>& ghost_procs);
 
     // Build a distributed mesh from local mesh data with a computed
-    // partition
+    // partition, releasing the cell and vertex data of owned_data (if
+    // not null) once distributed
     static void build(Mesh& mesh, const LocalMeshData& data,
                       const std::vector<int>& cell_partition,
                       const std::map<std::int64_t, std::vector<int>>& ghost_procs,
-                      const std::string ghost_mode);
+                      const std::string ghost_mode,
+                      LocalMeshData* owned_data);
 
     // FIXME: Improve this docstring
     // Distribute a layer of cells attached by vertex to boundary updating
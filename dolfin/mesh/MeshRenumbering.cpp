@@ -21,11 +21,18 @@
 // Last changed: 2014-02-06
 
 #include <algorithm>
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <numeric>
 #include <vector>
 
 #include <dolfin/log/log.h>
 #include <dolfin/common/Timer.h>
 #include <dolfin/common/utils.h>
+#include <dolfin/geometry/BoundingBoxTree.h>
+#include <dolfin/graph/BoostGraphOrdering.h>
+#include <dolfin/graph/Graph.h>
 #include "Cell.h"
 #include "Mesh.h"
 #include "MeshEditor.h"
@@ -35,6 +42,204 @@
 
 using namespace dolfin;
 
+namespace
+{
+  // Compute position of point with integer coordinates X (bits bits
+  // per direction) along Hilbert curve (Skilling's transpose
+  // algorithm) or Morton (Z-order) curve
+  std::uint64_t curve_key(std::array<std::uint32_t, 3> X, std::size_t dim,
+                          std::size_t bits, bool hilbert)
+  {
+    if (hilbert and dim > 1)
+    {
+      const std::uint32_t M = 1u << (bits - 1);
+
+      // Inverse undo
+      for (std::uint32_t Q = M; Q > 1; Q >>= 1)
+      {
+        const std::uint32_t P = Q - 1;
+        for (std::size_t i = 0; i < dim; ++i)
+        {
+          if (X[i] & Q)
+            X[0] ^= P;
+          else
+          {
+            const std::uint32_t t = (X[0] ^ X[i]) & P;
+            X[0] ^= t;
+            X[i] ^= t;
+          }
+        }
+      }
+
+      // Gray encode
+      for (std::size_t i = 1; i < dim; ++i)
+        X[i] ^= X[i - 1];
+      std::uint32_t t = 0;
+      for (std::uint32_t Q = M; Q > 1; Q >>= 1)
+      {
+        if (X[dim - 1] & Q)
+          t ^= Q - 1;
+      }
+      for (std::size_t i = 0; i < dim; ++i)
+        X[i] ^= t;
+    }
+
+    // Interleave bits, most significant first
+    std::uint64_t key = 0;
+    for (std::size_t b = bits; b-- > 0;)
+      for (std::size_t i = 0; i < dim; ++i)
+        key = (key << 1) | ((X[i] >> b) & 1);
+    return key;
+  }
+  //---------------------------------------------------------------------------
+  // Compute new index of (regular) cells by sorting the cell
+  // midpoints along a space-filling curve
+  std::vector<std::size_t> compute_curve_ordering(const Mesh& mesh,
+                                                  bool hilbert)
+  {
+    const std::size_t tdim = mesh.topology().dim();
+    const std::size_t gdim = mesh.geometry().dim();
+    const std::size_t num_cells = mesh.topology().ghost_offset(tdim);
+    const std::size_t bits = std::min<std::size_t>(32, 63/gdim);
+
+    // Compute cell midpoints and their bounding box
+    std::vector<double> midpoints(num_cells*gdim);
+    std::vector<double> xmin(gdim, std::numeric_limits<double>::max());
+    std::vector<double> xmax(gdim, std::numeric_limits<double>::lowest());
+    for (std::size_t c = 0; c < num_cells; ++c)
+    {
+      const Point p = Cell(mesh, c).midpoint();
+      for (std::size_t i = 0; i < gdim; ++i)
+      {
+        midpoints[c*gdim + i] = p[i];
+        xmin[i] = std::min(xmin[i], p[i]);
+        xmax[i] = std::max(xmax[i], p[i]);
+      }
+    }
+
+    // Compute curve keys of quantised midpoints
+    const double scale = (double) ((std::uint64_t(1) << bits) - 1);
+    std::vector<std::pair<std::uint64_t, std::size_t>> keys(num_cells);
+    for (std::size_t c = 0; c < num_cells; ++c)
+    {
+      std::array<std::uint32_t, 3> X = {{0, 0, 0}};
+      for (std::size_t i = 0; i < gdim; ++i)
+      {
+        const double h = xmax[i] - xmin[i];
+        if (h > 0.0)
+          X[i] = (std::uint32_t) ((midpoints[c*gdim + i] - xmin[i])/h*scale);
+      }
+      keys[c] = {curve_key(X, gdim, bits, hilbert), c};
+    }
+    std::sort(keys.begin(), keys.end());
+
+    std::vector<std::size_t> cell_map(num_cells);
+    for (std::size_t i = 0; i < num_cells; ++i)
+      cell_map[keys[i].second] = i;
+    return cell_map;
+  }
+  //---------------------------------------------------------------------------
+  // Compute new index of (regular) cells by reverse Cuthill-McKee on
+  // the graph of cells sharing a vertex
+  std::vector<std::size_t> compute_rcm_ordering(const Mesh& mesh)
+  {
+    const std::size_t tdim = mesh.topology().dim();
+    const std::size_t num_cells = mesh.topology().ghost_offset(tdim);
+    mesh.init_transient(0, tdim);
+    const MeshConnectivity& cell_vertices = mesh.topology()(tdim, 0);
+    const MeshConnectivity& vertex_cells = mesh.topology()(0, tdim);
+
+    Graph graph(num_cells);
+    for (std::size_t c = 0; c < num_cells; ++c)
+    {
+      for (std::size_t i = 0; i < cell_vertices.size(c); ++i)
+      {
+        const unsigned int v = cell_vertices(c)[i];
+        for (std::size_t j = 0; j < vertex_cells.size(v); ++j)
+        {
+          const unsigned int c1 = vertex_cells(v)[j];
+          if (c1 != c and c1 < num_cells)
+            graph[c].insert(c1);
+        }
+      }
+    }
+
+    const std::vector<int> map
+      = BoostGraphOrdering::compute_cuthill_mckee(graph, true);
+    return std::vector<std::size_t>(map.begin(), map.end());
+  }
+  //---------------------------------------------------------------------------
+  // Renumber rows (d0 map) and connections (d1 map) of connectivity.
+  // Null maps leave the numbering unchanged.
+  void reorder_connectivity(MeshConnectivity& connectivity,
+                            std::size_t num_entities,
+                            const std::vector<std::size_t>* map0,
+                            const std::vector<std::size_t>* map1)
+  {
+    const MeshConnectivity c(connectivity);
+
+    std::vector<std::size_t> old_entity(num_entities);
+    std::iota(old_entity.begin(), old_entity.end(), 0);
+    if (map0)
+    {
+      for (std::size_t e = 0; e < num_entities; ++e)
+        old_entity[(*map0)[e]] = e;
+    }
+
+    std::vector<std::size_t> num_connections(num_entities);
+    std::vector<unsigned int> num_global_connections;
+    for (std::size_t e = 0; e < num_entities; ++e)
+    {
+      num_connections[e] = c.size(old_entity[e]);
+      if (c.have_global_size())
+        num_global_connections.push_back(c.size_global(old_entity[e]));
+    }
+
+    connectivity.init(num_connections);
+    std::vector<unsigned int> row;
+    for (std::size_t e = 0; e < num_entities; ++e)
+    {
+      const unsigned int* connections = c(old_entity[e]);
+      row.assign(connections, connections + num_connections[e]);
+      if (map1)
+      {
+        for (auto& i : row)
+          i = (*map1)[i];
+      }
+      connectivity.set(e, row);
+    }
+
+    if (c.have_global_size())
+      connectivity.set_global_size(num_global_connections);
+  }
+  //---------------------------------------------------------------------------
+  // Move entry i (block of size block) of values to position map[i]
+  template<typename T>
+  void permute(std::vector<T>& values, const std::vector<std::size_t>& map,
+               std::size_t block=1)
+  {
+    dolfin_assert(values.size() == map.size()*block);
+    const std::vector<T> old_values(values);
+    for (std::size_t i = 0; i < map.size(); ++i)
+    {
+      std::copy(old_values.begin() + i*block,
+                old_values.begin() + (i + 1)*block,
+                values.begin() + map[i]*block);
+    }
+  }
+  //---------------------------------------------------------------------------
+  // Renumber keys of map
+  template<typename K, typename V>
+  void permute_keys(std::map<K, V>& values,
+                    const std::vector<std::size_t>& map)
+  {
+    std::map<K, V> old_values;
+    old_values.swap(values);
+    for (auto& v : old_values)
+      values.insert({map[v.first], std::move(v.second)});
+  }
+}
+
 //-----------------------------------------------------------------------------
 dolfin::Mesh MeshRenumbering::renumber_by_color(const Mesh& mesh,
                                  const std::vector<std::size_t> coloring_type)
@@ -266,3 +471,139 @@ void MeshRenumbering::compute_renumbering(const Mesh& mesh,
   }
 }
 //-----------------------------------------------------------------------------
+std::pair<std::vector<std::size_t>, std::vector<std::size_t>>
+MeshRenumbering::reorder(Mesh& mesh, std::string method)
+{
+  Timer timer("Reorder mesh");
+
+  const std::size_t tdim = mesh.topology().dim();
+  const std::size_t gdim = mesh.geometry().dim();
+  const std::size_t num_vertices = mesh.num_vertices();
+  const std::size_t num_cells = mesh.num_cells();
+
+  if (tdim == 0 or mesh.geometry().degree() != 1)
+  {
+    dolfin_error("MeshRenumbering.cpp",
+                 "reorder mesh",
+                 "Only meshes of topological dimension > 0 with affine geometry are supported");
+  }
+  if (!mesh.topology().mapping().empty())
+  {
+    dolfin_error("MeshRenumbering.cpp",
+                 "reorder mesh",
+                 "Mesh has mappings to other meshes (mesh views)");
+  }
+
+  // Compute new cell numbering (ghost cells are not moved)
+  std::vector<std::size_t> cell_map;
+  if (method == "hilbert")
+    cell_map = compute_curve_ordering(mesh, true);
+  else if (method == "morton")
+    cell_map = compute_curve_ordering(mesh, false);
+  else if (method == "rcm")
+    cell_map = compute_rcm_ordering(mesh);
+  else
+  {
+    dolfin_error("MeshRenumbering.cpp",
+                 "reorder mesh",
+                 "Unknown reordering method \"%s\"", method.c_str());
+  }
+  for (std::size_t c = cell_map.size(); c < num_cells; ++c)
+    cell_map.push_back(c);
+
+  // Number regular vertices in the order they are reached by the
+  // reordered regular cells (ghost vertices are not moved)
+  const std::size_t num_regular_cells = mesh.topology().ghost_offset(tdim);
+  const std::size_t num_regular_vertices = mesh.topology().ghost_offset(0);
+  std::vector<std::size_t> cells(num_regular_cells);
+  for (std::size_t c = 0; c < num_regular_cells; ++c)
+    cells[cell_map[c]] = c;
+
+  const std::size_t undefined = std::numeric_limits<std::size_t>::max();
+  std::vector<std::size_t> vertex_map(num_vertices, undefined);
+  std::size_t current_vertex = 0;
+  const MeshConnectivity& cell_vertices = mesh.topology()(tdim, 0);
+  for (auto c : cells)
+  {
+    for (std::size_t i = 0; i < cell_vertices.size(c); ++i)
+    {
+      const unsigned int v = cell_vertices(c)[i];
+      if (v < num_regular_vertices and vertex_map[v] == undefined)
+        vertex_map[v] = current_vertex++;
+    }
+  }
+  for (std::size_t v = 0; v < num_vertices; ++v)
+  {
+    if (v >= num_regular_vertices)
+      vertex_map[v] = v;
+    else if (vertex_map[v] == undefined)
+      vertex_map[v] = current_vertex++;
+  }
+  dolfin_assert(current_vertex == num_regular_vertices);
+
+  // Renumber geometry
+  permute(mesh.geometry().x(), vertex_map, gdim);
+
+  // Renumber connectivity
+  MeshTopology& topology = mesh.topology();
+  for (std::size_t d0 = 0; d0 <= tdim; ++d0)
+  {
+    const std::vector<std::size_t>* map0
+      = d0 == 0 ? &vertex_map : (d0 == tdim ? &cell_map : NULL);
+    for (std::size_t d1 = 0; d1 <= tdim; ++d1)
+    {
+      const std::vector<std::size_t>* map1
+        = d1 == 0 ? &vertex_map : (d1 == tdim ? &cell_map : NULL);
+      MeshConnectivity& c = topology(d0, d1);
+      c.decompress();
+      if ((map0 or map1) and !c.empty())
+        reorder_connectivity(c, topology.size(d0), map0, map1);
+    }
+  }
+
+  // Renumber global indices, shared entities and colorings
+  for (std::size_t d : {(std::size_t) 0, tdim})
+  {
+    const std::vector<std::size_t>& map = d == 0 ? vertex_map : cell_map;
+    if (topology.have_global_indices(d))
+    {
+      const std::vector<std::int64_t> global_indices
+        = topology.global_indices(d);
+      for (std::size_t i = 0; i < map.size(); ++i)
+        topology.set_global_index(d, map[i], global_indices[i]);
+    }
+
+    if (topology.have_shared_entities(d))
+      permute_keys(topology.shared_entities(d), map);
+
+    for (auto& coloring : topology.coloring)
+    {
+      if (coloring.first[0] != d)
+        continue;
+      permute(coloring.second.first, map);
+      for (auto& entities : coloring.second.second)
+        for (auto& e : entities)
+          e = map[e];
+    }
+
+    // Renumber subdomain markers and mesh data
+    if (d <= mesh.domains().max_dim() and !mesh.domains().is_empty())
+      permute_keys(mesh.domains().markers(d), map);
+    if (d < mesh.data()._arrays.size())
+    {
+      for (auto& array : mesh.data()._arrays[d])
+      {
+        if (array.second.size() == map.size())
+          permute(array.second, map);
+      }
+    }
+  }
+
+  // Renumber cell orientations and reset bounding box tree
+  if (mesh._cell_orientations.size() == num_cells)
+    permute(mesh._cell_orientations, cell_map);
+  mesh._tree.reset();
+
+  return {vertex_map, cell_map};
+}
+//-----------------------------------------------------------------------------
@@ -23,12 +23,16 @@
 #ifndef __MESH_RENUMBERING_H
 #define __MESH_RENUMBERING_H
 
+#include <string>
+#include <utility>
 #include <vector>
+#include <dolfin/log/log.h>
 
 namespace dolfin
 {
 
   class Mesh;
+  template <typename T> class MeshFunction;
 
   /// This class implements renumbering algorithms for meshes.
 
@@ -51,6 +55,50 @@ namespace dolfin
     static Mesh renumber_by_color(const Mesh& mesh,
                                   std::vector<std::size_t> coloring);
 
+    /// Reorder cells and vertices of a mesh in place to improve data
+    /// locality. Cells are sorted along a Hilbert or Morton
+    /// space-filling curve through the cell midpoints, or by reverse
+    /// Cuthill-McKee on the graph of cells sharing a vertex.
+    /// Vertices are numbered in the order in which they are first
+    /// reached by the reordered cells. Ghost cells and vertices are
+    /// not moved. The geometry, all computed connectivity, global
+    /// indices, shared entities, colorings, subdomain markers and
+    /// mesh data are renumbered consistently. Entities of other
+    /// dimensions keep their numbering. Mesh functions are
+    /// renumbered with reorder(MeshFunction<T>&, ...).
+    ///
+    /// @param  mesh (Mesh)
+    ///         Mesh to be reordered (affine geometry only).
+    /// @param  method (std::string)
+    ///         "hilbert", "morton" or "rcm".
+    /// @return std::pair<std::vector<std::size_t>, std::vector<std::size_t>>
+    ///         New index of each (old) vertex and of each (old) cell.
+    static std::pair<std::vector<std::size_t>, std::vector<std::size_t>>
+      reorder(Mesh& mesh, std::string method="hilbert");
+
+    /// Renumber mesh function after reordering of its mesh
+    ///
+    /// @param  f (MeshFunction<T>)
+    ///         Mesh function of dimension zero or of the cell dimension.
+    /// @param  maps (std::pair<std::vector<std::size_t>, std::vector<std::size_t>>)
+    ///         Vertex and cell maps returned by reorder(Mesh&, ...).
+    template <typename T>
+    static void
+      reorder(MeshFunction<T>& f,
+              const std::pair<std::vector<std::size_t>,
+              std::vector<std::size_t>>& maps)
+    {
+      const std::vector<std::size_t>& map
+        = f.dim() == 0 ? maps.first : maps.second;
+      if (f.dim() != 0 and f.dim() != f.mesh()->topology().dim())
+        return;
+      dolfin_assert(map.size() == f.size());
+
+      const std::vector<T> values(f.values(), f.values() + f.size());
+      for (std::size_t i = 0; i < map.size(); ++i)
+        f.values()[map[i]] = values[i];
+    }
+
   private:
 
     static void compute_renumbering(const Mesh& mesh,
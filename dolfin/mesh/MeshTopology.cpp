@@ -18,6 +18,7 @@
 // First added:  2006-05-08
 // Last changed: 2014-07-02
 
+#include <algorithm>
 #include <numeric>
 #include <sstream>
 #include <dolfin/log/log.h>
@@ -29,7 +30,8 @@
 using namespace dolfin;
 
 //-----------------------------------------------------------------------------
-MeshTopology::MeshTopology() : Variable("topology", "mesh topology")
+MeshTopology::MeshTopology() : Variable("topology", "mesh topology"),
+                               _memory_budget(0)
 {
   // Do nothing
 }
@@ -43,7 +45,9 @@ MeshTopology::MeshTopology(const MeshTopology& topology)
     global_num_entities(topology.global_num_entities),
     _global_indices(topology._global_indices),
     _shared_entities(topology._shared_entities),
-    connectivity(topology.connectivity)
+    connectivity(topology.connectivity),
+    _transient(topology._transient),
+    _memory_budget(topology._memory_budget)
 {
   // Do nothing
 }
@@ -66,6 +70,8 @@ MeshTopology& MeshTopology::operator= (const MeshTopology& topology)
   _global_indices = topology._global_indices;
   _shared_entities = topology._shared_entities;
   connectivity = topology.connectivity;
+  _transient = topology._transient;
+  _memory_budget = topology._memory_budget;
   _cell_owner = topology._cell_owner;
 
   return *this;
@@ -114,6 +120,7 @@ void MeshTopology::clear()
   _global_indices.clear();
   _shared_entities.clear();
   connectivity.clear();
+  _transient.clear();
 }
 //-----------------------------------------------------------------------------
 void MeshTopology::clear(std::size_t d0, std::size_t d1)
@@ -121,6 +128,7 @@ void MeshTopology::clear(std::size_t d0, std::size_t d1)
   dolfin_assert(d0 < connectivity.size());
   dolfin_assert(d1 < connectivity[d0].size());
   connectivity[d0][d1].clear();
+  _transient[d0][d1] = false;
 }
 //-----------------------------------------------------------------------------
 void MeshTopology::init(std::size_t dim)
@@ -141,6 +149,7 @@ void MeshTopology::init(std::size_t dim)
   for (std::size_t d0 = 0; d0 <= dim; d0++)
     for (std::size_t d1 = 0; d1 <= dim; d1++)
       connectivity[d0].push_back(MeshConnectivity(d0, d1));
+  _transient.assign(dim + 1, std::vector<bool>(dim + 1, false));
 }
 //-----------------------------------------------------------------------------
 void MeshTopology::init(std::size_t dim, std::size_t local_size,
@@ -207,6 +216,84 @@ const std::map<std::int32_t, std::set<unsigned int>>&
   return e->second;
 }
 //-----------------------------------------------------------------------------
+void MeshTopology::set_transient(std::size_t d0, std::size_t d1,
+                                 bool transient)
+{
+  dolfin_assert(d0 < _transient.size());
+  dolfin_assert(d1 < _transient[d0].size());
+  if (transient and d1 == 0)
+  {
+    dolfin_error("MeshTopology.cpp",
+                 "mark mesh connectivity as transient",
+                 "Connectivity %d - 0 defines the mesh entities and cannot be released",
+                 d0);
+  }
+  _transient[d0][d1] = transient;
+}
+//-----------------------------------------------------------------------------
+bool MeshTopology::transient(std::size_t d0, std::size_t d1) const
+{
+  dolfin_assert(d0 < _transient.size());
+  dolfin_assert(d1 < _transient[d0].size());
+  return _transient[d0][d1];
+}
+//-----------------------------------------------------------------------------
+std::size_t MeshTopology::evict(std::size_t budget)
+{
+  std::size_t usage = memory_usage();
+  if (usage <= budget)
+    return 0;
+
+  // Collect transient connectivity that can be recomputed (global
+  // number of connections is set during mesh distribution only)
+  std::vector<std::pair<std::size_t, MeshConnectivity*>> candidates;
+  for (std::size_t d0 = 0; d0 < connectivity.size(); d0++)
+  {
+    for (std::size_t d1 = 0; d1 < connectivity[d0].size(); d1++)
+    {
+      MeshConnectivity& c = connectivity[d0][d1];
+      if (_transient[d0][d1] and !c.have_global_size()
+          and c.memory_usage() > 0)
+      {
+        candidates.push_back({c.memory_usage(), &c});
+      }
+    }
+  }
+
+  // Release largest first
+  std::sort(candidates.begin(), candidates.end(),
+            [](const std::pair<std::size_t, MeshConnectivity*>& a,
+               const std::pair<std::size_t, MeshConnectivity*>& b)
+            { return a.first > b.first; });
+  std::size_t released = 0;
+  for (auto& c : candidates)
+  {
+    if (usage <= budget)
+      break;
+    c.second->clear();
+    usage -= c.first;
+    released += c.first;
+  }
+
+  log(TRACE, "Released %d bytes of transient mesh connectivity.",
+      (int) released);
+  return released;
+}
+//-----------------------------------------------------------------------------
+std::size_t MeshTopology::memory_usage(std::size_t d0, std::size_t d1) const
+{
+  return (*this)(d0, d1).memory_usage();
+}
+//-----------------------------------------------------------------------------
+std::size_t MeshTopology::memory_usage() const
+{
+  std::size_t usage = 0;
+  for (auto& c : connectivity)
+    for (auto& c01 : c)
+      usage += c01.memory_usage();
+  return usage;
+}
+//-----------------------------------------------------------------------------
 size_t MeshTopology::hash() const
 {
   return (*this)(dim(), 0).hash();
@@ -244,6 +331,21 @@ std::string MeshTopology::str(bool verbose) const
     }
     s << std::endl;
 
+    s << "  Connectivity memory (bytes, * = transient):" << std::endl
+      << std::endl;
+    for (std::size_t d0 = 0; d0 <= _dim; d0++)
+    {
+      for (std::size_t d1 = 0; d1 <= _dim; d1++)
+      {
+        if (connectivity[d0][d1].memory_usage() == 0)
+          continue;
+        s << "    " << d0 << " - " << d1 << ": "
+          << connectivity[d0][d1].memory_usage()
+          << (_transient[d0][d1] ? " *" : "") << std::endl;
+      }
+    }
+    s << std::endl;
+
     for (std::size_t d0 = 0; d0 <= _dim; d0++)
     {
       for (std::size_t d1 = 0; d1 <= _dim; d1++)
@@ -43,6 +43,16 @@ namespace dolfin
   /// A mesh entity e may be identified globally as a pair e = (dim,
   /// i), where dim is the topological dimension and i is the index of
   /// the entity within that topological dimension.
+  ///
+  /// Connectivity d0 -- d1 (d1 > 0) may be marked as transient. A
+  /// transient connectivity is released only by explicit calls to
+  /// evict(), and is recomputed on demand by Mesh::init(d0, d1).
+  /// DOLFIN never calls evict() itself, so releasing transient
+  /// connectivity is left to the user.
+  /// Mesh entity iterators point into the connectivity, so evict()
+  /// must not be called while an iterator over a transient
+  /// connectivity is in use. Connectivity d -- 0 defines the mesh
+  /// entities and is never released.
 
 
   // NOTE : Forward declaration not sufficient to use the mapping() function
@@ -81,7 +91,8 @@ namespace dolfin
     /// Clear all data
     void clear();
 
-    /// Clear data for given pair of topological dimensions
+    /// Clear data for given pair of topological dimensions (the
+    /// connectivity is no longer transient)
     void clear(std::size_t d0, std::size_t d1);
 
     /// Initialize topology of given maximum dimension
@@ -158,6 +169,42 @@ namespace dolfin
     const dolfin::MeshConnectivity& operator() (std::size_t d0,
                                                 std::size_t d1) const;
 
+    /// Mark connectivity for given pair of topological dimensions as
+    /// transient (true) or pinned (false, default)
+    void set_transient(std::size_t d0, std::size_t d1, bool transient);
+
+    /// Return true if connectivity for given pair of topological
+    /// dimensions is transient
+    bool transient(std::size_t d0, std::size_t d1) const;
+
+    /// Set memory budget (in bytes) for the connectivity, used by
+    /// evict(). Zero (default) means that evict() releases all
+    /// transient connectivity.
+    void set_memory_budget(std::size_t budget)
+    { _memory_budget = budget; }
+
+    /// Return memory budget (in bytes) for the connectivity
+    std::size_t memory_budget() const
+    { return _memory_budget; }
+
+    /// Release transient connectivity, largest first, until the
+    /// memory used by all connectivity is within the memory budget.
+    /// Returns the number of bytes released.
+    std::size_t evict()
+    { return evict(_memory_budget); }
+
+    /// Release transient connectivity, largest first, until the
+    /// memory used by all connectivity is at most budget (in bytes).
+    /// Returns the number of bytes released.
+    std::size_t evict(std::size_t budget);
+
+    /// Return memory used by connectivity for given pair of
+    /// topological dimensions (in bytes)
+    std::size_t memory_usage(std::size_t d0, std::size_t d1) const;
+
+    /// Return memory used by all connectivity (in bytes)
+    std::size_t memory_usage() const;
+
     /// Return hash based on the hash of cell-vertex connectivity
     size_t hash() const;
 
@@ -217,6 +264,12 @@ namespace dolfin
     // Connectivity for pairs of topological dimensions
     std::vector<std::vector<MeshConnectivity> > connectivity;
 
+    // Transient flag for pairs of topological dimensions
+    std::vector<std::vector<bool> > _transient;
+
+    // Memory budget for connectivity (zero if none)
+    std::size_t _memory_budget;
+
   };
 
 }
@@ -23,14 +23,20 @@
 
 #include <cmath>
 #include <algorithm>
+#ifdef HAS_OPENMP
+#include <omp.h>
+#endif
 #include <dolfin/log/log.h>
 #include <dolfin/common/NoDeleter.h>
+#include <dolfin/common/utils.h>
 #include <dolfin/geometry/BoundingBoxTree.h>
+#include <dolfin/geometry/CollisionPredicates.h>
 #include <dolfin/geometry/SimplexQuadrature.h>
 #include <dolfin/geometry/IntersectionConstruction.h>
 #include <dolfin/geometry/ConvexTriangulation.h>
 #include <dolfin/geometry/GeometryPredicates.h>
 #include <dolfin/geometry/MeshPointIntersection.h>
+#include <dolfin/parameter/GlobalParameters.h>
 
 #include "Cell.h"
 #include "Facet.h"
@@ -41,15 +47,34 @@
 
 using namespace dolfin;
 
+namespace
+{
+  // Return the cells of each part that are in the given maps
+  template<typename T>
+  std::vector<std::vector<unsigned int>>
+  map_keys(const std::vector<std::map<unsigned int, T>>& maps)
+  {
+    std::vector<std::vector<unsigned int>> keys(maps.size());
+    for (std::size_t i = 0; i < maps.size(); i++)
+    {
+      keys[i].reserve(maps[i].size());
+      for (const auto& it : maps[i])
+        keys[i].push_back(it.first);
+    }
+    return keys;
+  }
+}
+
 //-----------------------------------------------------------------------------
-MultiMesh::MultiMesh() : _is_built(false)
+MultiMesh::MultiMesh() : _is_built(false), _quadrature_order(0)
 {
   // Set parameters
   parameters = default_parameters();
 }
 //-----------------------------------------------------------------------------
 MultiMesh::MultiMesh(std::vector<std::shared_ptr<const Mesh>> meshes,
-                     std::size_t quadrature_order) : _is_built(false)
+                     std::size_t quadrature_order)
+  : _is_built(false), _quadrature_order(0)
 {
   // Set parameters
   parameters = default_parameters();
@@ -61,7 +86,8 @@ MultiMesh::MultiMesh(std::vector<std::shared_ptr<const Mesh>> meshes,
 }
 //-----------------------------------------------------------------------------
 MultiMesh::MultiMesh(std::shared_ptr<const Mesh> mesh_0,
-                     std::size_t quadrature_order) : _is_built(false)
+                     std::size_t quadrature_order)
+  : _is_built(false), _quadrature_order(0)
 {
   // Set parameters
   parameters = default_parameters();
@@ -73,7 +99,8 @@ MultiMesh::MultiMesh(std::shared_ptr<const Mesh> mesh_0,
 //-----------------------------------------------------------------------------
 MultiMesh::MultiMesh(std::shared_ptr<const Mesh> mesh_0,
                      std::shared_ptr<const Mesh> mesh_1,
-                     std::size_t quadrature_order) : _is_built(false)
+                     std::size_t quadrature_order)
+  : _is_built(false), _quadrature_order(0)
 {
   // Set parameters
   parameters = default_parameters();
@@ -87,7 +114,8 @@ MultiMesh::MultiMesh(std::shared_ptr<const Mesh> mesh_0,
 MultiMesh::MultiMesh(std::shared_ptr<const Mesh> mesh_0,
                      std::shared_ptr<const Mesh> mesh_1,
                      std::shared_ptr<const Mesh> mesh_2,
-                     std::size_t quadrature_order) : _is_built(false)
+                     std::size_t quadrature_order)
+  : _is_built(false), _quadrature_order(0)
 {
   // Set parameters
   parameters = default_parameters();
@@ -266,19 +294,31 @@ void MultiMesh::build(std::size_t quadrature_order)
   // Build collision maps, i.e. classify cut, uncut and covered cells
   _build_collision_maps();
 
+  // Clear quadrature rules and normals
+  _quadrature_rules_overlap.clear();
+  _quadrature_rules_overlap.resize(num_parts());
+  _quadrature_rules_cut_cells.clear();
+  _quadrature_rules_cut_cells.resize(num_parts());
+  _quadrature_rules_interface.clear();
+  _quadrature_rules_interface.resize(num_parts());
+  _facet_normals.clear();
+  _facet_normals.resize(num_parts());
+
   // For collisions with meshes of same type we get three types of
   // quadrature rules: the cut cell qr, qr of the overlap part and qr
-  // of the interface.
+  // of the interface. These are built for all cut cells.
+  const std::vector<std::vector<unsigned int>> cells
+    = map_keys(_collision_maps_cut_cells);
 
   // Build quadrature rules of the cut cells' overlap. Do this before
   // we build the quadrature rules of the cut cells
-  _build_quadrature_rules_overlap(quadrature_order);
+  _build_quadrature_rules_overlap(quadrature_order, cells);
 
   // Build quadrature rules of the cut cells
-  _build_quadrature_rules_cut_cells(quadrature_order);
+  _build_quadrature_rules_cut_cells(quadrature_order, cells);
 
   // Build quadrature rules and normals of the interface
-  _build_quadrature_rules_interface(quadrature_order);
+  _build_quadrature_rules_interface(quadrature_order, cells);
 
   // Make sure that cut cells are actually cut
   // TODO: Check if this needed
@@ -287,6 +327,105 @@ void MultiMesh::build(std::size_t quadrature_order)
 
   // Mark space as built
   _is_built = true;
+  _quadrature_order = quadrature_order;
+
+  end();
+}
+//-----------------------------------------------------------------------------
+void MultiMesh::rebuild(const std::vector<std::size_t>& moved_parts)
+{
+  if (!_is_built)
+  {
+    dolfin_error("MultiMesh.cpp",
+                 "rebuild multimesh",
+                 "Multimesh has not been built. Call MultiMesh.build() first");
+  }
+
+  begin(PROGRESS, "Rebuilding multimesh.");
+
+  // Mark moved parts
+  std::vector<bool> moved(num_parts(), false);
+  for (auto part : moved_parts)
+  {
+    if (part >= num_parts())
+    {
+      dolfin_error("MultiMesh.cpp",
+                   "rebuild multimesh",
+                   "Part %d does not exist", (int) part);
+    }
+    moved[part] = true;
+  }
+
+  // Move the boundary meshes and refit the bounding box trees of the
+  // moved parts
+  for (std::size_t i = 0; i < num_parts(); i++)
+  {
+    if (!moved[i])
+      continue;
+
+    const std::size_t gdim = _meshes[i]->geometry().dim();
+    const std::vector<double>& x = _meshes[i]->coordinates();
+    std::vector<double>& x_boundary = _boundary_meshes[i]->coordinates();
+    const MeshFunction<std::size_t>& vertex_map
+      = _boundary_meshes[i]->entity_map(0);
+    for (std::size_t v = 0; v < vertex_map.size(); v++)
+      for (std::size_t d = 0; d < gdim; d++)
+        x_boundary[v*gdim + d] = x[vertex_map[v]*gdim + d];
+
+    _trees[i]->refit();
+    if (_boundary_meshes[i]->num_vertices() > 0)
+      _boundary_trees[i]->refit();
+  }
+
+  // The classification of part i depends on parts i, i + 1, ... so
+  // reclassify all parts below the highest moved part
+  std::size_t num_reclassified = 0;
+  for (std::size_t i = 0; i < num_parts(); i++)
+    if (moved[i])
+      num_reclassified = i + 1;
+
+  std::vector<std::vector<unsigned int>> cells(num_parts());
+  for (std::size_t i = 0; i < num_reclassified; i++)
+  {
+    // Recompute collision map, keeping the old map
+    const std::map<unsigned int,
+                   std::vector<std::pair<std::size_t, unsigned int>>>
+      old_collision_map = _collision_maps_cut_cells[i];
+    _build_collision_map(i);
+    const auto& collision_map = _collision_maps_cut_cells[i];
+
+    // Remove rules of cells that are no longer cut
+    for (const auto& it : old_collision_map)
+    {
+      if (collision_map.find(it.first) == collision_map.end())
+      {
+        _quadrature_rules_overlap[i].erase(it.first);
+        _quadrature_rules_cut_cells[i].erase(it.first);
+        _quadrature_rules_interface[i].erase(it.first);
+        _facet_normals[i].erase(it.first);
+      }
+    }
+
+    // Find cut cells for which the rules must be recomputed
+    for (const auto& it : collision_map)
+    {
+      auto old_it = old_collision_map.find(it.first);
+      bool recompute = moved[i] or old_it == old_collision_map.end()
+        or old_it->second != it.second;
+      for (std::size_t k = 0; k < it.second.size() and !recompute; k++)
+        recompute = moved[it.second[k].first];
+      if (recompute)
+        cells[i].push_back(it.first);
+    }
+
+    log(PROGRESS, "Recomputing quadrature rules for %d of %d cut cells in part %d.",
+        cells[i].size(), collision_map.size(), i);
+  }
+
+  // Recompute quadrature rules
+  _build_quadrature_rules_overlap(_quadrature_order, cells);
+  _build_quadrature_rules_cut_cells(_quadrature_order, cells);
+  _build_quadrature_rules_interface(_quadrature_order, cells);
 
   end();
 }
@@ -585,169 +724,200 @@ void MultiMesh::_build_collision_maps()
   _uncut_cells.clear();
   _covered_cells.clear();
   _collision_maps_cut_cells.clear();
+  _uncut_cells.resize(num_parts());
+  _covered_cells.resize(num_parts());
+  _collision_maps_cut_cells.resize(num_parts());
 
   // Iterate over all parts
   for (std::size_t i = 0; i < num_parts(); i++)
+    _build_collision_map(i);
+
+  end();
+}
+//-----------------------------------------------------------------------------
+void MultiMesh::_build_collision_map(std::size_t i)
+{
+  // Extract uncut, cut and covered cells:
+  //
+  // 0: uncut   = cell not colliding with any higher domain
+  // 1: cut     = cell colliding with some higher boundary and is not covered
+  // 2: covered = cell colliding with some higher domain but not its boundary
+
+  // Create vector of markers for cells in part `i` (0, 1, or 2)
+  std::vector<char> markers(_meshes[i]->num_cells(), 0);
+
+  // Create local arrays for marking domain and boundary collisions
+  // for cells in part `i`. Note that in contrast to the markers
+  // above which are global to part `i`, these markers are local to
+  // the collision between part `i` and part `j`.
+  std::vector<bool> collides_with_boundary(_meshes[i]->num_cells());
+  std::vector<bool> collides_with_domain(_meshes[i]->num_cells());
+
+  // Create empty collision map for cut cells in part `i`
+  std::map<unsigned int, std::vector<std::pair<std::size_t, unsigned int>>>
+    collision_map_cut_cells;
+
+  // Iterate over covering parts (with higher part number)
+  for (std::size_t j = i + 1; j < num_parts(); j++)
   {
-    // Extract uncut, cut and covered cells:
-    //
-    // 0: uncut   = cell not colliding with any higher domain
-    // 1: cut     = cell colliding with some higher boundary and is not covered
-    // 2: covered = cell colliding with some higher domain but not its boundary
-
-    // Create vector of markers for cells in part `i` (0, 1, or 2)
-    std::vector<char> markers(_meshes[i]->num_cells(), 0);
-
-    // Create local arrays for marking domain and boundary collisions
-    // for cells in part `i`. Note that in contrast to the markers
-    // above which are global to part `i`, these markers are local to
-    // the collision between part `i` and part `j`.
-    std::vector<bool> collides_with_boundary(_meshes[i]->num_cells());
-    std::vector<bool> collides_with_domain(_meshes[i]->num_cells());
-
-    // Create empty collision map for cut cells in part `i`
-    std::map<unsigned int, std::vector<std::pair<std::size_t, unsigned int>>>
-      collision_map_cut_cells;
-
-    // Iterate over covering parts (with higher part number)
-    for (std::size_t j = i + 1; j < num_parts(); j++)
-    {
-      log(PROGRESS, "Computing collisions for mesh %d overlapped by mesh %d.", i, j);
+    log(PROGRESS, "Computing collisions for mesh %d overlapped by mesh %d.", i, j);
 
-      // Compute domain-boundary collisions
-      const auto& boundary_collisions = _trees[i]->compute_collisions(*_boundary_trees[j]);
+    // Compute domain-boundary collisions
+    const auto& boundary_collisions = _trees[i]->compute_collisions(*_boundary_trees[j]);
 
-      // Reset boundary collision markers
-      std::fill(collides_with_boundary.begin(), collides_with_boundary.end(), false);
+    // Reset boundary collision markers
+    std::fill(collides_with_boundary.begin(), collides_with_boundary.end(), false);
 
-      // Iterate over boundary collisions.
-      for (std::size_t k = 0; k < boundary_collisions.first.size(); ++k)
-      {
-	// Get the colliding cell
-	const std::size_t cell_i = boundary_collisions.first[k];
+    // Iterate over boundary collisions.
+    for (std::size_t k = 0; k < boundary_collisions.first.size(); ++k)
+    {
+      // Get the colliding cell
+      const std::size_t cell_i = boundary_collisions.first[k];
 
-	// Do a careful check if not already marked as colliding
-	if (!collides_with_boundary[cell_i])
-	{
-	  const Cell cell(*_meshes[i], cell_i);
-	  const Cell boundary_cell(*_boundary_meshes[j], boundary_collisions.second[k]);
-	  collides_with_boundary[cell_i] = cell.collides(boundary_cell);
-	}
+      // Do a careful check if not already marked as colliding
+      if (!collides_with_boundary[cell_i])
+      {
+        const Cell cell(*_meshes[i], cell_i);
+        const Cell boundary_cell(*_boundary_meshes[j], boundary_collisions.second[k]);
+        collides_with_boundary[cell_i] = cell.collides(boundary_cell);
+      }
 
-	// Mark as cut cell if not previously covered
-	if (collides_with_boundary[cell_i] and markers[cell_i] != 2)
-	{
-	  // Mark as cut cell
-	  markers[cell_i] = 1;
+      // Mark as cut cell if not previously covered
+      if (collides_with_boundary[cell_i] and markers[cell_i] != 2)
+      {
+        // Mark as cut cell
+        markers[cell_i] = 1;
 
-	  // Add empty list of collisions into map if it does not exist
-	  if (collision_map_cut_cells.find(cell_i) == collision_map_cut_cells.end())
-	  {
-            std::vector<std::pair<std::size_t, unsigned int>> collisions;
-            collision_map_cut_cells[cell_i] = collisions;
-          }
+        // Add empty list of collisions into map if it does not exist
+        if (collision_map_cut_cells.find(cell_i) == collision_map_cut_cells.end())
+        {
+          std::vector<std::pair<std::size_t, unsigned int>> collisions;
+          collision_map_cut_cells[cell_i] = collisions;
         }
       }
+    }
 
-      // Compute domain-domain collisions
-      const auto& domain_collisions = _trees[i]->compute_collisions(*_trees[j]);
+    // Compute domain-domain collisions
+    const auto& domain_collisions = _trees[i]->compute_collisions(*_trees[j]);
 
-      // Reset domain collision markers
-      std::fill(collides_with_domain.begin(), collides_with_domain.end(), false);
+    // Reset domain collision markers
+    std::fill(collides_with_domain.begin(), collides_with_domain.end(), false);
 
-      // Iterate over domain collisions
-      dolfin_assert(domain_collisions.first.size() == domain_collisions.second.size());
-      for (std::size_t k = 0; k < domain_collisions.first.size(); k++)
+    // The collisions of all candidate pairs of cells cut by the
+    // boundary of part j are needed, so check these in a batch
+    dolfin_assert(domain_collisions.first.size() == domain_collisions.second.size());
+    std::vector<std::size_t> batch_pairs;
+    std::vector<unsigned int> batch_cells_i, batch_cells_j;
+    for (std::size_t k = 0; k < domain_collisions.first.size(); k++)
+    {
+      const unsigned int cell_i = domain_collisions.first[k];
+      if (markers[cell_i] == 1 and collides_with_boundary[cell_i])
       {
-        // Get the two colliding cells
-        const std::size_t cell_i = domain_collisions.first[k];
-	const std::size_t cell_j = domain_collisions.second[k];
+        batch_pairs.push_back(k);
+        batch_cells_i.push_back(cell_i);
+        batch_cells_j.push_back(domain_collisions.second[k]);
+      }
+    }
+    const std::vector<bool> batch_collisions
+      = CollisionPredicates::collides(*_meshes[i], batch_cells_i,
+                                      *_meshes[j], batch_cells_j);
+
+    // Iterate over domain collisions
+    std::size_t batch_index = 0;
+    for (std::size_t k = 0; k < domain_collisions.first.size(); k++)
+    {
+      // Get the two colliding cells
+      const std::size_t cell_i = domain_collisions.first[k];
+      const std::size_t cell_j = domain_collisions.second[k];
 
-        // Store collision in collision map if we have a cut cell
-        if (markers[cell_i] == 1)
+      // Store collision in collision map if we have a cut cell
+      if (markers[cell_i] == 1)
+      {
+        bool collides;
+        if (batch_index < batch_pairs.size() and batch_pairs[batch_index] == k)
+          collides = batch_collisions[batch_index++];
+        else
         {
-	  const Cell cell(*_meshes[i], cell_i);
-	  const Cell other_cell(*_meshes[j], cell_j);
-	  if (cell.collides(other_cell))
-	  {
-	    collides_with_domain[cell_i] = true;
-	    auto it = collision_map_cut_cells.find(cell_i);
-	    dolfin_assert(it != collision_map_cut_cells.end());
-	    it->second.emplace_back(j, cell_j);
-	  }
+          const Cell cell(*_meshes[i], cell_i);
+          const Cell other_cell(*_meshes[j], cell_j);
+          collides = cell.collides(other_cell);
         }
-
-        // Possibility to cell as covered if it does not collide with boundary
-        if (!collides_with_boundary[cell_i])
+        if (collides)
         {
-	  // Detailed check if it is not marked as colliding with domain
-	  if (!collides_with_domain[cell_i])
-	  {
-	    const Cell cell(*_meshes[i], cell_i);
-	    const Cell other_cell(*_meshes[j], cell_j);
-	    collides_with_domain[cell_i] = cell.collides(other_cell);
-	  }
+          collides_with_domain[cell_i] = true;
+          auto it = collision_map_cut_cells.find(cell_i);
+          dolfin_assert(it != collision_map_cut_cells.end());
+          it->second.emplace_back(j, cell_j);
+        }
+      }
 
-	  if (collides_with_domain[cell_i])
-	  {
-	    // Remove from collision map if previously marked as as cut cell
-	    if (markers[cell_i] == 1)
-	    {
-	      dolfin_assert(collision_map_cut_cells.find(cell_i) != collision_map_cut_cells.end());
-	      collision_map_cut_cells.erase(cell_i);
-	    }
+      // Possibility to cell as covered if it does not collide with boundary
+      if (!collides_with_boundary[cell_i])
+      {
+        // Detailed check if it is not marked as colliding with domain
+        if (!collides_with_domain[cell_i])
+        {
+          const Cell cell(*_meshes[i], cell_i);
+          const Cell other_cell(*_meshes[j], cell_j);
+          collides_with_domain[cell_i] = cell.collides(other_cell);
+        }
 
-	    // Mark as covered cell (may already be marked)
-	    markers[cell_i] = 2;
-	  }
+        if (collides_with_domain[cell_i])
+        {
+          // Remove from collision map if previously marked as as cut cell
+          if (markers[cell_i] == 1)
+          {
+            dolfin_assert(collision_map_cut_cells.find(cell_i) != collision_map_cut_cells.end());
+            collision_map_cut_cells.erase(cell_i);
+          }
 
+          // Mark as covered cell (may already be marked)
+          markers[cell_i] = 2;
         }
+
       }
     }
+  }
 
-    // Extract uncut, cut and covered cells from markers
-    std::vector<unsigned int> uncut_cells;
-    std::vector<unsigned int> cut_cells;
-    std::vector<unsigned int> covered_cells;
-    for (unsigned int c = 0; c < _meshes[i]->num_cells(); c++)
+  // Extract uncut, cut and covered cells from markers
+  std::vector<unsigned int> uncut_cells;
+  std::vector<unsigned int> cut_cells;
+  std::vector<unsigned int> covered_cells;
+  for (unsigned int c = 0; c < _meshes[i]->num_cells(); c++)
+  {
+    switch (markers[c])
     {
-      switch (markers[c])
-      {
-      case 0:
-        uncut_cells.push_back(c);
-        break;
-      case 1:
-        cut_cells.push_back(c);
-        break;
-      default:
-        covered_cells.push_back(c);
-      }
+    case 0:
+      uncut_cells.push_back(c);
+      break;
+    case 1:
+      cut_cells.push_back(c);
+      break;
+    default:
+      covered_cells.push_back(c);
     }
-
-    // Store data for this mesh
-    _uncut_cells.push_back(uncut_cells);
-    _covered_cells.push_back(covered_cells);
-    _collision_maps_cut_cells.push_back(collision_map_cut_cells);
-
-    // Report results
-    log(PROGRESS, "Part %d has %d uncut cells, %d cut cells, and %d covered cells.",
-        i, uncut_cells.size(), cut_cells.size(), covered_cells.size());
   }
 
-  end();
+  // Report results
+  log(PROGRESS, "Part %d has %d uncut cells, %d cut cells, and %d covered cells.",
+      i, uncut_cells.size(), cut_cells.size(), covered_cells.size());
+
+  // Store data for this mesh
+  _uncut_cells[i] = std::move(uncut_cells);
+  _covered_cells[i] = std::move(covered_cells);
+  _collision_maps_cut_cells[i] = std::move(collision_map_cut_cells);
 }
 //-----------------------------------------------------------------------------
-void MultiMesh::_build_quadrature_rules_overlap(std::size_t quadrature_order)
+void MultiMesh::_build_quadrature_rules_overlap
+  (std::size_t quadrature_order,
+   const std::vector<std::vector<unsigned int>>& cells)
 {
   begin(PROGRESS, "Building quadrature rules of cut cells' overlap.");
 
-  // Clear quadrature rules
-  _quadrature_rules_overlap.clear();
-
-  // Resize quadrature rules
-  _quadrature_rules_overlap.resize(num_parts());
-
   // Iterate over all parts
+  dolfin_assert(cells.size() == num_parts());
+  _quadrature_rules_overlap.resize(num_parts());
+  const bool compress = parameters["compress_volume_quadrature"];
   for (std::size_t cut_part = 0; cut_part < num_parts(); cut_part++)
   {
     // Construct quadrature rules on reference simplex
@@ -755,11 +925,17 @@ void MultiMesh::_build_quadrature_rules_overlap(std::size_t quadrature_order)
     const std::size_t gdim = _meshes[cut_part]->geometry().dim();
     const SimplexQuadrature sq(tdim, quadrature_order);
 
-    // Iterate over cut cells for current part
-    for (const auto& c : collision_map_cut_cells(cut_part))
+    // Iterate over given cut cells for current part (in parallel)
+    const auto& cmap = collision_map_cut_cells(cut_part);
+    const std::vector<unsigned int>& cut_cells = cells[cut_part];
+    std::vector<std::vector<quadrature_rule>> qrs(cut_cells.size());
+    #ifdef HAS_OPENMP
+    #pragma omp parallel for schedule(dynamic) num_threads(num_threads())
+    #endif
+    for (std::size_t n = 0; n < cut_cells.size(); n++)
     {
       // Get cut cell
-      const unsigned int cut_cell_index = c.first;
+      const unsigned int cut_cell_index = cut_cells[n];
       const Cell cut_cell(*(_meshes[cut_part]), cut_cell_index);
 
       // Data structure for the first intersections (this is the first
@@ -768,7 +944,8 @@ void MultiMesh::_build_quadrature_rules_overlap(std::size_t quadrature_order)
       std::vector<std::pair<std::size_t, Polyhedron>> initial_polyhedra;
 
       // Get the cutting cells
-      const std::vector<std::pair<std::size_t, unsigned int>>& cutting_cells = c.second;
+      const std::vector<std::pair<std::size_t, unsigned int>>& cutting_cells
+        = cmap.at(cut_cell_index);
 
       // Data structure for the overlap quadrature rule
       std::vector<quadrature_rule> overlap_qr(cutting_cells.size());
@@ -815,7 +992,7 @@ void MultiMesh::_build_quadrature_rules_overlap(std::size_t quadrature_order)
       //for (std::size_t i = 0; i < overlap_qr.size(); i++)
       //	remove_quadrature_rule(overlap_qr[i], tolerance);
 
-      if (parameters["compress_volume_quadrature"])
+      if (compress)
       {
       	for (std::size_t i = 0; i < overlap_qr.size(); ++i)
         {
@@ -824,22 +1001,27 @@ void MultiMesh::_build_quadrature_rules_overlap(std::size_t quadrature_order)
       }
 
       // Store quadrature rules for cut cell
-      _quadrature_rules_overlap[cut_part][cut_cell_index] = overlap_qr;
+      qrs[n] = std::move(overlap_qr);
     }
+
+    // Store quadrature rules for cut cells
+    for (std::size_t n = 0; n < cut_cells.size(); n++)
+      _quadrature_rules_overlap[cut_part][cut_cells[n]] = std::move(qrs[n]);
   }
 
   end();
 }
 //-----------------------------------------------------------------------------
-void MultiMesh::_build_quadrature_rules_cut_cells(std::size_t quadrature_order)
+void MultiMesh::_build_quadrature_rules_cut_cells
+  (std::size_t quadrature_order,
+   const std::vector<std::vector<unsigned int>>& cells)
 {
   begin(PROGRESS, "Building quadrature rules of cut cells.");
 
-  // Clear quadrature rules
-  _quadrature_rules_cut_cells.clear();
-  _quadrature_rules_cut_cells.resize(num_parts());
-
   // Iterate over all parts
+  dolfin_assert(cells.size() == num_parts());
+  _quadrature_rules_cut_cells.resize(num_parts());
+  const bool compress = parameters["compress_volume_quadrature"];
   for (std::size_t cut_part = 0; cut_part < num_parts(); cut_part++)
   {
     // Construct quadrature rules on reference simplex
@@ -847,40 +1029,51 @@ void MultiMesh::_build_quadrature_rules_cut_cells(std::size_t quadrature_order)
     const std::size_t gdim = _meshes[cut_part]->geometry().dim();
     const SimplexQuadrature sq(tdim, quadrature_order);
 
-    // Iterate over cut cells for current part
-    const auto& cmap = collision_map_cut_cells(cut_part);
-    for (auto it = cmap.begin(); it != cmap.end(); ++it)
+    // Iterate over given cut cells for current part (in parallel)
+    const auto& overlap = _quadrature_rules_overlap[cut_part];
+    const std::vector<unsigned int>& cut_cells = cells[cut_part];
+    std::vector<quadrature_rule> qrs(cut_cells.size());
+    #ifdef HAS_OPENMP
+    #pragma omp parallel for schedule(dynamic) num_threads(num_threads())
+    #endif
+    for (std::size_t n = 0; n < cut_cells.size(); n++)
     {
       // Get cut cell
-      const unsigned int cut_cell_index = it->first;
+      const unsigned int cut_cell_index = cut_cells[n];
       const Cell cut_cell(*(_meshes[cut_part]), cut_cell_index);
 
       // Compute quadrature rule for the cell itself.
       auto qr = sq.compute_quadrature_rule(cut_cell);
 
       // Get the quadrature rule for the overlapping part
-      const auto& qr_overlap = _quadrature_rules_overlap[cut_part][cut_cell_index];
+      const auto& qr_overlap = overlap.at(cut_cell_index);
 
       // Add the quadrature rule for the overlapping part to the
       // quadrature rule of the cut cell with flipped sign
       for (std::size_t k = 0; k < qr_overlap.size(); k++)
         _add_quadrature_rule(qr, qr_overlap[k], gdim, -1);
 
-      if (parameters["compress_volume_quadrature"])
+      if (compress)
       {
       	// Compress
       	SimplexQuadrature::compress(qr, gdim, quadrature_order);
       }
 
       // Store quadrature rule for cut cell
-      _quadrature_rules_cut_cells[cut_part][cut_cell_index] = qr;
+      qrs[n] = std::move(qr);
     }
+
+    // Store quadrature rules for cut cells
+    for (std::size_t n = 0; n < cut_cells.size(); n++)
+      _quadrature_rules_cut_cells[cut_part][cut_cells[n]] = std::move(qrs[n]);
   }
 
   end();
 }
 //------------------------------------------------------------------------------
-void MultiMesh::_build_quadrature_rules_interface(std::size_t quadrature_order)
+void MultiMesh::_build_quadrature_rules_interface
+  (std::size_t quadrature_order,
+   const std::vector<std::vector<unsigned int>>& cells)
 {
   begin(PROGRESS, "Building quadrature rules of interface.");
 
@@ -891,11 +1084,11 @@ void MultiMesh::_build_quadrature_rules_interface(std::size_t quadrature_order)
   //   |E_ij \ U_k T_k| = |E_ij| - |E_ij \cap U_k T_k|
   //                    = |E_ij| - |U_k E_ij \cap T_k|
 
-  // Clear and resize quadrature rules and normals
-  _quadrature_rules_interface.clear();
+  // Resize quadrature rules and normals
+  dolfin_assert(cells.size() == num_parts());
   _quadrature_rules_interface.resize(num_parts());
-  _facet_normals.clear();
   _facet_normals.resize(num_parts());
+  const bool compress = parameters["compress_interface_quadrature"];
 
   // First we prebuild a map from the boundary facets to full mesh
   // cells for all meshes: Loop over all boundary mesh facets to find
@@ -910,8 +1103,15 @@ void MultiMesh::_build_quadrature_rules_interface(std::size_t quadrature_order)
   std::vector<std::vector<std::vector<std::pair<std::size_t, std::size_t>>>>
     full_to_bdry(num_parts());
   for (std::size_t part = 0; part < num_parts(); ++part)
+  {
     full_to_bdry[part] = _boundary_facets_to_full_mesh(part);
 
+    // Compute cell-facet connectivity here since the mesh topology
+    // must not be modified by the (parallel) loop over cut cells
+    const std::size_t tdim = _meshes[part]->topology().dim();
+    _meshes[part]->init(tdim, tdim - 1);
+  }
+
   // Iterate over all parts
   for (std::size_t cut_part = 0; cut_part < num_parts(); cut_part++)
   {
@@ -923,19 +1123,25 @@ void MultiMesh::_build_quadrature_rules_interface(std::size_t quadrature_order)
     const std::size_t gdim = _meshes[cut_part]->geometry().dim();
     const SimplexQuadrature sq(tdim_interface, quadrature_order);
 
-    // Iterate over cut cells for current part
+    // Iterate over given cut cells for current part (in parallel)
     const std::map<unsigned int,
                    std::vector<std::pair<std::size_t,
                                          unsigned int>>>&
       cmap = collision_map_cut_cells(cut_part);
-    for (const auto cut_i: cmap)
+    const std::vector<unsigned int>& cut_cells = cells[cut_part];
+    std::vector<std::vector<quadrature_rule>> qrs(cut_cells.size());
+    std::vector<std::vector<std::vector<double>>> cell_normals(cut_cells.size());
+    #ifdef HAS_OPENMP
+    #pragma omp parallel for schedule(dynamic) num_threads(num_threads())
+    #endif
+    for (std::size_t n = 0; n < cut_cells.size(); n++)
     {
       // Get cut cell
-      const std::size_t cut_cell_index_i = cut_i.first;
+      const std::size_t cut_cell_index_i = cut_cells[n];
       const Cell cut_cell_i(*(_meshes[cut_part]), cut_cell_index_i);
 
       // Get the cutting cells
-      const auto& cutting_cells_j = cut_i.second;
+      const auto& cutting_cells_j = cmap.at(cut_cell_index_i);
 
       // Data structures for the interface quadrature rule and the normals
       const std::size_t num_cutting_cells
@@ -962,7 +1168,7 @@ void MultiMesh::_build_quadrature_rules_interface(std::size_t quadrature_order)
 
 	// Find and save all cutting cells with part number > i
 	// (this is always true), and part number != j.
-	for (const std::pair<size_t, unsigned int>& cutting_k: cut_i.second)
+	for (const std::pair<size_t, unsigned int>& cutting_k: cutting_cells_j)
 	{
 	  const std::size_t cutting_part_k = cutting_k.first;
 	  if (cutting_part_k != cutting_part_j)
@@ -1055,7 +1261,7 @@ void MultiMesh::_build_quadrature_rules_interface(std::size_t quadrature_order)
 	    //remove_quadrature_rule(interface_qr[local_cutting_cell_j_index], tolerance);
 
 	    // TODO: Investigate if we should compress here or below
-	    if (parameters["compress_interface_quadrature"])
+	    if (compress)
 	    {
 	      const std::vector<std::size_t> indices
 	    	= SimplexQuadrature::compress(interface_qr[local_cutting_cell_j_index],
@@ -1104,10 +1310,17 @@ void MultiMesh::_build_quadrature_rules_interface(std::size_t quadrature_order)
       // 	}
       // }
 
-      _quadrature_rules_interface[cut_part][cut_cell_index_i] = interface_qr;
-      _facet_normals[cut_part][cut_cell_index_i] = interface_normals;
+      qrs[n] = std::move(interface_qr);
+      cell_normals[n] = std::move(interface_normals);
 
-    } // end loop over cut_i
+    } // end loop over cut cells
+
+    // Store quadrature rules and normals for cut cells
+    for (std::size_t n = 0; n < cut_cells.size(); n++)
+    {
+      _quadrature_rules_interface[cut_part][cut_cells[n]] = std::move(qrs[n]);
+      _facet_normals[cut_part][cut_cells[n]] = std::move(cell_normals[n]);
+    }
   } // end loop over parts
 
   end();
@@ -1165,10 +1378,19 @@ MultiMesh::_add_quadrature_rule(quadrature_rule& qr,
                                 std::size_t quadrature_order,
                                 double factor) const
 {
-  // Compute quadrature rule for simplex
-  const auto dqr = sq.compute_quadrature_rule(simplex, gdim);
-  // Add quadrature rule
-  const std::size_t num_points = _add_quadrature_rule(qr, dqr, gdim, factor);
+  // Compute quadrature rule for simplex directly into qr
+  const std::size_t offset = qr.second.size();
+  qr.first.resize(gdim*(offset + sq.num_points()));
+  qr.second.resize(offset + sq.num_points());
+  const std::size_t num_points
+    = sq.compute_quadrature_rule(simplex, gdim, qr.first.data() + gdim*offset,
+                                 qr.second.data() + offset);
+  qr.first.resize(gdim*(offset + num_points));
+  qr.second.resize(offset + num_points);
+
+  // Scale weights
+  for (std::size_t i = offset; i < qr.second.size(); ++i)
+    qr.second[i] *= factor;
 
   return num_points;
 }
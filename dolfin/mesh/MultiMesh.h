@@ -347,9 +347,27 @@ namespace dolfin
     ///         The mesh
     void add(std::shared_ptr<const Mesh> mesh);
 
-    /// Build multimesh
+    /// Build multimesh. The quadrature rules of the cut cells are
+    /// computed in parallel using the number of threads given by the
+    /// global parameter "num_threads".
     void build(std::size_t quadrature_order=2);
 
+    /// Rebuild multimesh after the vertex coordinates of some parts
+    /// have changed (the topology of all parts must be unchanged).
+    /// The bounding box trees of the moved parts are refitted and
+    /// the cells of the moved parts and of the parts below them are
+    /// reclassified. Quadrature rules are only recomputed for cut
+    /// cells that are new, that have a changed list of cutting cells
+    /// or that are cut by (or belong to) a moved part. The rules of
+    /// the remaining cut cells are kept. Cells marked as covered by
+    /// mark_covered() or auto_cover() are reset for all reclassified
+    /// parts.
+    ///
+    /// *Arguments*
+    ///     moved_parts (std::vector<std::size_t>)
+    ///         The part numbers of the moved parts
+    void rebuild(const std::vector<std::size_t>& moved_parts);
+
     /// Check whether multimesh has been built
     bool is_built() const { return _is_built; }
 
@@ -393,6 +411,9 @@ namespace dolfin
     // Flag for whether multimesh has been built
     bool _is_built;
 
+    // Quadrature order used for the last build
+    std::size_t _quadrature_order;
+
     // List of meshes
     std::vector<std::shared_ptr<const Mesh> > _meshes;
 
@@ -516,17 +537,30 @@ namespace dolfin
 
     // Build collision maps
     void _build_collision_maps();
+
+    // Build collision map (and uncut and covered cells) for one part
+    void _build_collision_map(std::size_t part);
     //void _build_collision_maps_same_topology();
     //void _build_collision_maps_different_topology();
 
-    // Build quadrature rules for the cut cells
-    void _build_quadrature_rules_cut_cells(std::size_t quadrature_order);
-
-    // Build quadrature rules for the overlap
-    void _build_quadrature_rules_overlap(std::size_t quadrature_order);
-
-    // Build quadrature rules and normals for the interface
-    void _build_quadrature_rules_interface(std::size_t quadrature_order);
+    // Build quadrature rules for the given cut cells of each part
+    // (rules of other cells are not changed)
+    void _build_quadrature_rules_cut_cells
+      (std::size_t quadrature_order,
+       const std::vector<std::vector<unsigned int>>& cells);
+
+    // Build quadrature rules for the overlap of the given cut cells
+    // of each part (rules of other cells are not changed)
+    void _build_quadrature_rules_overlap
+      (std::size_t quadrature_order,
+       const std::vector<std::vector<unsigned int>>& cells);
+
+    // Build quadrature rules and normals for the interface of the
+    // given cut cells of each part (rules of other cells are not
+    // changed)
+    void _build_quadrature_rules_interface
+      (std::size_t quadrature_order,
+       const std::vector<std::vector<unsigned int>>& cells);
 
     // Help function to determine if interface intersection is
     // (exactly) overlapped by a cutting cell
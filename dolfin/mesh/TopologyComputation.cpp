@@ -16,7 +16,9 @@
 // along with DOLFIN. If not, see <http://www.gnu.org/licenses/>.
 
 #include <algorithm>
+#include <array>
 #include <cstdint>
+#include <numeric>
 #include <string>
 #include <tuple>
 #include <utility>
@@ -25,9 +27,14 @@
 #include <boost/unordered_map.hpp>
 #include <boost/version.hpp>
 
+#ifdef HAS_OPENMP
+#include <omp.h>
+#endif
+
 #include <dolfin/common/Timer.h>
 #include <dolfin/common/utils.h>
 #include <dolfin/log/log.h>
+#include <dolfin/parameter/GlobalParameters.h>
 #include "Cell.h"
 #include "CellType.h"
 #include "Mesh.h"
@@ -38,6 +45,50 @@
 
 using namespace dolfin;
 
+namespace
+{
+  // Sort vector using num_threads threads. Chunks of the vector are
+  // sorted concurrently and then merged pairwise. The result is the
+  // same as for std::sort if the elements have a strict total order.
+  template<typename T>
+  void parallel_sort(std::vector<T>& v, std::size_t num_threads)
+  {
+    if (num_threads <= 1 or v.size() < 1000*num_threads)
+    {
+      std::sort(v.begin(), v.end());
+      return;
+    }
+
+    // Sort chunks
+    std::vector<std::size_t> chunks(num_threads + 1);
+    for (std::size_t t = 0; t <= num_threads; ++t)
+      chunks[t] = t*v.size()/num_threads;
+    #ifdef HAS_OPENMP
+    #pragma omp parallel for num_threads(num_threads)
+    #endif
+    for (std::size_t t = 0; t < num_threads; ++t)
+      std::sort(v.begin() + chunks[t], v.begin() + chunks[t + 1]);
+
+    // Merge pairs of sorted chunks
+    for (std::size_t width = 1; width < num_threads; width *= 2)
+    {
+      #ifdef HAS_OPENMP
+      #pragma omp parallel for num_threads(num_threads)
+      #endif
+      for (std::size_t t = 0; t < num_threads; t += 2*width)
+      {
+        if (t + width < num_threads)
+        {
+          const std::size_t end = std::min(t + 2*width, num_threads);
+          std::inplace_merge(v.begin() + chunks[t],
+                             v.begin() + chunks[t + width],
+                             v.begin() + chunks[end]);
+        }
+      }
+    }
+  }
+}
+
 //-----------------------------------------------------------------------------
 std::size_t TopologyComputation::compute_entities(Mesh& mesh, std::size_t dim)
 {
@@ -198,122 +249,146 @@ std::int32_t TopologyComputation::compute_entities_by_key_matching(Mesh& mesh,
 
   dolfin_assert(N == num_vertices);
 
-  // Create data structure to hold entities
-  // ([vertices key], (cell_local_index, cell index), [entity vertices], entity index)
-  std::vector<std::tuple<std::array<std::int32_t, N>,
-                         std::pair<std::int8_t, std::int32_t>,
-                         std::array<std::int32_t, N>, std::int32_t>>
-    keyed_entities(num_entities*mesh.num_cells());
+  // Get number of threads
+  const std::size_t num_threads = dolfin::num_threads();
+
+  // Create data structure to hold entities, ([vertices key],
+  // (cell_local_index, cell index)). The entity vertices are
+  // recomputed from the cell when needed.
+  const std::int32_t num_cells = mesh.num_cells();
+  const std::int32_t ghost_offset = topology.ghost_offset(topology.dim());
+  const MeshConnectivity& cv = topology(topology.dim(), 0);
+  std::vector<std::pair<std::array<std::int32_t, N>,
+                        std::pair<std::int8_t, std::int32_t>>>
+    keyed_entities(num_entities*num_cells);
 
   // Loop over cells to build list of keyed (by vertices) entities
-  int entity_counter = 0;
-  for (CellIterator c(mesh, "all"); !c.end(); ++c)
+  #ifdef HAS_OPENMP
+  #pragma omp parallel for num_threads(num_threads)
+  #endif
+  for (std::int32_t cell_index = 0; cell_index < num_cells; ++cell_index)
   {
     // Get vertices from cell
-    const unsigned int* vertices = c->entities(0);
+    const unsigned int* vertices = cv(cell_index);
     dolfin_assert(vertices);
 
     // Iterate over entities of cell
-    const int cell_index = c->index();
     for (std::int8_t i = 0; i < num_entities; ++i)
     {
-      // Get entity vertices
-      auto& entity = std::get<2>(keyed_entities[entity_counter]);
-      for (std::int8_t j = 0; j < num_vertices; ++j)
-        entity[j] = vertices[e_vertices[i][j]];
+      auto& keyed_entity = keyed_entities[cell_index*num_entities + i];
 
       // Sort entity vertices to create key
-      auto& entity_key = std::get<0>(keyed_entities[entity_counter]);
-      std::partial_sort_copy(entity.begin(), entity.end(),
-                             entity_key.begin(), entity_key.end());
+      auto& entity_key = keyed_entity.first;
+      for (std::int8_t j = 0; j < num_vertices; ++j)
+        entity_key[j] = vertices[e_vertices[i][j]];
+      std::sort(entity_key.begin(), entity_key.end());
 
       // Attach (local index, cell index), making local_index negative
       // if it is not a ghost cell. This ensures that non-ghosts come
       // before ghosts when sorted. The index is corrected later.
-      if (!c->is_ghost())
-        std::get<1>(keyed_entities[entity_counter]) = {-i - 1, cell_index};
+      if (cell_index < ghost_offset)
+        keyed_entity.second = {-i - 1, cell_index};
       else
-        std::get<1>(keyed_entities[entity_counter]) = {i, cell_index};
-
-      // Increment entity counter
-      ++entity_counter;
+        keyed_entity.second = {i, cell_index};
     }
   }
 
   // Sort entities by key. For the same key, those beloning to
   // non-ghost cells will appear before those belonging to ghost
-  // cells.
-  std::sort(keyed_entities.begin(), keyed_entities.end());
-
-  // Compute entity indices (using -1, -2, -3, etc, for ghost
-  // entities)
-  std::int32_t nonghost_index(0), ghost_index(-1);
-  std::array<std::int32_t, N> previous_key;
-  std::fill(previous_key.begin(), previous_key.end(), -1);
-  for (auto e = keyed_entities.begin(); e!= keyed_entities.end(); ++e)
+  // cells. Since (local index, cell index) is unique, the order (and
+  // hence the numbering) does not depend on the number of threads.
+  parallel_sort(keyed_entities, num_threads);
+
+  // Split sorted entities into one chunk per thread, and count the
+  // new (first of each key) non-ghost and ghost entities in each
+  // chunk
+  const std::size_t num_keyed = keyed_entities.size();
+  std::vector<std::size_t> chunks(num_threads + 1);
+  for (std::size_t t = 0; t <= num_threads; ++t)
+    chunks[t] = t*num_keyed/num_threads;
+  auto is_new = [&keyed_entities](std::size_t k)
+    { return k == 0 or keyed_entities[k].first != keyed_entities[k - 1].first; };
+
+  std::vector<std::int32_t> num_new_nonghost(num_threads + 1, 0);
+  std::vector<std::int32_t> num_new_ghost(num_threads + 1, 0);
+  #ifdef HAS_OPENMP
+  #pragma omp parallel for num_threads(num_threads)
+  #endif
+  for (std::size_t t = 0; t < num_threads; ++t)
   {
-    const auto& key = std::get<0>(*e);
-    if (key == previous_key)
+    for (std::size_t k = chunks[t]; k < chunks[t + 1]; ++k)
     {
-      // Repeated entity, reuse entity index
-      std::get<3>(*e) = std::get<3>(*(e - 1));
-    }
-    else
-    {
-      // New entity, so give index (negative for ghosts)
-      const auto local_index = std::get<1>(*e).first;
-      if (local_index < 0)
-        std::get<3>(*e) = nonghost_index++;
-      else
-        std::get<3>(*e) = ghost_index--;
-
-      // Update key
-      previous_key = key;
+      if (is_new(k))
+      {
+        if (keyed_entities[k].second.first < 0)
+          ++num_new_nonghost[t + 1];
+        else
+          ++num_new_ghost[t + 1];
+      }
     }
-
-    // Re-map local index (make all positive)
-    auto& local_index = std::get<1>(*e).first;
-    local_index = (local_index < 0) ? (-local_index - 1) : local_index;
   }
+  std::partial_sum(num_new_nonghost.begin(), num_new_nonghost.end(),
+                   num_new_nonghost.begin());
+  std::partial_sum(num_new_ghost.begin(), num_new_ghost.end(),
+                   num_new_ghost.begin());
 
   // Total number of entities
-  const std::int32_t num_nonghost_entities = nonghost_index;
-  const std::int32_t num_ghost_entities = -(ghost_index + 1);
+  const std::int32_t num_nonghost_entities = num_new_nonghost.back();
+  const std::int32_t num_ghost_entities = num_new_ghost.back();
   const std::int32_t num_mesh_entities = num_nonghost_entities + num_ghost_entities;
 
   // List of vertex indices connected to entity e
-  std::vector<std::array<int, N>> connectivity_ev(num_mesh_entities) ;
+  std::vector<std::array<int, N>> connectivity_ev(num_mesh_entities);
 
   // List of entity e indices connected to cell
   boost::multi_array<int, 2>
-    connectivity_ce(boost::extents[mesh.num_cells()][num_entities]);
-
-  // Build connectivity arrays (with ghost entities at the end)
-  //std::int32_t previous_index = -1;
-  std::int32_t previous_index = std::numeric_limits<std::int32_t>::min();
-  for (auto& entity : keyed_entities)
+    connectivity_ce(boost::extents[num_cells][num_entities]);
+
+  // Compute entity indices (non-ghosts first, ghosts at the end) and
+  // build connectivity arrays
+  #ifdef HAS_OPENMP
+  #pragma omp parallel for num_threads(num_threads)
+  #endif
+  for (std::size_t t = 0; t < num_threads; ++t)
   {
-    // Get entity index, and remap for ghosts (negative entity index)
-    // to true index
-    auto& e_index = std::get<3>(entity);
-    if (e_index < 0)
-      e_index = num_nonghost_entities - (e_index + 1);
-
-    // Add to enity-to-vertex map if entity is new
-    if (e_index != previous_index)
+    std::int32_t nonghost_index = num_new_nonghost[t];
+    std::int32_t ghost_index = num_nonghost_entities + num_new_ghost[t];
+
+    // Find index of entity continued from the previous chunk (if
+    // any). The first entity with this key is new, and it is a
+    // non-ghost entity if any entity with the key is.
+    std::int32_t e_index = -1;
+    const std::size_t begin = chunks[t];
+    if (begin < chunks[t + 1] and !is_new(begin))
     {
-      dolfin_assert(e_index < (std::int32_t) connectivity_ev.size());
-      connectivity_ev[e_index] = std::get<2>(entity);
-
-      // Update index
-      previous_index = e_index;
+      std::size_t first = begin;
+      while (!is_new(first))
+        --first;
+      e_index = keyed_entities[first].second.first < 0
+        ? nonghost_index - 1 : ghost_index - 1;
     }
 
-    // Add to cell-to-entity map
-    const auto& cell = std::get<1>(entity);
-    const auto local_index = cell.first;
-    const auto cell_index = cell.second;
-    connectivity_ce[cell_index][local_index] = e_index;
+    for (std::size_t k = begin; k < chunks[t + 1]; ++k)
+    {
+      // Re-map local index (make all positive). The sorted entities
+      // are not modified since other threads may read them.
+      const std::int8_t index = keyed_entities[k].second.first;
+      const bool nonghost = index < 0;
+      const std::int8_t local_index = nonghost ? (-index - 1) : index;
+      const std::int32_t cell_index = keyed_entities[k].second.second;
+
+      // New entity, so give index and add to entity-to-vertex map
+      if (is_new(k))
+      {
+        e_index = nonghost ? nonghost_index++ : ghost_index++;
+        const unsigned int* vertices = cv(cell_index);
+        for (std::int8_t j = 0; j < num_vertices; ++j)
+          connectivity_ev[e_index][j] = vertices[e_vertices[local_index][j]];
+      }
+
+      // Add to cell-to-entity map
+      connectivity_ce[cell_index][local_index] = e_index;
+    }
   }
 
   // Initialise connectivity data structure
@@ -74,6 +74,12 @@ namespace dolfin
       // Print the level of thread support provided by the MPI library
       p.add("print_mpi_thread_support_level", false);
 
+      //-- Parallel
+
+      // Number of threads used in multithreaded assembly (0 for
+      // serial assembly)
+      p.add("num_threads", 0);
+
       //-- dof ordering
 
       // DOF reordering when running in serial
@@ -97,6 +103,12 @@ namespace dolfin
       p.add("reorder_cells_gps", false);
       p.add("reorder_vertices_gps", false);
 
+      // Maximum number of cells (vertices) sent by a process (to a
+      // process) in one round during mesh distribution (0 = no
+      // limit). A process may receive this many from every other
+      // process per round.
+      p.add("mesh_distribution_chunk_size", 0);
+
       // Set default graph/mesh partitioner
       std::string default_mesh_partitioner = "SCOTCH";
       #ifdef HAS_PARMETIS
@@ -122,6 +134,12 @@ namespace dolfin
       p.add("refinement_algorithm", "plaza",
             {"regular_cut", "plaza", "plaza_with_parent_facets"});
 
+      //-- Geometry
+
+      // Split strategy for building bounding box trees
+      p.add("bounding_box_tree_split", "median",
+            {"median", "sah", "morton"});
+
       //-- Graphs
 
       // Graph coloring
@@ -120,7 +120,7 @@ from .cpp.mesh import (Mesh, MeshTopology, MeshGeometry, MeshEntity,
                        MeshEditor, MeshQuality, SubMesh,
                        DomainBoundary, PeriodicBoundaryComputation,
                        MeshTransformation, SubsetIterator, MultiMesh, MeshView,
-                       MeshPartitioning)
+                       MeshPartitioning, MeshRenumbering)
 
 from .cpp.nls import (NonlinearProblem, NewtonSolver, OptimisationProblem)
 from .cpp.refinement import refine, p_refine
@@ -142,14 +142,15 @@ from .common.timer import Timer, timed
 from .common.plotting import plot
 
 from .fem.assembling import (assemble, assemble_system, assemble_multimesh, assemble_mixed,
-                             SystemAssembler, assemble_local)
+                             SystemAssembler, AssemblyPlan, IncrementalAssembler,
+                             assemble_local)
 from .fem.form import Form
 from .fem.norms import norm, errornorm
 from .fem.dirichletbc import DirichletBC, AutoSubDomain
 from .fem.multimeshdirichletbc import MultiMeshDirichletBC
 from .fem.interpolation import interpolate
 from .fem.projection import project
-from .fem.solvers import LocalSolver
+from .fem.solvers import LocalSolver, FormLinearOperator, SumFactorizedOperator
 from .fem.solving import (solve, LinearVariationalProblem,
                           NonlinearVariationalProblem,
                           MixedLinearVariationalProblem,
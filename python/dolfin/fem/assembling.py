@@ -38,7 +38,8 @@ from dolfin.function.multimeshfunction import MultiMeshFunction
 from ufl.form import sub_forms_by_domain
 
 __all__ = ["assemble", "assemble_mixed", "assemble_local", "assemble_system",
-           "assemble_multimesh", "SystemAssembler"]
+           "assemble_multimesh", "SystemAssembler", "AssemblyPlan",
+           "IncrementalAssembler"]
 
 
 def _create_dolfin_form(form, form_compiler_parameters=None,
@@ -205,8 +206,11 @@ def assemble(form, tensor=None, form_compiler_parameters=None,
     comm = dolfin_form.mesh().mpi_comm()
     tensor = _create_tensor(comm, form, dolfin_form.rank(), backend, tensor)
 
-    # Create C++ assembler
-    assembler = cpp.fem.Assembler()
+    # Create C++ assembler (multithreaded if requested)
+    if cpp.parameter.parameters["num_threads"] > 0:
+        assembler = cpp.fem.OpenMpAssembler()
+    else:
+        assembler = cpp.fem.Assembler()
 
     # Set assembler options
     assembler.add_values = add_values
@@ -520,3 +524,45 @@ class SystemAssembler(cpp.fem.SystemAssembler):
             # Keep Python counterpart of bcs (and Python object it owns)
             # alive
             self._bcs = bcs
+
+
+class AssemblyPlan(cpp.fem.AssemblyPlan):
+    __doc__ = cpp.fem.AssemblyPlan.__doc__
+
+    def __init__(self, form, form_compiler_parameters=None):
+        """
+        Create an AssemblyPlan for repeated assembly of a form on a
+        fixed mesh
+
+        * Arguments *
+           form (ufl.Form, _Form_)
+              Form to assemble
+        """
+
+        # Create dolfin Form object referencing all data needed by
+        # assembler
+        self._form = _create_dolfin_form(form, form_compiler_parameters)
+
+        # Call C++ constructor
+        cpp.fem.AssemblyPlan.__init__(self, self._form)
+
+
+class IncrementalAssembler(cpp.fem.IncrementalAssembler):
+    __doc__ = cpp.fem.IncrementalAssembler.__doc__
+
+    def __init__(self, form, form_compiler_parameters=None):
+        """
+        Create an IncrementalAssembler for re-assembly of a form on
+        cells where the form has changed
+
+        * Arguments *
+           form (ufl.Form, _Form_)
+              Form to assemble
+        """
+
+        # Create dolfin Form object referencing all data needed by
+        # assembler
+        self._form = _create_dolfin_form(form, form_compiler_parameters)
+
+        # Call C++ constructor
+        cpp.fem.IncrementalAssembler.__init__(self, self._form)
@@ -20,7 +20,7 @@
 import dolfin.cpp as cpp
 from dolfin.fem.form import Form
 
-__all__ = ["LocalSolver"]
+__all__ = ["LocalSolver", "FormLinearOperator", "SumFactorizedOperator"]
 
 
 class LocalSolver(cpp.fem.LocalSolver):
@@ -48,3 +48,35 @@ class LocalSolver(cpp.fem.LocalSolver):
 
         # Initialize C++ base class
         cpp.fem.LocalSolver.__init__(self, a, L, solver_type)
+
+
+class FormLinearOperator(cpp.fem.FormLinearOperator):
+
+    def __init__(self, a):
+        """Create a matrix-free linear operator whose action is defined
+        by the bilinear form a.
+
+        """
+
+        # Store input UFL form
+        self.a_ufl = a
+
+        # Initialize C++ base class
+        cpp.fem.FormLinearOperator.__init__(self, Form(a))
+
+
+class SumFactorizedOperator(cpp.fem.SumFactorizedOperator):
+
+    def __init__(self, V, mass=0.0, stiffness=1.0):
+        """Create a matrix-free operator for the bilinear form
+        mass*u*v*dx + stiffness*inner(grad(u), grad(v))*dx on the
+        scalar Lagrange space V on a quadrilateral or hexahedral
+        mesh. The action is computed by sum factorisation.
+
+        """
+
+        # Store function space
+        self.function_space = V
+
+        # Initialize C++ base class
+        cpp.fem.SumFactorizedOperator.__init__(self, V._cpp_object, mass, stiffness)
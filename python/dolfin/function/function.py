@@ -370,6 +370,17 @@ class Function(ufl.Coefficient):
     def eval(self, u, x):
         return self._cpp_object.eval(u, x)
 
+    def eval_points(self, x):
+        """Evaluate function at a list of points (one point per row
+        of x) and return the values (one point per row)"""
+        return self._cpp_object.eval_points(x)
+
+    def eval_points_collective(self, x):
+        """Evaluate function at a list of points (one point per row
+        of x) given on any process and return the values (one point
+        per row). Must be called on all processes."""
+        return self._cpp_object.eval_points_collective(x)
+
     def extrapolate(self, u):
         if isinstance(u, ufl.Coefficient):
             self._cpp_object.extrapolate(u._cpp_object)
@@ -34,6 +34,9 @@
 #include <dolfin/fem/assemble.h>
 #include <dolfin/fem/assemble_local.h>
 #include <dolfin/fem/Assembler.h>
+#include <dolfin/fem/AssemblyPlan.h>
+#include <dolfin/fem/IncrementalAssembler.h>
+#include <dolfin/fem/OpenMpAssembler.h>
 #include <dolfin/fem/MultiMeshAssembler.h>
 #include <dolfin/fem/MixedAssembler.h>
 #include <dolfin/fem/DirichletBC.h>
@@ -42,6 +45,7 @@
 #include <dolfin/fem/MultiMeshDofMap.h>
 #include <dolfin/fem/FiniteElement.h>
 #include <dolfin/fem/Form.h>
+#include <dolfin/fem/FormLinearOperator.h>
 #include <dolfin/fem/MultiMeshForm.h>
 #include <dolfin/fem/LinearVariationalProblem.h>
 #include <dolfin/fem/LinearVariationalSolver.h>
@@ -55,7 +59,9 @@
 #include <dolfin/fem/PETScDMCollection.h>
 #include <dolfin/fem/PointSource.h>
 #include <dolfin/fem/SparsityPatternBuilder.h>
+#include <dolfin/fem/SumFactorizedOperator.h>
 #include <dolfin/fem/SystemAssembler.h>
+#include <dolfin/fem/VectorizedCellIntegral.h>
 #include <dolfin/function/GenericFunction.h>
 #include <dolfin/function/FunctionSpace.h>
 #include <dolfin/function/MultiMeshFunctionSpace.h>
@@ -422,7 +428,58 @@ namespace dolfin_wrappers
     py::class_<dolfin::Assembler, std::shared_ptr<dolfin::Assembler>, dolfin::AssemblerBase>
       (m, "Assembler", "DOLFIN Assembler object")
       .def(py::init<>())
-      .def("assemble", &dolfin::Assembler::assemble);
+      .def("assemble", &dolfin::Assembler::assemble)
+      .def_readwrite("cell_batch_size", &dolfin::Assembler::cell_batch_size)
+      .def_readwrite("overlap_communication", &dolfin::Assembler::overlap_communication);
+
+    // dolfin::OpenMpAssembler
+    py::class_<dolfin::OpenMpAssembler, std::shared_ptr<dolfin::OpenMpAssembler>, dolfin::AssemblerBase>
+      (m, "OpenMpAssembler", "DOLFIN multithreaded assembler object")
+      .def(py::init<>())
+      // Release the GIL so that threads restricting Python
+      // expressions can acquire it (in the PyExpression trampoline)
+      .def("assemble", &dolfin::OpenMpAssembler::assemble,
+           py::call_guard<py::gil_scoped_release>())
+      .def_readwrite("coloring_type", &dolfin::OpenMpAssembler::coloring_type);
+
+    // dolfin::AssemblyPlan
+    py::class_<dolfin::AssemblyPlan, std::shared_ptr<dolfin::AssemblyPlan>, dolfin::AssemblerBase>
+      (m, "AssemblyPlan", "DOLFIN AssemblyPlan object for repeated assembly")
+      .def(py::init<std::shared_ptr<const dolfin::Form>>())
+      .def("assemble", &dolfin::AssemblyPlan::assemble);
+
+    // dolfin::IncrementalAssembler
+    py::class_<dolfin::IncrementalAssembler, std::shared_ptr<dolfin::IncrementalAssembler>,
+               dolfin::AssemblerBase>
+      (m, "IncrementalAssembler", "DOLFIN assembler object for re-assembly on changed cells")
+      .def(py::init<std::shared_ptr<const dolfin::Form>>())
+      .def("assemble", &dolfin::IncrementalAssembler::assemble)
+      .def("update", (void (dolfin::IncrementalAssembler::*)(dolfin::GenericTensor&,
+                                                             const dolfin::MeshFunction<bool>&))
+           &dolfin::IncrementalAssembler::update)
+      .def("update", (void (dolfin::IncrementalAssembler::*)(dolfin::GenericTensor&,
+                                                             const std::vector<std::size_t>&))
+           &dolfin::IncrementalAssembler::update)
+      .def("num_stored_entries", &dolfin::IncrementalAssembler::num_stored_entries);
+
+    // dolfin::FormLinearOperator
+    py::class_<dolfin::FormLinearOperator, std::shared_ptr<dolfin::FormLinearOperator>,
+               dolfin::LinearOperator>
+      (m, "FormLinearOperator", "Matrix-free linear operator defined by a bilinear form")
+      .def(py::init<std::shared_ptr<const dolfin::Form>>())
+      .def("size", &dolfin::FormLinearOperator::size)
+      .def("mult", &dolfin::FormLinearOperator::mult)
+      .def("update", &dolfin::FormLinearOperator::update)
+      .def_readwrite("cache_element_tensors", &dolfin::FormLinearOperator::cache_element_tensors);
+
+    // dolfin::SumFactorizedOperator
+    py::class_<dolfin::SumFactorizedOperator, std::shared_ptr<dolfin::SumFactorizedOperator>,
+               dolfin::LinearOperator>
+      (m, "SumFactorizedOperator", "Matrix-free sum-factorised operator on quadrilateral and hexahedral cells")
+      .def(py::init<std::shared_ptr<const dolfin::FunctionSpace>, double, double>())
+      .def("size", &dolfin::SumFactorizedOperator::size)
+      .def("mult", &dolfin::SumFactorizedOperator::mult)
+      .def("degree", &dolfin::SumFactorizedOperator::degree);
 
     // dolfin::MixedAssembler
     py::class_<dolfin::MixedAssembler, std::shared_ptr<dolfin::MixedAssembler>, dolfin::AssemblerBase>
@@ -437,17 +494,25 @@ namespace dolfin_wrappers
            std::vector<std::shared_ptr<const dolfin::DirichletBC>>>())
       .def(py::init<std::vector<std::shared_ptr<const dolfin::Form>>, std::vector<std::shared_ptr<const dolfin::Form>>,
            std::vector<std::vector<std::shared_ptr<const dolfin::DirichletBC>>>>())
+      // The GIL is released as for OpenMpAssembler (threaded assembly
+      // restricts Python expressions from worker threads)
       .def("assemble", (void (dolfin::SystemAssembler::*)(dolfin::GenericMatrix&, dolfin::GenericVector&))
-           &dolfin::SystemAssembler::assemble)
+           &dolfin::SystemAssembler::assemble,
+           py::call_guard<py::gil_scoped_release>())
       .def("assemble", (void (dolfin::SystemAssembler::*)(std::vector<std::shared_ptr<dolfin::GenericMatrix>>, std::vector<std::shared_ptr<dolfin::GenericVector>>))
-           &dolfin::SystemAssembler::assemble)
-      .def("assemble", (void (dolfin::SystemAssembler::*)(dolfin::GenericMatrix&)) &dolfin::SystemAssembler::assemble)
-      .def("assemble", (void (dolfin::SystemAssembler::*)(dolfin::GenericVector&)) &dolfin::SystemAssembler::assemble)
+           &dolfin::SystemAssembler::assemble,
+           py::call_guard<py::gil_scoped_release>())
+      .def("assemble", (void (dolfin::SystemAssembler::*)(dolfin::GenericMatrix&)) &dolfin::SystemAssembler::assemble,
+           py::call_guard<py::gil_scoped_release>())
+      .def("assemble", (void (dolfin::SystemAssembler::*)(dolfin::GenericVector&)) &dolfin::SystemAssembler::assemble,
+           py::call_guard<py::gil_scoped_release>())
       .def("assemble", (void (dolfin::SystemAssembler::*)(dolfin::GenericMatrix&, dolfin::GenericVector&,
                                                           const dolfin::GenericVector&))
-           &dolfin::SystemAssembler::assemble)
+           &dolfin::SystemAssembler::assemble,
+           py::call_guard<py::gil_scoped_release>())
       .def("assemble", (void (dolfin::SystemAssembler::*)(dolfin::GenericVector&, const dolfin::GenericVector&))
-           &dolfin::SystemAssembler::assemble);
+           &dolfin::SystemAssembler::assemble,
+           py::call_guard<py::gil_scoped_release>());
 
     // dolfin::DiscreteOperators
     py::class_<dolfin::DiscreteOperators> (m, "DiscreteOperators")
@@ -479,9 +544,18 @@ namespace dolfin_wrappers
       .def("set_exterior_facet_domains", &dolfin::Form::set_exterior_facet_domains)
       .def("set_interior_facet_domains", &dolfin::Form::set_interior_facet_domains)
       .def("set_vertex_domains", &dolfin::Form::set_vertex_domains)
+      .def("set_vectorized_cell_integral", (void (dolfin::Form::*)(std::shared_ptr<const dolfin::VectorizedCellIntegral>))
+           &dolfin::Form::set_vectorized_cell_integral)
+      .def("set_vectorized_cell_integral", (void (dolfin::Form::*)(std::size_t, std::shared_ptr<const dolfin::VectorizedCellIntegral>))
+           &dolfin::Form::set_vectorized_cell_integral)
       .def("rank", &dolfin::Form::rank)
       .def("mesh", &dolfin::Form::mesh);
 
+    // dolfin::VectorizedCellIntegral
+    py::class_<dolfin::VectorizedCellIntegral, std::shared_ptr<dolfin::VectorizedCellIntegral>>
+      (m, "VectorizedCellIntegral", "Cell integral kernel that evaluates several cells at once")
+      .def("num_lanes", &dolfin::VectorizedCellIntegral::num_lanes);
+
     // dolfin::MultiMeshForm
     py::class_<dolfin::MultiMeshForm, std::shared_ptr<dolfin::MultiMeshForm>>
       (m, "MultiMeshForm", "DOLFIN MultiForm object")
@@ -270,6 +270,26 @@ namespace dolfin_wrappers
             self.eval(_values, x);
             return values;
           })
+      .def("eval_points", [](const dolfin::Function& self,
+                             py::array_t<double, py::array::c_style | py::array::forcecast> x)
+           {
+             std::vector<double> _x(x.data(), x.data() + x.size());
+             std::vector<double> values;
+             self.eval_points(values, _x);
+             const std::size_t value_size = self.value_size();
+             return py::array_t<double>({values.size()/value_size, value_size},
+                                        values.data());
+           }, "Evaluate function at a list of points")
+      .def("eval_points_collective", [](const dolfin::Function& self,
+                                        py::array_t<double, py::array::c_style | py::array::forcecast> x)
+           {
+             std::vector<double> _x(x.data(), x.data() + x.size());
+             std::vector<double> values;
+             self.eval_points_collective(values, _x);
+             const std::size_t value_size = self.value_size();
+             return py::array_t<double>({values.size()/value_size, value_size},
+                                        values.data());
+           }, "Evaluate function at a list of points given on any process (collective)")
       .def("extrapolate", &dolfin::Function::extrapolate)
       .def("extrapolate", [](dolfin::Function& instance, const py::object v)
            {
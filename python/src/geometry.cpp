@@ -48,6 +48,7 @@ namespace dolfin_wrappers
            &dolfin::BoundingBoxTree::build)
       .def("build", (void (dolfin::BoundingBoxTree::*)(const std::vector<dolfin::Point>&, std::size_t))
            &dolfin::BoundingBoxTree::build)
+      .def("refit", &dolfin::BoundingBoxTree::refit, py::arg("max_quality_ratio")=2.0)
       .def("compute_collisions", (std::vector<unsigned int> (dolfin::BoundingBoxTree::*)(const dolfin::Point&) const)
            &dolfin::BoundingBoxTree::compute_collisions)
       .def("compute_collisions",
@@ -62,7 +63,51 @@ namespace dolfin_wrappers
 	   &dolfin::BoundingBoxTree::compute_entity_collisions)
       .def("compute_first_collision", &dolfin::BoundingBoxTree::compute_first_collision)
       .def("compute_first_entity_collision", &dolfin::BoundingBoxTree::compute_first_entity_collision)
-      .def("compute_closest_entity", &dolfin::BoundingBoxTree::compute_closest_entity);
+      .def("compute_first_entity_collisions",
+           [](const dolfin::BoundingBoxTree& self,
+              py::array_t<double, py::array::c_style | py::array::forcecast> x)
+           {
+             std::vector<double> _x(x.data(), x.data() + x.size());
+             return self.compute_first_entity_collisions(_x);
+           })
+      .def("locate_cell", &dolfin::BoundingBoxTree::locate_cell,
+           py::arg("point"), py::arg("hint"))
+      .def("locate_cells",
+           [](const dolfin::BoundingBoxTree& self,
+              py::array_t<double, py::array::c_style | py::array::forcecast> x,
+              std::vector<unsigned int> hints)
+           {
+             std::vector<double> _x(x.data(), x.data() + x.size());
+             return self.locate_cells(_x, hints);
+           }, py::arg("x"), py::arg("hints"))
+      .def("locate_cells",
+           [](const dolfin::BoundingBoxTree& self,
+              py::array_t<double, py::array::c_style | py::array::forcecast> x)
+           {
+             std::vector<double> _x(x.data(), x.data() + x.size());
+             return self.locate_cells(_x);
+           }, py::arg("x"))
+      .def("compute_closest_entity", &dolfin::BoundingBoxTree::compute_closest_entity)
+      .def("compute_closest_entities",
+           [](const dolfin::BoundingBoxTree& self,
+              py::array_t<double, py::array::c_style | py::array::forcecast> x,
+              std::size_t k)
+           {
+             std::vector<double> _x(x.data(), x.data() + x.size());
+             auto closest = self.compute_closest_entities(_x, k);
+             const std::size_t n = k > 0 ? closest.first.size()/k : 0;
+             py::array_t<unsigned int> entities({n, k}, closest.first.data());
+             py::array_t<double> distances({n, k}, closest.second.data());
+             return std::make_pair(entities, distances);
+           }, py::arg("x"), py::arg("k"))
+      .def("compute_entities_within_radius",
+           [](const dolfin::BoundingBoxTree& self,
+              py::array_t<double, py::array::c_style | py::array::forcecast> x,
+              double radius)
+           {
+             std::vector<double> _x(x.data(), x.data() + x.size());
+             return self.compute_entities_within_radius(_x, radius);
+           }, py::arg("x"), py::arg("radius"));
 
     // dolfin::Point
     py::class_<dolfin::Point>(m, "Point")
@@ -150,7 +195,11 @@ namespace dolfin_wrappers
       .def_static("collides_triangle_triangle_2d",
 		  &dolfin::CollisionPredicates::collides_triangle_triangle_2d)
       .def_static("collides_segment_segment_2d",
-		  &dolfin::CollisionPredicates::collides_segment_segment_2d);
+		  &dolfin::CollisionPredicates::collides_segment_segment_2d)
+      .def_static("collides",
+		  (std::vector<bool> (*)(const dolfin::Mesh&, const std::vector<unsigned int>&,
+					 const dolfin::Mesh&, const std::vector<unsigned int>&))
+		  &dolfin::CollisionPredicates::collides);
 
     py::class_<dolfin::IntersectionConstruction>(m, "IntersectionConstruction")
       .def_static("intersection_triangle_triangle_2d",
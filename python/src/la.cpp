@@ -864,7 +864,30 @@ namespace dolfin_wrappers
       .def("set_options_prefix", &dolfin::PETScMatrix::set_options_prefix)
       .def("set_nullspace", &dolfin::PETScMatrix::set_nullspace)
       .def("set_near_nullspace", &dolfin::PETScMatrix::set_near_nullspace)
-      .def("setrow", &dolfin::PETScMatrix::setrow);
+      .def("setrow", &dolfin::PETScMatrix::setrow)
+      .def("compute_value_offsets", [](const dolfin::PETScMatrix& self,
+                                       const std::vector<dolfin::la_index>& rows,
+                                       const std::vector<dolfin::la_index>& cols)
+           {
+             std::vector<std::int64_t> offsets;
+             self.compute_value_offsets(offsets, rows.size(), rows.data(),
+                                        cols.size(), cols.data());
+             return py::array_t<std::int64_t>(offsets.size(), offsets.data());
+           })
+      .def("begin_direct_insertion", &dolfin::PETScMatrix::begin_direct_insertion)
+      .def("add_local_direct", [](dolfin::PETScMatrix& self,
+                                  const std::vector<double>& block,
+                                  const std::vector<dolfin::la_index>& rows,
+                                  const std::vector<dolfin::la_index>& cols,
+                                  const std::vector<std::int64_t>& offsets)
+           {
+             if (block.size() != rows.size()*cols.size()
+                 || offsets.size() != block.size())
+               throw py::value_error("Block, indices and offsets do not match");
+             self.add_local_direct(block.data(), rows.size(), rows.data(),
+                                   cols.size(), cols.data(), offsets.data());
+           })
+      .def("end_direct_insertion", &dolfin::PETScMatrix::end_direct_insertion);
 
     // dolfin::PETScNestMatrix
     py::class_<dolfin::PETScNestMatrix, std::shared_ptr<dolfin::PETScNestMatrix>,
@@ -42,6 +42,7 @@
 #include <dolfin/mesh/MeshEntityIterator.h>
 #include <dolfin/mesh/MeshFunction.h>
 #include <dolfin/mesh/MeshPartitioning.h>
+#include <dolfin/mesh/MeshRenumbering.h>
 #include <dolfin/mesh/MeshValueCollection.h>
 #include <dolfin/mesh/MeshQuality.h>
 #include <dolfin/mesh/SubDomain.h>
@@ -128,6 +129,17 @@ namespace dolfin_wrappers
       .def("global_indices", [](const dolfin::MeshTopology& self, int dim)
            { auto& indices = self.global_indices(dim); return py::array_t<std::int64_t>(indices.size(), indices.data()); })
       .def("have_shared_entities", &dolfin::MeshTopology::have_shared_entities)
+      .def("set_transient", &dolfin::MeshTopology::set_transient)
+      .def("transient", &dolfin::MeshTopology::transient)
+      .def("set_memory_budget", &dolfin::MeshTopology::set_memory_budget)
+      .def("memory_budget", &dolfin::MeshTopology::memory_budget)
+      .def("evict", (std::size_t (dolfin::MeshTopology::*)()) &dolfin::MeshTopology::evict)
+      .def("evict", (std::size_t (dolfin::MeshTopology::*)(std::size_t)) &dolfin::MeshTopology::evict,
+           py::arg("budget"))
+      .def("memory_usage", (std::size_t (dolfin::MeshTopology::*)(std::size_t, std::size_t) const)
+           &dolfin::MeshTopology::memory_usage)
+      .def("memory_usage", (std::size_t (dolfin::MeshTopology::*)() const)
+           &dolfin::MeshTopology::memory_usage)
       .def("shared_entities",
            (std::map<std::int32_t, std::set<unsigned int> >&(dolfin::MeshTopology::*)(unsigned int))
            &dolfin::MeshTopology::shared_entities)
@@ -177,6 +189,8 @@ namespace dolfin_wrappers
       .def("init", (void (dolfin::Mesh::*)() const) &dolfin::Mesh::init)
       .def("init", (std::size_t (dolfin::Mesh::*)(std::size_t) const) &dolfin::Mesh::init)
       .def("init", (void (dolfin::Mesh::*)(std::size_t, std::size_t) const) &dolfin::Mesh::init)
+      .def("init_transient", &dolfin::Mesh::init_transient)
+      .def("reorder", &dolfin::Mesh::reorder, py::arg("method")="hilbert")
       .def("init_cell_orientations", &dolfin::Mesh::init_cell_orientations)
       .def("init_cell_orientations", [](dolfin::Mesh& self, py::object o)
            {
@@ -250,13 +264,23 @@ namespace dolfin_wrappers
       (m, "MeshConnectivity", "DOLFIN MeshConnectivity object")
       .def("__call__", [](const dolfin::MeshConnectivity& self, std::size_t i)
            {
-             return Eigen::Map<const Eigen::Matrix<unsigned int, Eigen::Dynamic, 1>>(self(i), self.size(i));
-           }, py::return_value_policy::reference_internal)
+             // Copy, since compressed connections are decoded into a
+             // temporary buffer
+             std::vector<unsigned int> buffer;
+             return Eigen::Matrix<unsigned int, Eigen::Dynamic, 1>
+               (Eigen::Map<const Eigen::Matrix<unsigned int, Eigen::Dynamic, 1>>
+                (self(i, buffer), self.size(i)));
+           })
       .def("__call__", (const std::vector<unsigned int>& (dolfin::MeshConnectivity::*)() const)&dolfin::MeshConnectivity::operator(), py::return_value_policy::reference_internal)
       .def("size", (std::size_t (dolfin::MeshConnectivity::*)() const)
            &dolfin::MeshConnectivity::size)
       .def("size", (std::size_t (dolfin::MeshConnectivity::*)(std::size_t) const)
-           &dolfin::MeshConnectivity::size);
+           &dolfin::MeshConnectivity::size)
+      .def("empty", &dolfin::MeshConnectivity::empty)
+      .def("compress", &dolfin::MeshConnectivity::compress)
+      .def("decompress", &dolfin::MeshConnectivity::decompress)
+      .def("compressed", &dolfin::MeshConnectivity::compressed)
+      .def("memory_usage", &dolfin::MeshConnectivity::memory_usage);
 
     // dolfin::MeshEntity class
     py::class_<dolfin::MeshEntity, std::shared_ptr<dolfin::MeshEntity>>
@@ -273,8 +297,11 @@ namespace dolfin_wrappers
            "Global number of incident entities of given dimension")
       .def("entities", [](dolfin::MeshEntity& self, std::size_t dim)
            {
-             return Eigen::Map<const Eigen::Matrix<unsigned int, Eigen::Dynamic, 1>>
-               (self.entities(dim), self.num_entities(dim));
+             // Copy, since compressed connections are decoded into
+             // storage of the entity
+             return Eigen::Matrix<unsigned int, Eigen::Dynamic, 1>
+               (Eigen::Map<const Eigen::Matrix<unsigned int, Eigen::Dynamic, 1>>
+                (self.entities(dim), self.num_entities(dim)));
            })
       .def("midpoint", &dolfin::MeshEntity::midpoint, "Midpoint of Entity")
       .def("sharing_processes", &dolfin::MeshEntity::sharing_processes)
@@ -573,6 +600,18 @@ namespace dolfin_wrappers
     py::class_<dolfin::MeshPartitioning>(m, "MeshPartitioning")
       .def_static("build_distributed_mesh", (void (*)(dolfin::Mesh&)) &dolfin::MeshPartitioning::build_distributed_mesh);
 
+    // dolfin::MeshRenumbering
+    typedef std::pair<std::vector<std::size_t>, std::vector<std::size_t>>
+      reorder_maps;
+    py::class_<dolfin::MeshRenumbering>(m, "MeshRenumbering")
+      .def_static("reorder", (reorder_maps (*)(dolfin::Mesh&, std::string))
+                  &dolfin::MeshRenumbering::reorder,
+                  py::arg("mesh"), py::arg("method")="hilbert")
+      .def_static("reorder", &dolfin::MeshRenumbering::reorder<bool>)
+      .def_static("reorder", &dolfin::MeshRenumbering::reorder<int>)
+      .def_static("reorder", &dolfin::MeshRenumbering::reorder<double>)
+      .def_static("reorder", &dolfin::MeshRenumbering::reorder<std::size_t>);
+
     // dolfin::MeshTransformation
     py::class_<dolfin::MeshTransformation>(m, "MeshTransformation")
       .def_static("translate", &dolfin::MeshTransformation::translate)
@@ -587,6 +626,7 @@ namespace dolfin_wrappers
       .def(py::init<>())
       .def("add", &dolfin::MultiMesh::add)
       .def("build", &dolfin::MultiMesh::build, py::arg("quadrature_order") = 2)
+      .def("rebuild", &dolfin::MultiMesh::rebuild, py::arg("moved_parts"))
       .def("num_parts", &dolfin::MultiMesh::num_parts)
       .def("compute_volume", &dolfin::MultiMesh::compute_volume)
       .def("part", &dolfin::MultiMesh::part)
@@ -25,8 +25,10 @@ import pytest
 import os
 import numpy
 from dolfin import *
+import dolfin.cpp as cpp
 
-from dolfin_utils.test import skip_in_parallel, filedir, pushpop_parameters
+from dolfin_utils.test import skip_in_parallel, skip_in_serial, \
+    skip_if_not_PETSc, filedir, pushpop_parameters
 
 
 def test_cell_size_assembly_1D():
@@ -451,3 +453,393 @@ def test_ways_to_pass_mesh_to_assembler():
 
     # Geometric quantities without mesh in domain:
     assert round(0.0 - assemble(n2[0]*ds(mesh)), 7) == 0
+
+
+@pytest.mark.parametrize('backend', ["Eigen", "PETSc"])
+def test_threaded_assembly(backend, pushpop_parameters):
+    if not has_linear_algebra_backend(backend):
+        pytest.skip("Backend %s not available" % backend)
+    if backend == "Eigen" and MPI.size(MPI.comm_world) > 1:
+        pytest.skip("Eigen backend is serial only")
+    parameters["linear_algebra_backend"] = backend
+
+    mesh = UnitCubeMesh(6, 6, 6)
+    V = VectorFunctionSpace(mesh, "Lagrange", 2)
+    u, v = TrialFunction(V), TestFunction(V)
+    f = Expression(("x[0]", "x[1]", "x[2]"), degree=1)
+    a = inner(grad(u), grad(v))*dx + inner(u, v)*ds
+    L = inner(f, v)*dx
+    M = inner(f, f)*dx
+
+    # Reference values from serial assembly
+    A_ref = assemble(a).norm("frobenius")
+    b_ref = assemble(L).norm("l2")
+    m_ref = assemble(M)
+
+    parameters["num_threads"] = 4
+    assert numpy.isclose(assemble(a).norm("frobenius"), A_ref)
+    assert numpy.isclose(assemble(L).norm("l2"), b_ref)
+    assert numpy.isclose(assemble(M), m_ref)
+
+
+@pytest.mark.parametrize('backend', ["Eigen", "PETSc"])
+def test_threaded_assembly_function_coefficient(backend, pushpop_parameters):
+    if not has_linear_algebra_backend(backend):
+        pytest.skip("Backend %s not available" % backend)
+    if backend == "Eigen" and MPI.size(MPI.comm_world) > 1:
+        pytest.skip("Eigen backend is serial only")
+    parameters["linear_algebra_backend"] = backend
+
+    mesh = UnitCubeMesh(6, 6, 6)
+    V = FunctionSpace(mesh, "Lagrange", 2)
+    W = VectorFunctionSpace(mesh, "Lagrange", 1)
+    u, v = TrialFunction(V), TestFunction(V)
+    kappa = interpolate(Expression("1.0 + x[0]*x[1]", degree=2), V)
+    beta = interpolate(Expression(("x[1]", "x[2]", "x[0]"), degree=1), W)
+    f = Expression("sin(x[2])", degree=2)
+    a = kappa*inner(grad(u), grad(v))*dx + inner(beta, grad(u))*v*dx
+    L = kappa*f*v*dx
+    M = kappa*inner(beta, beta)*dx
+
+    # Reference values from serial assembly
+    A_ref = assemble(a).norm("frobenius")
+    b_ref = assemble(L).norm("l2")
+    m_ref = assemble(M)
+
+    parameters["num_threads"] = 4
+    for i in range(3):
+        assert numpy.isclose(assemble(a).norm("frobenius"), A_ref)
+        assert numpy.isclose(assemble(L).norm("l2"), b_ref)
+        assert numpy.isclose(assemble(M), m_ref)
+
+
+def test_threaded_assembly_user_expression(pushpop_parameters):
+    """Threads restricting a Python expression must not deadlock
+    on the GIL"""
+
+    class Kappa(UserExpression):
+        def eval(self, values, x):
+            values[0] = 1.0 + x[0]*x[1]
+
+    mesh = UnitSquareMesh(16, 16)
+    V = FunctionSpace(mesh, "Lagrange", 1)
+    u, v = TrialFunction(V), TestFunction(V)
+    kappa = Kappa(degree=2)
+    a = kappa*inner(grad(u), grad(v))*dx
+    L = kappa*v*dx
+    bc = DirichletBC(V, Constant(0.0), "on_boundary")
+
+    # Reference values from serial assembly
+    A_ref = assemble(a).norm("frobenius")
+    b_ref = assemble(L).norm("l2")
+    As_ref, bs_ref = assemble_system(a, L, bc)
+
+    parameters["num_threads"] = 4
+    assert numpy.isclose(assemble(a).norm("frobenius"), A_ref)
+    assert numpy.isclose(assemble(L).norm("l2"), b_ref)
+    As, bs = assemble_system(a, L, bc)
+    assert numpy.isclose(As.norm("frobenius"), As_ref.norm("frobenius"))
+    assert numpy.isclose(bs.norm("l2"), bs_ref.norm("l2"))
+
+
+@pytest.mark.parametrize('batch_size', [2, 7, 64])
+def test_batched_cell_assembly(batch_size):
+    mesh = UnitSquareMesh(12, 12)
+    V = FunctionSpace(mesh, "Lagrange", 2)
+    u, v = TrialFunction(V), TestFunction(V)
+    f = Function(V)
+    f.interpolate(Expression("x[0]*x[1]", degree=2))
+    cell_markers = MeshFunction("size_t", mesh, mesh.topology().dim(), 0)
+    AutoSubDomain(lambda x: x[0] < 0.5 + DOLFIN_EPS).mark(cell_markers, 1)
+    dx = Measure("dx", domain=mesh, subdomain_data=cell_markers)
+
+    a = f*inner(grad(u), grad(v))*dx(0) + 2.0*u*v*dx(1)
+    L = f*v*dx(0) + v*dx(1)
+    M = f*f*dx
+
+    assembler = cpp.fem.Assembler()
+    assembler.cell_batch_size = batch_size
+
+    A = Matrix()
+    assembler.assemble(A, Form(a))
+    assert numpy.isclose(A.norm("frobenius"), assemble(a).norm("frobenius"))
+
+    b = Vector()
+    assembler.assemble(b, Form(L))
+    assert numpy.isclose(b.norm("l2"), assemble(L).norm("l2"))
+
+    m = Scalar()
+    assembler.assemble(m, Form(M))
+    assert numpy.isclose(m.get_scalar_value(), assemble(M))
+
+
+@pytest.mark.parametrize('batch_size', [1, 6, 64])
+def test_vectorized_cell_assembly(batch_size):
+    # Interleaved kernel for f*u*v*dx with P1 elements on triangles
+    cpp_code = """
+    #include <cmath>
+    #include <pybind11/pybind11.h>
+    #include <dolfin/fem/VectorizedCellIntegral.h>
+
+    class P1WeightedMass : public dolfin::VectorizedCellIntegral
+    {
+    public:
+
+      P1WeightedMass() : calls(0) {}
+
+      std::size_t num_lanes() const { return 4; }
+
+      void tabulate_tensor(double* A, const double* const* w,
+                           const double* x, const int* orientations) const
+      {
+        ++calls;
+        for (std::size_t l = 0; l < 4; ++l)
+        {
+          const double det = (x[8 + l] - x[l])*(x[20 + l] - x[4 + l])
+                           - (x[16 + l] - x[l])*(x[12 + l] - x[4 + l]);
+          const double scale = std::abs(det)/120.0;
+          for (std::size_t i = 0; i < 3; ++i)
+            for (std::size_t j = 0; j < 3; ++j)
+            {
+              double sum = 0.0;
+              for (std::size_t k = 0; k < 3; ++k)
+              {
+                const double m = (i == j && j == k) ? 6.0
+                  : ((i == j || j == k || i == k) ? 2.0 : 1.0);
+                sum += m*w[0][4*k + l];
+              }
+              A[(3*i + j)*4 + l] = scale*sum;
+            }
+        }
+      }
+
+      mutable std::size_t calls;
+    };
+
+    namespace py = pybind11;
+    PYBIND11_MODULE(SIGNATURE, m)
+    {
+      py::class_<P1WeightedMass, std::shared_ptr<P1WeightedMass>,
+                 dolfin::VectorizedCellIntegral>(m, "P1WeightedMass")
+        .def(py::init<>())
+        .def_readonly("calls", &P1WeightedMass::calls);
+    }
+    """
+    module = compile_cpp_code(cpp_code)
+
+    mesh = UnitSquareMesh(5, 5)
+    V = FunctionSpace(mesh, "Lagrange", 1)
+    u, v = TrialFunction(V), TestFunction(V)
+    f = Function(V)
+    f.interpolate(Expression("1.0 + x[0]*x[1]", degree=1))
+    a = f*u*v*dx
+
+    kernel = module.P1WeightedMass()
+    form = Form(a)
+    form.set_vectorized_cell_integral(kernel)
+
+    assembler = cpp.fem.Assembler()
+    assembler.cell_batch_size = batch_size
+    A = Matrix()
+    assembler.assemble(A, form)
+
+    # All complete sets of four cells use the interleaved kernel
+    num_cells = mesh.topology().ghost_offset(mesh.topology().dim())
+    assert kernel.calls == num_cells // 4
+
+    A_ref = assemble(a)
+    A.axpy(-1.0, A_ref, True)
+    assert A.norm("frobenius") < 1.0e-12*A_ref.norm("frobenius")
+
+
+def test_overlapped_cell_assembly():
+    mesh = UnitSquareMesh(12, 12)
+    V = VectorFunctionSpace(mesh, "Lagrange", 2)
+    u, v = TrialFunction(V), TestFunction(V)
+    f = Function(FunctionSpace(mesh, "Lagrange", 1))
+    f.interpolate(Expression("1.0 + x[0]*x[1]", degree=1))
+    cell_markers = MeshFunction("size_t", mesh, mesh.topology().dim(), 0)
+    AutoSubDomain(lambda x: x[0] < 0.5 + DOLFIN_EPS).mark(cell_markers, 1)
+    dx = Measure("dx", domain=mesh, subdomain_data=cell_markers)
+
+    a = f*inner(grad(u), grad(v))*dx(0) + 2.0*inner(u, v)*dx(1) \
+        + inner(u, v)*ds
+    L = f*v[0]*dx(0) + v[1]*dx(1)
+    M = f*f*dx
+
+    assembler = cpp.fem.Assembler()
+    assembler.overlap_communication = True
+
+    A = Matrix()
+    assembler.assemble(A, Form(a))
+    A_ref = assemble(a)
+    A.axpy(-1.0, A_ref, True)
+    assert A.norm("frobenius") < 1.0e-12*A_ref.norm("frobenius")
+
+    b = Vector()
+    assembler.assemble(b, Form(L))
+    b_ref = assemble(L)
+    b.axpy(-1.0, b_ref)
+    assert b.norm("l2") < 1.0e-12*b_ref.norm("l2")
+
+    m = Scalar()
+    assembler.assemble(m, Form(M))
+    assert numpy.isclose(m.get_scalar_value(), assemble(M))
+
+
+@skip_in_serial
+@pytest.mark.parametrize('ghost_mode', ["none", "shared_facet",
+                                        "shared_vertex"])
+def test_overlapped_cell_assembly_parallel(ghost_mode, pushpop_parameters):
+    parameters["ghost_mode"] = ghost_mode
+
+    # Uneven mesh and P2 space, so that processes send contributions
+    # to processes that send nothing back
+    mesh = UnitCubeMesh(7, 3, 2)
+    V = FunctionSpace(mesh, "Lagrange", 2)
+    u, v = TrialFunction(V), TestFunction(V)
+    f = Function(V)
+    f.interpolate(Expression("1.0 + x[0]*x[2]", degree=2))
+    a = f*inner(grad(u), grad(v))*dx + u*v*ds
+    L = f*v*dx
+
+    assembler = cpp.fem.Assembler()
+    assembler.overlap_communication = True
+    for i in range(2):
+        A = Matrix()
+        assembler.assemble(A, Form(a))
+        A_ref = assemble(a)
+        A.axpy(-1.0, A_ref, True)
+        assert A.norm("frobenius") < 1.0e-12*A_ref.norm("frobenius")
+
+        b = Vector()
+        assembler.assemble(b, Form(L))
+        b_ref = assemble(L)
+        b.axpy(-1.0, b_ref)
+        assert b.norm("l2") < 1.0e-12*b_ref.norm("l2")
+
+
+@pytest.mark.parametrize('tensor', [Matrix,
+                                    pytest.param(EigenMatrix,
+                                                 marks=skip_in_parallel)])
+def test_assembly_plan(tensor):
+    mesh = UnitSquareMesh(8, 8)
+    V = FunctionSpace(mesh, "Lagrange", 2)
+    u, v = TrialFunction(V), TestFunction(V)
+    f = Function(V)
+    cell_markers = MeshFunction("size_t", mesh, mesh.topology().dim(), 0)
+    AutoSubDomain(lambda x: x[0] < 0.5 + DOLFIN_EPS).mark(cell_markers, 1)
+    dx = Measure("dx", domain=mesh, subdomain_data=cell_markers)
+
+    a = f*inner(grad(u), grad(v))*dx(0) + 2.0*u*v*dx(1) + f*u*v*ds
+    L = f*v*dx(0) + v*dx(1)
+
+    plan_a, plan_L = AssemblyPlan(a), AssemblyPlan(L)
+    A, b = tensor(), Vector()
+
+    # Re-assemble with changing coefficient
+    for expr in ["x[0]*x[1]", "1.0 + x[0]"]:
+        f.interpolate(Expression(expr, degree=2))
+        plan_a.assemble(A)
+        plan_L.assemble(b)
+        assert numpy.isclose(A.norm("frobenius"),
+                             assemble(a).norm("frobenius"))
+        assert numpy.isclose(b.norm("l2"), assemble(L).norm("l2"))
+
+
+@skip_if_not_PETSc
+def test_petsc_direct_insertion(pushpop_parameters):
+    parameters["linear_algebra_backend"] = "PETSc"
+    mesh = UnitSquareMesh(6, 6)
+    V = FunctionSpace(mesh, "Lagrange", 2)
+    u, v = TrialFunction(V), TestFunction(V)
+    f = interpolate(Expression("1.0 + x[0]*x[1]", degree=2), V)
+    a = f*inner(grad(u), grad(v))*dx + u*v*dx
+
+    # Reference matrix (inserted with MatSetValues)
+    A_ref = as_backend_type(assemble(a))
+
+    # Positions of the cell tensor entries in the local value arrays
+    # (negative for rows owned by another process)
+    A = as_backend_type(assemble(a))
+    A.zero()
+    cell_data = []
+    num_off_process = 0
+    for c in cells(mesh):
+        dofs = V.dofmap().cell_dofs(c.index())
+        offsets = A.compute_value_offsets(dofs, dofs)
+        assert len(offsets) == len(dofs)**2
+        num_off_process += numpy.count_nonzero(offsets < 0)
+        cell_data.append((assemble_local(a, c).flatten(), dofs, offsets))
+    if MPI.size(mesh.mpi_comm()) > 1:
+        assert MPI.sum(mesh.mpi_comm(), num_off_process) > 0
+    else:
+        assert num_off_process == 0
+
+    # Insert cell tensors directly
+    A.begin_direct_insertion()
+    for values, dofs, offsets in cell_data:
+        A.add_local_direct(values, dofs, dofs, offsets)
+    A.end_direct_insertion()
+    A.apply("add")
+
+    # Compare entries of all owned rows
+    for row in range(*A.local_range(0)):
+        cols, values = A.getrow(row)
+        cols_ref, values_ref = A_ref.getrow(row)
+        assert numpy.array_equal(cols, cols_ref)
+        assert numpy.allclose(values, values_ref, rtol=1.0e-12, atol=1.0e-14)
+
+
+def test_incremental_assembly():
+    mesh = UnitSquareMesh(8, 8)
+    V = FunctionSpace(mesh, "Lagrange", 2)
+    u, v = TrialFunction(V), TestFunction(V)
+    f = Function(FunctionSpace(mesh, "DG", 0))
+    f.vector()[:] = 1.0
+    cell_markers = MeshFunction("size_t", mesh, mesh.topology().dim(), 0)
+    AutoSubDomain(lambda x: x[0] < 0.5 + DOLFIN_EPS).mark(cell_markers, 1)
+    dx = Measure("dx", domain=mesh, subdomain_data=cell_markers)
+
+    a = f*inner(grad(u), grad(v))*dx(0) + f*u*v*dx(1) + u*v*ds
+    L = f*v*dx(0) + v*dx(1)
+    M = f*f*dx
+
+    assembler_a = IncrementalAssembler(a)
+    assembler_L = IncrementalAssembler(L)
+    assembler_M = IncrementalAssembler(M)
+    A, b, m = Matrix(), Vector(), Scalar()
+    assembler_a.assemble(A)
+    assembler_L.assemble(b)
+    assembler_M.assemble(m)
+
+    def check():
+        A_ref, b_ref = assemble(a), assemble(L)
+        A_ref.axpy(-1.0, A, True)
+        b_ref.axpy(-1.0, b)
+        assert A_ref.norm("frobenius") < 1.0e-12*A.norm("frobenius")
+        assert b_ref.norm("l2") < 1.0e-12*b.norm("l2")
+        assert numpy.isclose(m.get_scalar_value(), assemble(M))
+
+    check()
+
+    # Change coefficient on cells near x = 0 and update with a mesh
+    # function
+    dirty = MeshFunction("bool", mesh, mesh.topology().dim(), False)
+    for c in cells(mesh):
+        dirty[c] = c.midpoint().x() < 0.25
+    f.interpolate(Expression("x[0] < 0.25 ? 2.0 : 1.0", degree=0))
+    for assembler, tensor in [(assembler_a, A), (assembler_L, b),
+                              (assembler_M, m)]:
+        assembler.update(tensor, dirty)
+    check()
+
+    # Change coefficient on cells near x = 1 and update with a list
+    # of cells
+    dirty_cells = [c.index() for c in cells(mesh) if c.midpoint().x() > 0.75]
+    f.interpolate(Expression("x[0] < 0.25 ? 2.0 : (x[0] > 0.75 ? 3.0 : 1.0)",
+                             degree=0))
+    for assembler, tensor in [(assembler_a, A), (assembler_L, b),
+                              (assembler_M, m)]:
+        assembler.update(tensor, dirty_cells)
+    check()
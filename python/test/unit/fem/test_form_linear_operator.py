@@ -0,0 +1,78 @@
+"""Unit tests for FormLinearOperator"""
+
+# Copyright (C) 2026 agent
+#
+# This file is part of DOLFIN.
+#
+# DOLFIN is free software: you can redistribute it and/or modify
+# it under the terms of the GNU Lesser General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# DOLFIN is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+# GNU Lesser General Public License for more details.
+#
+# You should have received a copy of the GNU Lesser General Public License
+# along with DOLFIN. If not, see <http://www.gnu.org/licenses/>.
+
+import pytest
+from dolfin import *
+from dolfin_utils.test import skip_if_not_PETSc
+
+
+@skip_if_not_PETSc
+@pytest.mark.parametrize('cache', [False, True])
+def test_action(cache):
+    mesh = UnitSquareMesh(MPI.comm_world, 8, 8)
+    V = FunctionSpace(mesh, "Lagrange", 2)
+    u, v = TrialFunction(V), TestFunction(V)
+    k = Expression("1.0 + x[0]*x[1]", degree=2)
+    a = k*inner(grad(u), grad(v))*dx + u*v*ds
+
+    # Reference product with assembled matrix
+    A = assemble(a)
+    x = Function(V)
+    x.interpolate(Expression("sin(x[0])*x[1]", degree=2))
+    y_ref = A*x.vector()
+
+    O = FormLinearOperator(a)
+    O.cache_element_tensors = cache
+    assert O.size(0) == V.dim()
+    assert O.size(1) == V.dim()
+
+    # Apply twice to exercise the element tensor cache
+    y = Function(V).vector()
+    for i in range(2):
+        O.mult(x.vector(), y)
+        y -= y_ref
+        assert y.norm("l2") < 1.0e-12*y_ref.norm("l2")
+
+
+@skip_if_not_PETSc
+def test_krylov_solve():
+    mesh = UnitSquareMesh(MPI.comm_world, 8, 8)
+    V = FunctionSpace(mesh, "Lagrange", 1)
+    u, v = TrialFunction(V), TestFunction(V)
+    a = inner(grad(u), grad(v))*dx + u*v*dx
+    L = Constant(1.0)*v*dx
+
+    A, b = assemble(a), assemble(L)
+    x_ref = Function(V).vector()
+    solve(A, x_ref, b, "cg", "none")
+
+    O = FormLinearOperator(a)
+    x = Function(V).vector()
+    solve(as_backend_type(O), x, b, "cg", "none")
+
+    x -= x_ref
+    assert x.norm("l2") < 1.0e-6*x_ref.norm("l2")
+
+
+def test_unsupported_form():
+    mesh = UnitSquareMesh(MPI.comm_world, 4, 4)
+    V = FunctionSpace(mesh, "Discontinuous Lagrange", 1)
+    u, v = TrialFunction(V), TestFunction(V)
+    with pytest.raises(RuntimeError):
+        FormLinearOperator(jump(u)*jump(v)*dS)
@@ -0,0 +1,67 @@
+"""Unit tests for SumFactorizedOperator"""
+
+# Copyright (C) 2026 agent
+#
+# This file is part of DOLFIN.
+#
+# DOLFIN is free software: you can redistribute it and/or modify
+# it under the terms of the GNU Lesser General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# DOLFIN is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+# GNU Lesser General Public License for more details.
+#
+# You should have received a copy of the GNU Lesser General Public License
+# along with DOLFIN. If not, see <http://www.gnu.org/licenses/>.
+
+import pytest
+from dolfin import *
+
+
+def quadrilateral_mesh():
+    return UnitSquareMesh.create(MPI.comm_world, [4, 3],
+                                 CellType.Type.quadrilateral)
+
+
+def hexahedral_mesh():
+    return UnitCubeMesh.create(MPI.comm_world, [2, 3, 2],
+                               CellType.Type.hexahedron)
+
+
+@pytest.mark.parametrize('mesh_factory', [quadrilateral_mesh, hexahedral_mesh])
+@pytest.mark.parametrize('degree', [1, 2, 3])
+@pytest.mark.parametrize('mass, stiffness', [(1.0, 0.0), (0.0, 1.0),
+                                             (0.5, 2.0)])
+def test_action(mesh_factory, degree, mass, stiffness):
+    mesh = mesh_factory()
+    V = FunctionSpace(mesh, "Lagrange", degree)
+    u, v = TrialFunction(V), TestFunction(V)
+    dx_exact = dx(metadata={"quadrature_degree": 2*degree})
+    a = Constant(mass)*u*v*dx_exact \
+        + Constant(stiffness)*inner(grad(u), grad(v))*dx_exact
+
+    # Reference product with assembled matrix
+    A = assemble(a)
+    x = Function(V)
+    x.interpolate(Expression("sin(x[0])*(x[1] + 1.0)", degree=3))
+    y_ref = A*x.vector()
+
+    O = SumFactorizedOperator(V, mass, stiffness)
+    assert O.degree() == degree
+    assert O.size(0) == V.dim()
+    assert O.size(1) == V.dim()
+
+    y = Function(V).vector()
+    O.mult(x.vector(), y)
+    y -= y_ref
+    assert y.norm("l2") < 1.0e-12*y_ref.norm("l2")
+
+
+def test_unsupported_mesh():
+    mesh = UnitSquareMesh(MPI.comm_world, 4, 4)
+    V = FunctionSpace(mesh, "Lagrange", 1)
+    with pytest.raises(RuntimeError):
+        SumFactorizedOperator(V, 1.0, 1.0)
@@ -467,3 +467,78 @@ def test_ghost_mode_handling(pushpop_parameters):
     _check_value(_forms())
     parameters["ghost_mode"] = "shared_facet"
     _check_value(_forms())
+
+
+@pytest.mark.parametrize('backend', ["Eigen", "PETSc"])
+@pytest.mark.parametrize('facet_wise', [False, True])
+def test_threaded_assembly(backend, facet_wise, pushpop_parameters):
+    if not has_linear_algebra_backend(backend):
+        pytest.skip("Backend %s not available" % backend)
+    if backend == "Eigen" and MPI.size(MPI.comm_world) > 1:
+        pytest.skip("Eigen backend is serial only")
+    parameters["linear_algebra_backend"] = backend
+    parameters["ghost_mode"] = "shared_facet"
+
+    mesh = UnitSquareMesh(16, 16)
+    V = FunctionSpace(mesh, "Lagrange", 2)
+    u, v = TrialFunction(V), TestFunction(V)
+    f = Expression("x[0]*x[1]", degree=2)
+    a = inner(grad(u), grad(v))*dx + u*v*ds
+    L = f*v*dx
+    if facet_wise:
+        a += avg(u)*avg(v)*dS
+    bc = DirichletBC(V, Constant(1.0), "x[0] < DOLFIN_EPS")
+
+    def assemble_threaded(num_threads):
+        parameters["num_threads"] = num_threads
+        return assemble_system(a, L, bc)
+
+    # Compare with serial assembly
+    A_ref, b_ref = assemble_threaded(0)
+    A, b = assemble_threaded(3)
+    assert numpy.isclose(A.norm("frobenius"), A_ref.norm("frobenius"))
+    assert numpy.isclose(b.norm("l2"), b_ref.norm("l2"))
+
+    # Threaded assembly does not depend on the number of threads
+    A1, b1 = assemble_threaded(1)
+    assert numpy.array_equal(b.get_local(), b1.get_local())
+    A1.axpy(-1.0, A, True)
+    assert A1.norm("frobenius") == 0.0
+
+
+@pytest.mark.parametrize('backend', ["Eigen", "PETSc"])
+@pytest.mark.parametrize('facet_wise', [False, True])
+def test_threaded_assembly_function_coefficient(backend, facet_wise,
+                                                pushpop_parameters):
+    if not has_linear_algebra_backend(backend):
+        pytest.skip("Backend %s not available" % backend)
+    if backend == "Eigen" and MPI.size(MPI.comm_world) > 1:
+        pytest.skip("Eigen backend is serial only")
+    parameters["linear_algebra_backend"] = backend
+    parameters["ghost_mode"] = "shared_facet"
+
+    mesh = UnitSquareMesh(16, 16)
+    V = FunctionSpace(mesh, "Lagrange", 2)
+    u, v = TrialFunction(V), TestFunction(V)
+
+    # Function coefficients are restricted from the shared vector
+    k = interpolate(Expression("1.0 + x[0]*x[1]", degree=2), V)
+    f = interpolate(Expression("sin(x[0])", degree=2), V)
+    a = k*inner(grad(u), grad(v))*dx + k*u*v*ds
+    L = f*k*v*dx + f*v*ds
+    if facet_wise:
+        a += avg(k)*avg(u)*avg(v)*dS
+        L += avg(f)*avg(v)*dS
+    bc = DirichletBC(V, Constant(1.0), "x[0] < DOLFIN_EPS")
+
+    def assemble_threaded(num_threads):
+        parameters["num_threads"] = num_threads
+        return assemble_system(a, L, bc)
+
+    # Compare with serial assembly
+    A_ref, b_ref = assemble_threaded(0)
+    A, b = assemble_threaded(4)
+    A.axpy(-1.0, A_ref, True)
+    b.axpy(-1.0, b_ref)
+    assert A.norm("frobenius") < 1.0e-12*A_ref.norm("frobenius")
+    assert b.norm("l2") < 1.0e-12*b_ref.norm("l2")
@@ -269,6 +269,63 @@ def test_call(R, V, W, mesh):
     with pytest.raises(TypeError):
         u0([0, 0])
 
+def test_eval_points(V, W, mesh):
+    import numpy
+    u1 = Function(V)
+    u2 = Function(W)
+    u1.interpolate(Expression("x[0] + 2.0*x[1] - x[2]", degree=1))
+    u2.interpolate(Expression(("x[0]", "x[1]*x[2]", "1.0"), degree=2))
+
+    # Points along a line (consecutive points share cells) and
+    # scattered points, restricted to the local part of the mesh
+    numpy.random.seed(3)
+    line = numpy.outer(numpy.linspace(0.0, 1.0, 50), [1.0, 0.5, 0.25])
+    scattered = numpy.random.uniform(0.0, 1.0, (50, 3))
+    tree = mesh.bounding_box_tree()
+    not_found = numpy.iinfo(numpy.uint32).max
+    x = numpy.array([p for p in numpy.vstack((line, scattered))
+                     if tree.compute_first_entity_collision(Point(*p))
+                     != not_found])
+
+    values1 = u1.eval_points(x)
+    values2 = u2.eval_points(x)
+    assert values1.shape == (x.shape[0], 1)
+    assert values2.shape == (x.shape[0], 3)
+    for i, p in enumerate(x):
+        assert numpy.isclose(values1[i, 0], u1(p))
+        assert numpy.allclose(values2[i], u2(p))
+
+
+def test_eval_points_collective(V, W, mesh):
+    import numpy
+    u1 = Function(V)
+    u2 = Function(W)
+    u1.interpolate(Expression("x[0] + 2.0*x[1] - x[2]", degree=1))
+    u2.interpolate(Expression(("x[0]", "2.0*x[1]", "1.0"), degree=1))
+
+    # Different points on each process, including points on mesh
+    # vertices and facets (which may lie on partition boundaries)
+    numpy.random.seed(MPI.rank(mesh.mpi_comm()))
+    x = numpy.vstack((numpy.random.uniform(0.0, 1.0, (20, 3)),
+                      [[0.5, 0.5, 0.5], [0.25, 0.5, 0.125],
+                       [1.0, 1.0, 1.0], [0.0, 0.3, 0.7]]))
+
+    values1 = u1.eval_points_collective(x)
+    values2 = u2.eval_points_collective(x)
+    assert values1.shape == (x.shape[0], 1)
+    assert values2.shape == (x.shape[0], 3)
+    assert numpy.allclose(values1[:, 0], x[:, 0] + 2.0*x[:, 1] - x[:, 2])
+    assert numpy.allclose(values2[:, 0], x[:, 0])
+    assert numpy.allclose(values2[:, 1], 2.0*x[:, 1])
+    assert numpy.allclose(values2[:, 2], 1.0)
+
+    # No points on some processes
+    if MPI.rank(mesh.mpi_comm()) > 0:
+        x = numpy.zeros((0, 3))
+    values1 = u1.eval_points_collective(x)
+    assert values1.shape == (x.shape[0], 1)
+
+
 def test_constant_float_conversion():
     c = Constant(3.45)
     assert float(c) == 3.45
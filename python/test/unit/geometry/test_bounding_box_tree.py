@@ -24,8 +24,8 @@ from dolfin import BoundingBoxTree
 from dolfin import UnitIntervalMesh, UnitSquareMesh, UnitCubeMesh
 from dolfin import Point
 from dolfin import MeshEntity
-from dolfin import MPI
-from dolfin_utils.test import skip_in_parallel
+from dolfin import MPI, cells, parameters
+from dolfin_utils.test import skip_in_parallel, pushpop_parameters
 
 
 #--- compute_collisions with point ---
@@ -423,6 +423,118 @@ def test_compute_first_entity_collision_3d():
     first = tree.compute_first_entity_collision(p)
     assert first in reference
 
+#--- compute_first_entity_collisions with list of points ---
+
+@pytest.mark.parametrize('mesh', [UnitIntervalMesh(MPI.comm_world, 16),
+                                  UnitSquareMesh(MPI.comm_world, 8, 8),
+                                  UnitCubeMesh(MPI.comm_world, 4, 4, 4)])
+def test_compute_first_entity_collisions(mesh):
+
+    gdim = mesh.geometry().dim()
+    numpy.random.seed(42)
+    x = numpy.random.uniform(-0.2, 1.2, (101, gdim))
+
+    tree = mesh.bounding_box_tree()
+    entities = tree.compute_first_entity_collisions(x)
+    assert len(entities) == x.shape[0]
+    for i in range(x.shape[0]):
+        first = tree.compute_first_entity_collision(Point(*x[i]))
+        assert entities[i] == first
+
+#--- locate cells by walking from hint cells ---
+
+@pytest.mark.parametrize('mesh', [UnitIntervalMesh(MPI.comm_world, 16),
+                                  UnitSquareMesh(MPI.comm_world, 8, 8),
+                                  UnitCubeMesh(MPI.comm_world, 4, 4, 4)])
+def test_locate_cells(mesh):
+
+    gdim = mesh.geometry().dim()
+    numpy.random.seed(5)
+    x = numpy.random.uniform(-0.2, 1.2, (101, gdim))
+    hints = numpy.random.randint(0, mesh.num_cells(), x.shape[0])
+    hints[:5] = numpy.iinfo(numpy.uint32).max
+
+    tree = mesh.bounding_box_tree()
+    located = tree.locate_cells(x, hints)
+    assert len(located) == x.shape[0]
+    for i in range(x.shape[0]):
+        p = Point(*x[i])
+        assert tree.locate_cell(p, int(hints[i])) == located[i]
+        first = tree.compute_first_entity_collision(p)
+        if first == numpy.iinfo(numpy.uint32).max:
+            assert located[i] == first
+        else:
+            assert MeshEntity(mesh, mesh.topology().dim(), located[i]).collides(p)
+
+    # Walk from the cell of the previous point
+    located = tree.locate_cells(x)
+    assert len(located) == x.shape[0]
+    for i in range(x.shape[0]):
+        p = Point(*x[i])
+        first = tree.compute_first_entity_collision(p)
+        if first == numpy.iinfo(numpy.uint32).max:
+            assert located[i] == first
+        else:
+            assert MeshEntity(mesh, mesh.topology().dim(), located[i]).collides(p)
+
+#--- tree construction with different split strategies ---
+
+@pytest.mark.parametrize('split', ["median", "sah", "morton"])
+@pytest.mark.parametrize('num_threads', [1, 4])
+def test_build_split(split, num_threads, pushpop_parameters):
+
+    # Large enough for subtrees to be built as tasks (more than 4096
+    # leaves) on each process
+    mesh = UnitCubeMesh(MPI.comm_world, 16, 16, 16*MPI.size(MPI.comm_world))
+
+    # Reference tree: serial median split
+    reference_tree = BoundingBoxTree()
+    reference_tree.build(mesh)
+
+    parameters["bounding_box_tree_split"] = split
+    parameters["num_threads"] = num_threads
+    tree = BoundingBoxTree()
+    tree.build(mesh)
+
+    numpy.random.seed(1)
+    for x in numpy.random.uniform(-0.1, 1.1, (50, 3)):
+        p = Point(*x)
+        reference = sorted(reference_tree.compute_entity_collisions(p))
+        assert sorted(tree.compute_entity_collisions(p)) == reference
+        tdim = mesh.topology().dim()
+        assert all(MeshEntity(mesh, tdim, c).collides(p) for c in reference)
+        first = tree.compute_first_entity_collision(p)
+        if reference:
+            assert first in reference
+        else:
+            assert first == numpy.iinfo(numpy.uint32).max
+
+#--- refit after moving mesh ---
+
+def test_refit():
+
+    mesh = UnitSquareMesh(MPI.comm_world, 8, 8)
+    tree = BoundingBoxTree()
+    tree.build(mesh)
+
+    # Stretch and shear mesh, keeping the topology
+    x = mesh.coordinates()
+    x[:, 0] = 2.0*x[:, 0] + 0.5*x[:, 1]
+    x[:, 1] = 1.0 + x[:, 1]
+    assert not tree.refit()
+
+    numpy.random.seed(2)
+    for x in numpy.random.uniform(-0.1, 2.6, (20, 2)):
+        p = Point(*x)
+        reference = [c.index() for c in cells(mesh) if c.collides(p)]
+        assert sorted(tree.compute_entity_collisions(p)) == reference
+
+    # Force rebuild
+    assert tree.refit(0.5)
+    p = Point(1.0, 1.5)
+    reference = [c.index() for c in cells(mesh) if c.collides(p)]
+    assert sorted(tree.compute_entity_collisions(p)) == reference
+
 #--- compute_closest_entity with point ---
 
 @skip_in_parallel
@@ -481,3 +593,49 @@ def test_compute_closest_entity_3d():
     entity, distance = tree.compute_closest_entity(p)
     assert entity == reference[0]
     assert round(distance - reference[1], 7) == 0
+
+#--- k closest entities and entities within radius ---
+
+@skip_in_parallel
+@pytest.mark.parametrize('gdim', [1, 2, 3])
+def test_compute_closest_entities_point_cloud(gdim):
+
+    numpy.random.seed(3)
+    cloud = numpy.random.uniform(0.0, 1.0, (200, gdim))
+    x = numpy.random.uniform(-0.1, 1.1, (20, gdim))
+
+    tree = BoundingBoxTree()
+    tree.build([Point(*p) for p in cloud], gdim)
+
+    k = 5
+    entities, distances = tree.compute_closest_entities(x, k)
+    assert entities.shape == (x.shape[0], k)
+    within = tree.compute_entities_within_radius(x, 0.2)
+    for i in range(x.shape[0]):
+        d = numpy.linalg.norm(cloud - x[i], axis=1)
+        assert numpy.allclose(distances[i], numpy.sort(d)[:k])
+        assert numpy.allclose(d[entities[i]], distances[i])
+        assert sorted(within[i]) == list(numpy.nonzero(d <= 0.2)[0])
+
+@skip_in_parallel
+def test_compute_closest_entities_cells():
+
+    mesh = UnitSquareMesh(8, 8)
+    tree = mesh.bounding_box_tree()
+
+    numpy.random.seed(4)
+    x = numpy.random.uniform(-0.5, 1.5, (20, 2))
+
+    entities, distances = tree.compute_closest_entities(x, 3)
+    within = tree.compute_entities_within_radius(x, 0.1)
+    for i in range(x.shape[0]):
+        p = Point(*x[i])
+        d = numpy.array([c.distance(p) for c in cells(mesh)])
+        assert numpy.allclose(distances[i], numpy.sort(d)[:3])
+        entity, distance = tree.compute_closest_entity(p)
+        assert round(distances[i][0] - distance, 7) == 0
+        assert sorted(within[i]) == list(numpy.nonzero(d <= 0.1)[0])
+
+    # Fewer entities than requested
+    entities, distances = tree.compute_closest_entities(x[:1], mesh.num_cells() + 2)
+    assert numpy.isinf(distances[0][-1])
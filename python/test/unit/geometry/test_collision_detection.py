@@ -309,3 +309,30 @@ def test_tetrahedron_collides_tetrahedron():
     # touching faces
     assert c3.collides(c43) == True
     assert c43.collides(c3) == True
+
+@skip_in_parallel
+@pytest.mark.parametrize("dim", [2, 3])
+def test_batched_cell_collisions(dim):
+    """Test batched cell-cell collisions against cell by cell checks"""
+    from dolfin.cpp.geometry import CollisionPredicates
+
+    if dim == 2:
+        m0 = UnitSquareMesh(6, 6)
+        m1 = RectangleMesh(Point(0.2, 0.1), Point(0.7, 0.6), 4, 3)
+        m1.rotate(17.0)
+    else:
+        m0 = UnitCubeMesh(3, 3, 3)
+        m1 = UnitCubeMesh(2, 2, 2)
+        m1.scale(0.4)
+        m1.translate(Point(0.3, 0.25, 1.0/3.0))
+
+    # All pairs of cells with colliding bounding boxes (including
+    # pairs sharing vertex coordinates)
+    cells_0, cells_1 = m0.bounding_box_tree().compute_collisions(m1.bounding_box_tree())
+    cells_0 = list(cells_0) + list(range(m0.num_cells()))
+    cells_1 = list(cells_1) + [0]*m0.num_cells()
+
+    collisions = CollisionPredicates.collides(m0, cells_0, m1, cells_1)
+    assert len(collisions) == len(cells_0)
+    for c0, c1, collides in zip(cells_0, cells_1, collisions):
+        assert collides == Cell(m0, c0).collides(Cell(m1, c1))
@@ -18,7 +18,8 @@
 import pytest
 import os
 from dolfin import *
-from dolfin_utils.test import skip_in_parallel, fixture, tempdir
+from dolfin_utils.test import skip_in_parallel, skip_in_serial, fixture, tempdir
+from dolfin_utils.test import pushpop_parameters
 
 
 # Supported XDMF file encoding
@@ -140,6 +141,44 @@ def test_save_and_load_3d_mesh(tempdir, encoding):
     assert mesh.num_entities_global(dim) == mesh2.num_entities_global(dim)
 
 
+@skip_in_serial
+@pytest.mark.parametrize("encoding", encodings)
+def test_load_mesh_chunked(tempdir, encoding, pushpop_parameters):
+    if invalid_config(encoding):
+        pytest.skip("XDMF unsupported in current configuration")
+    filename = os.path.join(tempdir, "mesh_chunked.xdmf")
+    mesh = UnitCubeMesh(6, 6, 6)
+
+    with XDMFFile(mesh.mpi_comm(), filename) as file:
+        file.write(mesh, encoding)
+
+    def read_mesh(chunk_size):
+        parameters["mesh_distribution_chunk_size"] = chunk_size
+        mesh = Mesh()
+        with XDMFFile(MPI.comm_world, filename) as file:
+            file.read(mesh)
+        return mesh
+
+    def cell_data(mesh):
+        tdim = mesh.topology().dim()
+        g = mesh.topology().global_indices(tdim)
+        x = mesh.coordinates()
+        return {int(g[c.index()]): sorted(tuple(x[v]) for v in c.entities(0))
+                for c in cells(mesh)}
+
+    # Distribute cells and vertices all at once and in small rounds
+    mesh0 = read_mesh(0)
+    mesh1 = read_mesh(7)
+
+    dim = mesh.topology().dim()
+    assert mesh1.num_entities_global(0) == mesh.num_entities_global(0)
+    assert mesh1.num_entities_global(dim) == mesh.num_entities_global(dim)
+    assert mesh1.num_vertices() == mesh0.num_vertices()
+    assert cell_data(mesh1) == cell_data(mesh0)
+    volume = sum(c.volume() for c in cells(mesh1))
+    assert round(MPI.sum(mesh1.mpi_comm(), volume) - 1.0, 7) == 0
+
+
 @pytest.mark.parametrize("encoding", encodings)
 def test_save_1d_scalar(tempdir, encoding):
     if invalid_config(encoding):
@@ -133,3 +133,22 @@ def test_ghost_connectivities(gmode, pushpop_parameters):
             cell = Cell(meshG, cidx)
             cell_mp = tuple(cell.midpoint()[:])
             assert cell_mp in reference[facet_mp]
+
+
+@pytest.mark.parametrize('gmode', ['shared_vertex', 'none'])
+def test_threaded_entity_numbering(gmode, pushpop_parameters):
+    parameters['ghost_mode'] = gmode
+
+    # Compute edges and facets on one thread and on four threads
+    connectivity = []
+    for num_threads in [1, 4]:
+        parameters["num_threads"] = num_threads
+        mesh = UnitCubeMesh(MPI.comm_world, 6, 6, 6)
+        mesh.init(1)
+        mesh.init(2)
+        topology = mesh.topology()
+        connectivity.append([(topology.size(d), topology.ghost_offset(d),
+                              list(topology(3, d)()), list(topology(d, 0)()))
+                             for d in [1, 2]])
+
+    assert connectivity[0] == connectivity[1]
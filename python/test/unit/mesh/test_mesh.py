@@ -756,3 +756,169 @@ def test_mesh_connectivity_lifetime():
     assert sys.getrefcount(conn) == rc + 1
     del cells
     assert sys.getrefcount(conn) == rc
+
+
+def test_transient_connectivity():
+    """Check release and recomputation of transient connectivity"""
+    mesh = UnitSquareMesh(4, 4)
+    topology = mesh.topology()
+    mesh.init(0, 2)
+    cells_of_vertex = [topology(0, 2)(v).copy()
+                       for v in range(mesh.num_vertices())]
+
+    # Pinned connectivity is not released
+    usage = topology.memory_usage()
+    assert topology.memory_usage(0, 2) > 0
+    assert topology.evict() == 0
+    assert not topology(0, 2).empty()
+
+    # Transient connectivity is released
+    topology.set_transient(0, 2, True)
+    size = topology.memory_usage(0, 2)
+    assert topology.evict() == size
+    assert topology(0, 2).empty()
+    assert topology.memory_usage() < usage
+    assert not topology(2, 0).empty()
+
+    # Connectivity is recomputed on demand
+    for v in vertices(mesh):
+        assert [c.index() for c in cells(v)] \
+            == list(cells_of_vertex[v.index()])
+    assert topology.transient(0, 2)
+
+    # Cell-vertex connectivity cannot be released
+    with pytest.raises(RuntimeError):
+        topology.set_transient(2, 0, True)
+
+    # Connectivity computed by init_transient is released down to
+    # the memory budget by evict only
+    mesh.init_transient(0, 1)
+    assert topology.transient(0, 1)
+    topology.set_memory_budget(1)
+    mesh.init(2, 2)
+    assert not topology(0, 1).empty()
+    topology.evict()
+    assert topology(0, 1).empty()
+    assert topology(0, 2).empty()
+    assert not topology(2, 2).empty()
+
+    # Clearing connectivity resets the transient mark
+    mesh.init_transient(0, 1)
+    assert topology.transient(0, 1)
+    topology.clear(0, 1)
+    assert not topology.transient(0, 1)
+    mesh.init(0, 1)
+    assert not topology.transient(0, 1)
+
+
+def test_transient_connectivity_nested_iterators():
+    """Check that transient connectivity is not released while an
+    iterator over it is in use"""
+    mesh = UnitCubeMesh(3, 3, 3)
+    tdim = mesh.topology().dim()
+    topology = mesh.topology()
+    topology.set_memory_budget(1)
+    mesh.init_transient(tdim - 1, tdim)
+    facet_cells = [topology(tdim - 1, tdim)(f).copy()
+                   for f in range(mesh.num_facets())]
+
+    # Inner iterators compute new connectivity while the outer
+    # iterator reads the transient facet-cell connectivity
+    for f in facets(mesh):
+        cell_indices = []
+        for c in cells(f):
+            cell_indices.append(c.index())
+            assert len([e for e in edges(c)]) == 6
+        assert cell_indices == list(facet_cells[f.index()])
+    assert not topology(tdim - 1, tdim).empty()
+
+    # Explicit eviction releases the transient connectivity
+    assert topology.evict() > 0
+    assert topology(tdim - 1, tdim).empty()
+    assert not topology(tdim, 1).empty()
+
+
+@pytest.mark.parametrize("method", ["hilbert", "morton", "rcm"])
+def test_reorder(method):
+    """Check that reordering renumbers cells, vertices and
+    connectivity consistently"""
+    mesh = UnitCubeMesh(4, 4, 4)
+    mesh.init(0, 3)
+    mesh.init(2, 3)
+
+    def cell_data(mesh):
+        g = mesh.topology().global_indices(0)
+        x = mesh.coordinates()
+        data = [tuple(sorted((int(g[v]), tuple(x[v])) for v in c.entities(0)))
+                for c in cells(mesh)]
+        return sorted(data)
+
+    def vertex_data(mesh):
+        g = mesh.topology().global_indices(3)
+        return sorted((tuple(v.point().array()),
+                       tuple(sorted(int(g[c.index()]) for c in cells(v))))
+                      for v in vertices(mesh))
+
+    cells0, vertices0 = cell_data(mesh), vertex_data(mesh)
+    facet_cells0 = [sorted(mesh.topology().global_indices(3)[c.index()]
+                           for c in cells(f)) for f in facets(mesh)]
+    volume = sum(c.volume() for c in cells(mesh))
+
+    # Mesh functions holding a geometric quantity of each entity
+    fv = MeshFunction("double", mesh, 0)
+    fv.set_values(mesh.coordinates()[:, 0].copy())
+    fc = MeshFunction("double", mesh, 3)
+    fc.set_values(numpy.array([c.midpoint()[0] for c in cells(mesh)]))
+
+    vertex_map, cell_map = mesh.reorder(method)
+    assert sorted(vertex_map) == list(range(mesh.num_vertices()))
+    assert sorted(cell_map) == list(range(mesh.num_cells()))
+    assert mesh.ordered()
+
+    # Renumbered mesh functions follow their entities
+    MeshRenumbering.reorder(fv, (vertex_map, cell_map))
+    MeshRenumbering.reorder(fc, (vertex_map, cell_map))
+    assert numpy.allclose(fv.array(), mesh.coordinates()[:, 0])
+    assert numpy.allclose(fc.array(),
+                          [c.midpoint()[0] for c in cells(mesh)])
+    assert cell_data(mesh) == cells0
+    assert vertex_data(mesh) == vertices0
+    assert [sorted(mesh.topology().global_indices(3)[c.index()]
+                   for c in cells(f)) for f in facets(mesh)] == facet_cells0
+    assert numpy.isclose(sum(c.volume() for c in cells(mesh)), volume)
+    assert mesh.bounding_box_tree().compute_first_entity_collision(
+        Point(0.3, 0.4, 0.5)) < mesh.num_cells()
+
+
+@skip_in_parallel
+@pytest.mark.parametrize("method", ["hilbert", "morton", "rcm"])
+def test_reorder_improves_locality(method):
+    """Check that reordering a randomly numbered mesh reduces the
+    spread of vertex indices within cells"""
+    mesh0 = UnitCubeMesh(6, 6, 6)
+    x0, cells0 = mesh0.coordinates(), mesh0.cells()
+
+    # Number vertices and cells randomly
+    rng = numpy.random.RandomState(1)
+    vperm = rng.permutation(mesh0.num_vertices())
+    cperm = rng.permutation(mesh0.num_cells())
+    mesh = Mesh()
+    editor = MeshEditor()
+    editor.open(mesh, "tetrahedron", 3, 3)
+    editor.init_vertices(mesh0.num_vertices())
+    editor.init_cells(mesh0.num_cells())
+    for v, x in enumerate(x0):
+        editor.add_vertex(vperm[v], Point(*x))
+    for c, vs in enumerate(cells0):
+        editor.add_cell(cperm[c], [int(vperm[v]) for v in vs])
+    editor.close()
+
+    def mean_spread(mesh):
+        cells = mesh.cells()
+        return numpy.mean(cells.max(axis=1) - cells.min(axis=1))
+
+    spread = mean_spread(mesh)
+    vertex_map, cell_map = mesh.reorder(method)
+    assert list(vertex_map) != list(range(mesh.num_vertices()))
+    assert list(cell_map) != list(range(mesh.num_cells()))
+    assert mean_spread(mesh) < 0.5*spread
@@ -153,3 +153,40 @@ def test_mixed_iterators():
         for v in vertices(c):
             n += 1
     assert n == 4*mesh.num_cells()
+
+def test_compressed_connectivity_iterators():
+    "Iterate over cells of vertices with compressed connectivity"
+
+    mesh = UnitCubeMesh(5, 5, 5)
+    mesh.init(0, 3)
+    con = mesh.topology()(0, 3)
+    cells_of_vertex = [con(i).copy() for i in range(mesh.num_vertices())]
+    size = con.memory_usage()
+    num_connections = con.size()
+
+    # Compress variable connectivity
+    con.compress()
+    assert con.compressed()
+    assert not con.empty()
+    assert con.size() == num_connections
+    assert con.memory_usage() < size
+
+    # Fixed connectivity (implicit offsets) is not compressed
+    mesh.topology()(3, 0).compress()
+    assert not mesh.topology()(3, 0).compressed()
+
+    # Iteration and access through mesh entities decode the
+    # connections and leave the connectivity compressed
+    for v in vertices(mesh):
+        assert [c.index() for c in cells(v)] \
+            == list(cells_of_vertex[v.index()])
+        assert v.num_entities(3) == len(cells_of_vertex[v.index()])
+        assert list(v.entities(3)) == list(cells_of_vertex[v.index()])
+    assert list(con(0)) == list(cells_of_vertex[0])
+    assert con.compressed()
+
+    # Restore uncompressed storage
+    con.decompress()
+    assert not con.compressed()
+    assert [list(con(i)) for i in range(mesh.num_vertices())] \
+        == [list(c) for c in cells_of_vertex]
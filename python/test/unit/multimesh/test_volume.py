@@ -200,3 +200,37 @@ def test_volume_2d_six_meshes():
     print("approximative volume ", approximate_volume)
     print("approximate volume error %1.16e" % (exact_volume - approximate_volume))
     assert abs(exact_volume - approximate_volume) < DOLFIN_EPS_LARGE
+
+@skip_in_parallel
+def test_volume_2d_rebuild():
+    "Integrate volume after moving the top mesh and rebuilding"
+
+    mesh_0 = UnitSquareMesh(8, 8)
+    mesh_1 = RectangleMesh(Point(0.1, 0.1), Point(0.5, 0.6), 5, 6)
+    mesh_2 = RectangleMesh(Point(0.3, 0.35), Point(0.7, 0.8), 6, 5)
+    mesh_2.rotate(20.0)
+
+    multimesh = MultiMesh()
+    for mesh in (mesh_0, mesh_1, mesh_2):
+        multimesh.add(mesh)
+    multimesh.build()
+
+    for step in range(3):
+        # Move the top mesh and rebuild
+        mesh_2.translate(Point(0.05, -0.03))
+        multimesh.rebuild([2])
+
+        # Compare with a multimesh built from scratch
+        reference = MultiMesh()
+        for mesh in (mesh_0, mesh_1, mesh_2):
+            reference.add(mesh)
+        reference.build()
+
+        for part in range(3):
+            assert sorted(multimesh.cut_cells(part)) \
+                == sorted(reference.cut_cells(part))
+            assert sorted(multimesh.covered_cells(part)) \
+                == sorted(reference.covered_cells(part))
+        assert abs(multimesh.compute_volume() - 1.0) < DOLFIN_EPS_LARGE
+        assert abs(multimesh.compute_area() - reference.compute_area()) \
+            < DOLFIN_EPS_LARGE
@@ -0,0 +1,213 @@
+// Copyright (C) 2026 agent
+//
+// This file is part of DOLFIN.
+//
+// DOLFIN is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// DOLFIN is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with DOLFIN. If not, see <http://www.gnu.org/licenses/>.
+//
+// Unit tests for simplex quadrature
+
+#include <cmath>
+#include <dolfin/geometry/Point.h>
+#include <dolfin/geometry/SimplexQuadrature.h>
+#include <catch.hpp>
+
+using namespace dolfin;
+
+namespace
+{
+  // Integrate x*y with a quadrature rule in 2D
+  double moment(const std::vector<double>& points,
+                const std::vector<double>& weights)
+  {
+    double m = 0.0;
+    for (std::size_t i = 0; i < weights.size(); ++i)
+      m += weights[i]*points[2*i]*points[2*i + 1];
+    return m;
+  }
+
+  // Integrate the monomial x_a^pa*x_b^pb*x_c^pc with a quadrature
+  // rule in gdim dimensions
+  double integrate(const double* points, const double* weights,
+                   std::size_t num_points, std::size_t gdim,
+                   std::size_t a, std::size_t pa,
+                   std::size_t b=0, std::size_t pb=0,
+                   std::size_t c=0, std::size_t pc=0)
+  {
+    double m = 0.0;
+    for (std::size_t i = 0; i < num_points; ++i)
+    {
+      const double* x = points + i*gdim;
+      m += weights[i]*std::pow(x[a], pa)*std::pow(x[b], pb)*std::pow(x[c], pc);
+    }
+    return m;
+  }
+
+  // Compute the volume of a simplex with packed vertex coordinates
+  // from the Gram determinant of its Jacobian
+  double volume(const double* x, std::size_t tdim, std::size_t gdim)
+  {
+    double G[3][3];
+    for (std::size_t i = 0; i < tdim; ++i)
+    {
+      for (std::size_t j = 0; j < tdim; ++j)
+      {
+        G[i][j] = 0.0;
+        for (std::size_t d = 0; d < gdim; ++d)
+        {
+          G[i][j] += (x[(i + 1)*gdim + d] - x[d])
+            *(x[(j + 1)*gdim + d] - x[d]);
+        }
+      }
+    }
+
+    double det = G[0][0];
+    if (tdim == 2)
+      det = G[0][0]*G[1][1] - G[0][1]*G[1][0];
+    else if (tdim == 3)
+    {
+      det = G[0][0]*(G[1][1]*G[2][2] - G[1][2]*G[2][1])
+        - G[0][1]*(G[1][0]*G[2][2] - G[1][2]*G[2][0])
+        + G[0][2]*(G[1][0]*G[2][1] - G[1][1]*G[2][0]);
+    }
+    const double factorial[4] = {1.0, 1.0, 2.0, 6.0};
+    return std::sqrt(det)/factorial[tdim];
+  }
+}
+
+TEST_CASE("Simplex quadrature test")
+{
+  SECTION("test rules against analytic integrals")
+  {
+    // Simplices of each topological dimension in each geometric
+    // dimension, given by packed vertex coordinates
+    const std::vector<double> x = {0.3, -1.2, 2.0, 1.1, 0.7, -0.4,
+                                   1.5, 2.2, 0.6, -0.8, 0.9, 1.7};
+    for (std::size_t tdim = 1; tdim <= 3; ++tdim)
+    {
+      const SimplexQuadrature sq(tdim, 4);
+      const std::size_t n = sq.num_points();
+      for (std::size_t gdim = tdim; gdim <= 3; ++gdim)
+      {
+        // Two simplices, the second one a reflected copy of the first
+        const std::size_t num_vertices = tdim + 1;
+        std::vector<double> coordinates(x.begin(),
+                                        x.begin() + num_vertices*gdim);
+        for (std::size_t i = 0; i < num_vertices*gdim; ++i)
+          coordinates.push_back(i % gdim == 0 ? -x[i] : x[i]);
+
+        std::vector<double> points(2*n*gdim), weights(2*n);
+        sq.compute_quadrature_rules(coordinates.data(), 2, gdim,
+                                    points.data(), weights.data());
+
+        for (std::size_t s = 0; s < 2; ++s)
+        {
+          const double* v = coordinates.data() + s*num_vertices*gdim;
+          const double* p = points.data() + s*n*gdim;
+          const double* w = weights.data() + s*n;
+
+          // Volume and first moments (volume times centroid)
+          const double V = volume(v, tdim, gdim);
+          CHECK(integrate(p, w, n, gdim, 0, 0) == Approx(V));
+          std::vector<double> S(gdim, 0.0);
+          for (std::size_t i = 0; i < num_vertices; ++i)
+            for (std::size_t d = 0; d < gdim; ++d)
+              S[d] += v[i*gdim + d];
+          for (std::size_t d = 0; d < gdim; ++d)
+          {
+            CHECK(integrate(p, w, n, gdim, d, 1)
+                  == Approx(V*S[d]/num_vertices));
+          }
+
+          // Second moments
+          for (std::size_t a = 0; a < gdim; ++a)
+          {
+            for (std::size_t b = 0; b < gdim; ++b)
+            {
+              double m = S[a]*S[b];
+              for (std::size_t i = 0; i < num_vertices; ++i)
+                m += v[i*gdim + a]*v[i*gdim + b];
+              m *= V/((tdim + 1)*(tdim + 2));
+              CHECK(integrate(p, w, n, gdim, a, 1, b, 1) == Approx(m));
+            }
+          }
+        }
+      }
+    }
+
+    // Moments of order four on the reference simplices
+    const SimplexQuadrature sq2(2, 4), sq3(3, 4);
+    const auto qr2 = sq2.compute_quadrature_rule(
+      {Point(0.0, 0.0), Point(1.0, 0.0), Point(0.0, 1.0)}, 2);
+    CHECK(integrate(qr2.first.data(), qr2.second.data(), qr2.second.size(),
+                    2, 0, 2, 1, 2) == Approx(1.0/180.0));
+    CHECK(integrate(qr2.first.data(), qr2.second.data(), qr2.second.size(),
+                    2, 0, 3, 1, 1) == Approx(1.0/120.0));
+    const auto qr3 = sq3.compute_quadrature_rule(
+      {Point(0.0, 0.0, 0.0), Point(1.0, 0.0, 0.0), Point(0.0, 1.0, 0.0),
+       Point(0.0, 0.0, 1.0)}, 3);
+    CHECK(integrate(qr3.first.data(), qr3.second.data(), qr3.second.size(),
+                    3, 0, 2, 1, 1, 2, 1) == Approx(1.0/2520.0));
+    CHECK(integrate(qr3.first.data(), qr3.second.data(), qr3.second.size(),
+                    3, 2, 4) == Approx(1.0/210.0));
+  }
+
+  SECTION("test interval in 3D")
+  {
+    // Interval of length 3 with a non-zero z component
+    const SimplexQuadrature sq(1, 2);
+    const auto qr = sq.compute_quadrature_rule(
+      {Point(1.0, 0.0, 0.0), Point(2.0, 2.0, 2.0)}, 3);
+    const std::size_t n = qr.second.size();
+    CHECK(integrate(qr.first.data(), qr.second.data(), n, 3, 0, 0)
+          == Approx(3.0));
+    CHECK(integrate(qr.first.data(), qr.second.data(), n, 3, 2, 1)
+          == Approx(3.0));
+    CHECK(integrate(qr.first.data(), qr.second.data(), n, 3, 2, 2)
+          == Approx(4.0));
+  }
+
+  SECTION("test memoised compression")
+  {
+    // Rule on four triangles and a translated and scaled copy of it
+    const SimplexQuadrature sq(2, 6);
+    std::pair<std::vector<double>, std::vector<double>> qr;
+    for (const std::vector<Point>& t
+           : {std::vector<Point>({Point(0.0, 0.0), Point(1.0, 0.0), Point(0.0, 1.0)}),
+              std::vector<Point>({Point(1.0, 0.0), Point(1.0, 1.0), Point(0.0, 1.0)}),
+              std::vector<Point>({Point(1.0, 0.0), Point(2.0, 0.0), Point(1.0, 1.0)}),
+              std::vector<Point>({Point(0.0, 1.0), Point(1.0, 1.0), Point(0.5, 2.0)})})
+    {
+      const auto dqr = sq.compute_quadrature_rule(t, 2);
+      qr.first.insert(qr.first.end(), dqr.first.begin(), dqr.first.end());
+      qr.second.insert(qr.second.end(), dqr.second.begin(), dqr.second.end());
+    }
+
+    auto qr_copy = qr;
+    for (std::size_t i = 0; i < qr_copy.second.size(); ++i)
+    {
+      qr_copy.first[2*i] = 3.0*qr_copy.first[2*i] + 1.0;
+      qr_copy.first[2*i + 1] = 3.0*qr_copy.first[2*i + 1] - 2.0;
+      qr_copy.second[i] *= 9.0;
+    }
+    const double m = moment(qr.first, qr.second);
+    const double m_copy = moment(qr_copy.first, qr_copy.second);
+
+    const auto indices = SimplexQuadrature::compress(qr, 2, 6);
+    const auto indices_copy = SimplexQuadrature::compress(qr_copy, 2, 6);
+    CHECK(indices.size() > 0);
+    CHECK(indices == indices_copy);
+    CHECK(moment(qr.first, qr.second) == Approx(m));
+    CHECK(moment(qr_copy.first, qr_copy.second) == Approx(m_copy));
+  }
+}